@@ -0,0 +1,164 @@
+// Helligkeit der Hintergrundbeleuchtung nach dem Umgebungslicht, mit Energieabschätzung
+/**
+ * @file ambient_backlight.hpp
+*/
+
+#ifndef AMBIENT_BACKLIGHT_HPP__
+#define AMBIENT_BACKLIGHT_HPP__
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Stützpunkt der Kennlinie: Rohwert des Lichtsensors -> Helligkeit in Prozent
+ */
+struct AmbientCurvePoint {
+    std::uint16_t light;
+    std::uint8_t brightness;
+};
+
+/**
+ * @brief Bildet den gefilterten Lichtsensor über eine Kennlinie auf die Helligkeit ab
+ *
+ * Der Rohwert wird mit einem gleitenden Mittel (Gewicht 1/8) geglättet. Eine neue Helligkeit wird
+ * erst berechnet, wenn sich das gefilterte Licht um mehr als die Hysterese vom Wert der letzten
+ * Änderung entfernt hat; so flackert die Anzeige nicht, wenn der Sensor um eine Schwelle pendelt.
+ */
+class AmbientBacklight
+{
+public:
+    static const std::size_t MAX_POINTS = 8;
+
+private:
+    AmbientCurvePoint curve[MAX_POINTS];
+    std::size_t pointCount = 0;
+    std::uint16_t hysteresis;
+    std::uint8_t standbyPercent;
+    std::uint32_t filtered = 0; // Gefiltertes Licht, skaliert mit 8
+    std::uint16_t anchor = 0;   // Licht bei der letzten Änderung
+    std::uint8_t brightness;
+    bool started = false;
+
+public:
+    /**
+     * @param [in] points Kennlinie mit aufsteigendem Licht (höchstens MAX_POINTS Punkte)
+     * @param [in] hysteresis Mindeständerung des gefilterten Lichts für eine neue Helligkeit
+     * @param [in] standbyPercent Helligkeit im Standby in Prozent der Helligkeit des Hauptbildschirms
+     */
+    AmbientBacklight(const AmbientCurvePoint *points, std::size_t count, std::uint16_t hysteresis, std::uint8_t standbyPercent)
+        : hysteresis(hysteresis), standbyPercent(standbyPercent)
+    {
+        for (std::size_t i = 0; i < count && i < MAX_POINTS; i++) {
+            curve[pointCount++] = points[i];
+        }
+        brightness = pointCount > 0 ? curve[pointCount - 1].brightness : 100;
+    }
+
+    /**
+     * @brief Helligkeit laut Kennlinie (zwischen den Stützpunkten linear, außerhalb begrenzt)
+     */
+    std::uint8_t map(std::uint16_t light) const
+    {
+        if (pointCount == 0) return 100;
+        if (light <= curve[0].light) return curve[0].brightness;
+        for (std::size_t i = 1; i < pointCount; i++) {
+            if (light <= curve[i].light) {
+                std::int32_t dx = curve[i].light - curve[i - 1].light;
+                std::int32_t dy = static_cast<std::int32_t>(curve[i].brightness) - curve[i - 1].brightness;
+                std::int32_t offset = dx > 0 ? dy * (light - curve[i - 1].light) / dx : dy;
+                return static_cast<std::uint8_t>(curve[i - 1].brightness + offset);
+            }
+        }
+        return curve[pointCount - 1].brightness;
+    }
+
+    /**
+     * @brief Verarbeitet einen Rohwert des Lichtsensors.
+     * @return true, wenn sich die Helligkeit geändert hat
+     */
+    bool update(std::uint16_t raw)
+    {
+        if (!started) {
+            filtered = static_cast<std::uint32_t>(raw) * 8;
+            anchor = raw;
+            started = true;
+            std::uint8_t initial = map(raw);
+            bool changed = initial != brightness;
+            brightness = initial;
+            return changed;
+        }
+        filtered = filtered - filtered / 8 + raw;
+        std::uint16_t light = getLight();
+        std::uint16_t distance = light > anchor ? light - anchor : anchor - light;
+        if (distance <= hysteresis) {
+            return false;
+        }
+        anchor = light;
+        std::uint8_t next = map(light);
+        if (next == brightness) {
+            return false;
+        }
+        brightness = next;
+        return true;
+    }
+
+    std::uint16_t getLight() const { return static_cast<std::uint16_t>(filtered / 8); }
+    std::uint8_t getMainBrightness() const { return brightness; }
+
+    std::uint8_t getStandbyBrightness() const
+    {
+        std::uint8_t standby = static_cast<std::uint8_t>(brightness * standbyPercent / 100);
+        return standby > 0 ? standby : 1;
+    }
+};
+
+/**
+ * @brief Schätzt den Strom der Hintergrundbeleuchtung aus dem Tastverhältnis
+ *
+ * Verglichen werden die tatsächliche Helligkeit und die feste Vorgabe ohne Lichtsensor
+ * (Vergleichswert), beide hochgerechnet auf mAh pro Tag.
+ */
+class BacklightEnergyMeter
+{
+private:
+    std::uint32_t fullCurrent;    // mA bei 100 %
+    std::uint64_t actualSum = 0;  // Prozent x ms
+    std::uint64_t baselineSum = 0;
+    std::uint64_t elapsed = 0;    // ms
+    std::uint32_t lastTime = 0;
+    std::uint8_t lastActual = 0;
+    std::uint8_t lastBaseline = 0;
+    bool started = false;
+
+    std::uint32_t perDay(std::uint64_t sum) const
+    {
+        if (elapsed == 0) return 0;
+        // Mittleres Tastverhältnis x Vollstrom x 24 h
+        return static_cast<std::uint32_t>(sum * fullCurrent * 24 / 100 / elapsed);
+    }
+
+public:
+    explicit BacklightEnergyMeter(std::uint32_t fullCurrentMilliamps) : fullCurrent(fullCurrentMilliamps) {}
+
+    /**
+     * @brief Zählt die Zeit seit dem letzten Aufruf mit den damaligen Helligkeiten und merkt sich die neuen.
+     */
+    void update(std::uint32_t now, std::uint8_t actualPercent, std::uint8_t baselinePercent)
+    {
+        if (started) {
+            std::uint32_t delta = now - lastTime;
+            actualSum += static_cast<std::uint64_t>(lastActual) * delta;
+            baselineSum += static_cast<std::uint64_t>(lastBaseline) * delta;
+            elapsed += delta;
+        }
+        started = true;
+        lastTime = now;
+        lastActual = actualPercent;
+        lastBaseline = baselinePercent;
+    }
+
+    std::uint32_t getActualPerDay() const { return perDay(actualSum); }
+    std::uint32_t getBaselinePerDay() const { return perDay(baselineSum); }
+};
+
+#endif //AMBIENT_BACKLIGHT_HPP__
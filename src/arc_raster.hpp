@@ -0,0 +1,177 @@
+// Ganzzahliger Rasterizer für dicke Kreisbögen, gibt waagrechte Linienstücke statt einzelner Pixel aus
+/**
+ * @file arc_raster.hpp
+*/
+
+#ifndef ARC_RASTER_HPP__
+#define ARC_RASTER_HPP__
+
+#include <cstdint>
+
+/**
+ * @brief Sinus 0..90° in ganzen Grad, skaliert mit 2^14 (liegt als Konstante im Flash)
+ */
+static const std::int16_t ARC_SIN_TABLE[91] = {
+        0,   286,   572,   857,  1143,  1428,  1713,  1997,  2280,  2563,
+     2845,  3126,  3406,  3686,  3964,  4240,  4516,  4790,  5063,  5334,
+     5604,  5872,  6138,  6402,  6664,  6924,  7182,  7438,  7692,  7943,
+     8192,  8438,  8682,  8923,  9162,  9397,  9630,  9860, 10087, 10311,
+    10531, 10749, 10963, 11174, 11381, 11585, 11786, 11982, 12176, 12365,
+    12551, 12733, 12911, 13085, 13255, 13421, 13583, 13741, 13894, 14044,
+    14189, 14330, 14466, 14598, 14726, 14849, 14968, 15082, 15191, 15296,
+    15396, 15491, 15582, 15668, 15749, 15826, 15897, 15964, 16026, 16083,
+    16135, 16182, 16225, 16262, 16294, 16322, 16344, 16362, 16374, 16382,
+    16384
+};
+
+static const int ARC_TRIG_SHIFT = 14;
+
+/**
+ * @brief Sinus eines ganzzahligen Winkels in Grad (beliebiges Vorzeichen), skaliert mit 2^14
+ */
+inline std::int32_t arcSin(int degrees)
+{
+    int angle = degrees % 360;
+    if (angle < 0) angle += 360;
+    if (angle <= 90) return ARC_SIN_TABLE[angle];
+    if (angle <= 180) return ARC_SIN_TABLE[180 - angle];
+    if (angle <= 270) return -ARC_SIN_TABLE[angle - 180];
+    return -ARC_SIN_TABLE[360 - angle];
+}
+
+inline std::int32_t arcCos(int degrees) { return arcSin(degrees + 90); }
+
+/**
+ * @brief Ganzzahlige Quadratwurzel (abgerundet)
+ */
+inline std::uint32_t arcIsqrt(std::uint32_t value)
+{
+    std::uint32_t result = 0;
+    std::uint32_t bit = 1u << 30;
+    while (bit > value) bit >>= 2;
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+/**
+ * @brief Winkelbereich eines Bogens, aufgeteilt in höchstens zwei Teilstücke von je maximal 180°
+ *
+ * Ein Punkt liegt in einem Teilstück, wenn er (mathematisch, y nach oben) nicht rechts vom Startstrahl
+ * und nicht links vom Endstrahl liegt. Das sind nur zwei Kreuzprodukte, ohne Winkelfunktionen.
+ */
+class ArcSector
+{
+private:
+    std::int32_t startX[2];
+    std::int32_t startY[2];
+    std::int32_t endX[2];
+    std::int32_t endY[2];
+    int parts = 0;
+
+    void addPart(int from, int to)
+    {
+        startX[parts] = arcCos(from);
+        startY[parts] = arcSin(from);
+        endX[parts] = arcCos(to);
+        endY[parts] = arcSin(to);
+        parts++;
+    }
+
+public:
+    /**
+     * @param [in] startAngle, endAngle Winkel in Grad gegen den Uhrzeigersinn ab 3 Uhr, 0 <= start <= end <= start + 360
+     */
+    ArcSector(int startAngle, int endAngle)
+    {
+        if (endAngle - startAngle > 180) {
+            int middle = startAngle + (endAngle - startAngle) / 2;
+            addPart(startAngle, middle);
+            addPart(middle, endAngle);
+        } else {
+            addPart(startAngle, endAngle);
+        }
+    }
+
+    /**
+     * @param [in] dx, dy Abstand zum Mittelpunkt, dy mathematisch (nach oben positiv)
+     */
+    bool contains(std::int32_t dx, std::int32_t dy) const
+    {
+        for (int i = 0; i < parts; i++) {
+            if (startX[i] * dy - startY[i] * dx >= 0 && dx * endY[i] - dy * endX[i] >= 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+/**
+ * @brief Rastert einen dicken Kreisbogen zeilenweise in waagrechte Linienstücke.
+ *
+ * Der Bogen ist der Ring zwischen den Radien r - thickness/2 und r + (thickness-1)/2 innerhalb des
+ * Winkelbereichs; Winkel wie bei drawArc() in main.cpp (0° = 3 Uhr, gegen den Uhrzeigersinn, y des
+ * Bildschirms nach unten). Pro Zeile werden die Ringgrenzen per Ganzzahl-Wurzel bestimmt und nur
+ * zusammenhängende Stücke ausgegeben, jedes Pixel genau einmal.
+ *
+ * @param [in] span Funktion (x, y, width) für jedes Linienstück, z.B. ein Aufruf von drawFastHLine
+ * @return Anzahl der ausgegebenen Linienstücke
+ */
+template <typename SpanFunction>
+inline std::uint32_t rasterizeArc(int cx, int cy, int r, int thickness, int startAngle, int endAngle, SpanFunction span)
+{
+    if (thickness < 1) thickness = 1;
+    std::int32_t inner = r - thickness / 2;
+    std::int32_t outer = r + (thickness - 1) / 2;
+    if (inner < 0) inner = 0;
+    // Halbes Pixel Zugabe am Außenrand, wie beim Mittelpunktverfahren für Kreise
+    std::int32_t outerLimit = outer * outer + outer;
+    std::int32_t innerLimit = inner * inner;
+
+    ArcSector sector(startAngle, endAngle);
+    std::uint32_t spans = 0;
+    for (std::int32_t dy = -outer; dy <= outer; dy++) {
+        std::int32_t dy2 = dy * dy;
+        if (dy2 > outerLimit) continue;
+        std::int32_t outerX = static_cast<std::int32_t>(arcIsqrt(static_cast<std::uint32_t>(outerLimit - dy2)));
+        // Innerhalb von innerX liegt das Loch des Rings (Abstand² < inner²)
+        std::int32_t innerX = -1;
+        if (dy2 < innerLimit) {
+            innerX = static_cast<std::int32_t>(arcIsqrt(static_cast<std::uint32_t>(innerLimit - dy2 - 1)));
+        }
+
+        // Zwei Ringabschnitte links und rechts vom Loch bzw. einer über die ganze Breite
+        std::int32_t ranges[2][2] = {{-outerX, -innerX - 1}, {innerX + 1, outerX}};
+        int rangeCount = 2;
+        if (innerX < 0) {
+            ranges[0][1] = outerX;
+            rangeCount = 1;
+        }
+        for (int k = 0; k < rangeCount; k++) {
+            std::int32_t runStart = 0;
+            bool inRun = false;
+            for (std::int32_t dx = ranges[k][0]; dx <= ranges[k][1] + 1; dx++) {
+                bool inside = dx <= ranges[k][1] && sector.contains(dx, -dy);
+                if (inside && !inRun) {
+                    runStart = dx;
+                    inRun = true;
+                } else if (!inside && inRun) {
+                    span(cx + runStart, cy + dy, dx - runStart);
+                    spans++;
+                    inRun = false;
+                }
+            }
+        }
+    }
+    return spans;
+}
+
+#endif //ARC_RASTER_HPP__
@@ -0,0 +1,320 @@
+// Tasten per External Interrupt: Entprellung im Timer-Interrupt, Gesten und Ereigniswarteschlange ohne Sperren
+/**
+ * @file button_events.hpp
+*/
+
+#ifndef BUTTON_EVENTS_HPP__
+#define BUTTON_EVENTS_HPP__
+
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+enum ButtonGesture : std::uint8_t {
+    BUTTON_DOWN,   // Entprellt gedrückt
+    BUTTON_SHORT,  // Vor Ablauf von longPressTime losgelassen (kommt vor BUTTON_UP)
+    BUTTON_LONG,   // longPressTime lang gehalten (noch während des Drückens)
+    BUTTON_REPEAT, // Nach BUTTON_LONG alle repeatInterval, solange die Taste gehalten wird
+    BUTTON_UP      // Entprellt losgelassen
+};
+
+/**
+ * @brief Ein Tastenereignis
+ */
+struct ButtonEvent {
+    std::uint8_t button = 0;             // Index der Taste
+    ButtonGesture gesture = BUTTON_DOWN;
+    std::uint32_t time = 0;              // millis() beim Erkennen
+};
+
+/**
+ * @brief Ringpuffer für genau einen Erzeuger (Interrupt) und einen Verbraucher (loop())
+ *
+ * Jede Seite schreibt nur ihren eigenen Index, es wird also nichts gesperrt. Die Zäune verhindern,
+ * dass der Compiler das Schreiben des Eintrags hinter das Weitersetzen des Index verschiebt; auf dem
+ * Cortex-M4 mit nur einem Kern genügt das.
+ */
+class ButtonEventQueue
+{
+public:
+    static const std::size_t CAPACITY = 16; // Zweierpotenz
+
+private:
+    ButtonEvent events[CAPACITY];
+    volatile std::uint32_t head = 0;    // Nur vom Erzeuger geschrieben
+    volatile std::uint32_t tail = 0;    // Nur vom Verbraucher geschrieben
+    volatile std::uint32_t dropped = 0; // Nur vom Erzeuger geschrieben
+
+public:
+    /**
+     * @brief Hängt ein Ereignis an (Erzeuger).
+     * @return false, wenn die Warteschlange voll ist; das Ereignis wird verworfen
+     */
+    bool push(const ButtonEvent &event)
+    {
+        std::uint32_t h = head;
+        if (h - tail >= CAPACITY) {
+            dropped = dropped + 1;
+            return false;
+        }
+        events[h % CAPACITY] = event;
+        std::atomic_signal_fence(std::memory_order_release);
+        head = h + 1;
+        return true;
+    }
+
+    /**
+     * @brief Holt das älteste Ereignis ab (Verbraucher), wartet nie.
+     * @return false, wenn kein Ereignis vorliegt
+     */
+    bool pop(ButtonEvent &event)
+    {
+        std::uint32_t t = tail;
+        if (t == head) {
+            return false;
+        }
+        std::atomic_signal_fence(std::memory_order_acquire);
+        event = events[t % CAPACITY];
+        std::atomic_signal_fence(std::memory_order_release);
+        tail = t + 1;
+        return true;
+    }
+
+    bool isEmpty() const { return tail == head; }
+    std::uint32_t getDropped() const { return dropped; }
+};
+
+/**
+ * @brief Zeiten einer Taste in ms
+ */
+struct ButtonTiming {
+    std::uint32_t debounceTime = 20;    // So lange muss der Pegel stabil sein
+    std::uint32_t longPressTime = 2000; // Ab dann BUTTON_LONG statt BUTTON_SHORT
+    std::uint32_t repeatInterval = 0;   // Abstand der BUTTON_REPEAT nach BUTTON_LONG (0 = keine Wiederholung)
+};
+
+/**
+ * @brief Entprellt bis zu MAX_BUTTONS Tasten und erkennt Gesten; im Takt des Timers aufrufen
+ *
+ * Ein Pegelwechsel gilt erst, wenn er debounceTime lang ansteht; Prellen davor wird verworfen.
+ * Die Klasse kennt keine Hardware und kann auf dem Host mit künstlichen Pegelverläufen getestet werden.
+ */
+class ButtonGestureTracker
+{
+public:
+    static const std::size_t MAX_BUTTONS = 5;
+
+private:
+    struct Button {
+        ButtonTiming timing;
+        bool raw = false;             // Zuletzt gelesener Pegel (true = gedrückt)
+        bool pressed = false;         // Entprellter Zustand
+        bool longSent = false;
+        std::uint32_t rawSince = 0;   // Seit wann raw ansteht
+        std::uint32_t pressTime = 0;
+        std::uint32_t nextRepeat = 0;
+    };
+
+    Button buttons[MAX_BUTTONS];
+
+    static void emit(ButtonEventQueue &queue, std::size_t index, ButtonGesture gesture, std::uint32_t now)
+    {
+        ButtonEvent event;
+        event.button = static_cast<std::uint8_t>(index);
+        event.gesture = gesture;
+        event.time = now;
+        queue.push(event);
+    }
+
+public:
+    void setTiming(std::size_t index, const ButtonTiming &timing)
+    {
+        if (index < MAX_BUTTONS) buttons[index].timing = timing;
+    }
+
+    /**
+     * @brief Wertet den aktuellen Pegel einer Taste aus.
+     * @return true, solange die Taste weiter abgefragt werden muss (prellt oder wartet gedrückt auf
+     *         BUTTON_LONG bzw. BUTTON_REPEAT); das Loslassen meldet danach wieder eine Flanke
+     */
+    bool update(std::size_t index, bool raw, std::uint32_t now, ButtonEventQueue &queue)
+    {
+        if (index >= MAX_BUTTONS) return false;
+        Button &b = buttons[index];
+        if (raw != b.raw) {
+            b.raw = raw;
+            b.rawSince = now;
+        }
+        if (b.raw != b.pressed && now - b.rawSince >= b.timing.debounceTime) {
+            b.pressed = b.raw;
+            if (b.pressed) {
+                b.pressTime = now;
+                b.longSent = false;
+                emit(queue, index, BUTTON_DOWN, now);
+            } else {
+                if (!b.longSent) {
+                    emit(queue, index, BUTTON_SHORT, now);
+                }
+                emit(queue, index, BUTTON_UP, now);
+            }
+        }
+        if (b.pressed) {
+            if (!b.longSent && now - b.pressTime >= b.timing.longPressTime) {
+                b.longSent = true;
+                b.nextRepeat = now + b.timing.repeatInterval;
+                emit(queue, index, BUTTON_LONG, now);
+            } else if (b.longSent && b.timing.repeatInterval > 0 && static_cast<std::int32_t>(now - b.nextRepeat) >= 0) {
+                b.nextRepeat += b.timing.repeatInterval;
+                emit(queue, index, BUTTON_REPEAT, now);
+            }
+        }
+        return b.raw != b.pressed || (b.pressed && (!b.longSent || b.timing.repeatInterval > 0));
+    }
+
+    bool isPressed(std::size_t index) const { return index < MAX_BUTTONS && buttons[index].pressed; }
+};
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+// Timer für den Entprelltakt (TC0: Hintergrundbeleuchtung, TC2: Mikrofon; TC2 und TC3 teilen sich den Takt GCLK1)
+#ifndef BUTTON_INPUT_TC
+#define BUTTON_INPUT_TC TC3
+#define BUTTON_INPUT_TC_GCLK_ID TC3_GCLK_ID
+#define BUTTON_INPUT_TC_APBBMASK MCLK_APBBMASK_TC3
+#define BUTTON_INPUT_TC_IRQn TC3_IRQn
+#endif
+
+/**
+ * @brief Zähler der Tasteneingabe
+ */
+struct ButtonInputStats {
+    std::uint32_t edges = 0; // Flanken-Interrupts einschließlich Prellen
+    std::uint32_t ticks = 0; // Timer-Interrupts (laufen nur, solange eine Taste prellt oder auf langes Drücken gewartet wird)
+};
+
+/**
+ * @brief Tasten per External Interrupt mit Entprellung im 1-ms-Takt des Timers
+ *
+ * Eine Flanke an einer Taste startet den Timer. Der Timer-Interrupt liest alle Tasten, entprellt sie
+ * mit ButtonGestureTracker und schreibt die Ereignisse in die Warteschlange; er ist damit der einzige
+ * Erzeuger. Sobald keine Taste mehr prellt oder auf eine Geste wartet, hält er sich selbst an. loop() holt die
+ * Ereignisse mit pop() ab und wartet nie.
+ *
+ * Die Anwendung muss TC3_Handler() an handleTick() weiterleiten.
+ */
+class ButtonInput
+{
+public:
+    static const std::uint32_t TICK_RATE = 1000; // Hz
+
+private:
+    std::uint8_t pins[ButtonGestureTracker::MAX_BUTTONS];
+    std::size_t count = 0;
+    ButtonGestureTracker tracker;
+    ButtonEventQueue queue;
+    volatile std::uint32_t edges = 0;
+    volatile std::uint32_t ticks = 0;
+
+    // Aktive Instanz für die Interrupt-Routinen
+    static ButtonInput *&instance()
+    {
+        static ButtonInput *active = nullptr;
+        return active;
+    }
+
+    static void onEdge()
+    {
+        ButtonInput *self = instance();
+        if (self == nullptr) return;
+        self->edges = self->edges + 1;
+        self->setTimerEnabled(true);
+    }
+
+    void setTimerEnabled(bool enabled)
+    {
+        BUTTON_INPUT_TC->COUNT16.CTRLA.bit.ENABLE = enabled ? 1 : 0;
+        while (BUTTON_INPUT_TC->COUNT16.SYNCBUSY.bit.ENABLE);
+    }
+
+    bool readPin(std::size_t index) const { return digitalRead(pins[index]) == LOW; }
+
+public:
+    /**
+     * @brief Richtet Pins, Flanken-Interrupts und Timer ein. Es kann nur eine Instanz aktiv sein.
+     * @param [in] buttonPins Pins der Tasten (aktiv Low), der Index im Feld ist ButtonEvent::button
+     */
+    void begin(const std::uint8_t *buttonPins, std::size_t buttonCount, const ButtonTiming &timing = ButtonTiming())
+    {
+        count = buttonCount < ButtonGestureTracker::MAX_BUTTONS ? buttonCount : ButtonGestureTracker::MAX_BUTTONS;
+        instance() = this;
+
+        // Timer: GCLK1 (48 MHz) / 64, Überlauf mit TICK_RATE
+        MCLK->APBBMASK.reg |= BUTTON_INPUT_TC_APBBMASK;
+        GCLK->PCHCTRL[BUTTON_INPUT_TC_GCLK_ID].reg = GCLK_PCHCTRL_GEN_GCLK1 | GCLK_PCHCTRL_CHEN;
+        while (!(GCLK->PCHCTRL[BUTTON_INPUT_TC_GCLK_ID].reg & GCLK_PCHCTRL_CHEN));
+        BUTTON_INPUT_TC->COUNT16.CTRLA.bit.SWRST = 1;
+        while (BUTTON_INPUT_TC->COUNT16.SYNCBUSY.bit.SWRST);
+        BUTTON_INPUT_TC->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV64;
+        BUTTON_INPUT_TC->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_MFRQ;
+        BUTTON_INPUT_TC->COUNT16.CC[0].reg = 48000000UL / 64 / TICK_RATE - 1;
+        while (BUTTON_INPUT_TC->COUNT16.SYNCBUSY.bit.CC0);
+        BUTTON_INPUT_TC->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+        BUTTON_INPUT_TC->COUNT16.INTENSET.reg = TC_INTENSET_OVF;
+        NVIC_SetPriority(BUTTON_INPUT_TC_IRQn, 3);
+        NVIC_EnableIRQ(BUTTON_INPUT_TC_IRQn);
+
+        for (std::size_t i = 0; i < count; i++) {
+            pins[i] = buttonPins[i];
+            tracker.setTiming(i, timing);
+            pinMode(pins[i], INPUT_PULLUP);
+            attachInterrupt(digitalPinToInterrupt(pins[i]), onEdge, CHANGE);
+        }
+        setTimerEnabled(true); // Einmal alle Tasten lesen, falls beim Start schon eine gedrückt ist
+    }
+
+    void setTiming(std::size_t index, const ButtonTiming &timing) { tracker.setTiming(index, timing); }
+
+    /**
+     * @brief Entprellt alle Tasten; aus TC3_Handler() aufrufen.
+     */
+    void handleTick()
+    {
+        BUTTON_INPUT_TC->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+        ticks = ticks + 1;
+        std::uint32_t now = millis();
+        bool busy = false;
+        for (std::size_t i = 0; i < count; i++) {
+            busy |= tracker.update(i, readPin(i), now, queue);
+        }
+        if (!busy) {
+            setTimerEnabled(false);
+            // Eine Flanke zwischen der Abfrage und dem Anhalten ginge sonst verloren
+            for (std::size_t i = 0; i < count; i++) {
+                if (readPin(i) != tracker.isPressed(i)) {
+                    setTimerEnabled(true);
+                    break;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Holt das nächste Ereignis ab; aus loop() aufrufen.
+     * @return false, wenn keines vorliegt
+     */
+    bool pop(ButtonEvent &event) { return queue.pop(event); }
+
+    std::uint32_t getDropped() const { return queue.getDropped(); }
+
+    ButtonInputStats getStats() const
+    {
+        ButtonInputStats stats;
+        stats.edges = edges;
+        stats.ticks = ticks;
+        return stats;
+    }
+};
+#endif // ARDUINO
+
+#endif //BUTTON_EVENTS_HPP__
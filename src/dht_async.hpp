@@ -0,0 +1,227 @@
+// Nicht blockierender Treiber für den DHT11 (Zustandsautomat mit Flankenerfassung per Interrupt)
+/**
+ * @file dht_async.hpp
+*/
+
+#ifndef DHT_ASYNC_HPP__
+#define DHT_ASYNC_HPP__
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Ergebnis einer DHT-Messung
+ */
+struct DhtResult {
+    bool valid = false;
+    float temperature = 0;
+    float humidity = 0;
+    std::uint8_t data[5] = {0, 0, 0, 0, 0};
+};
+
+/**
+ * @brief Dekodiert einen aufgezeichneten DHT-Frame aus Flankenzeitpunkten.
+ *
+ * Ein Bit besteht aus ca. 50 µs Low und anschließend 26-28 µs (0) bzw. 70 µs (1) High.
+ * Ausgewertet werden die letzten 40 High-Pulse (steigende bis fallende Flanke); davor liegt
+ * der 80 µs Antwortpuls des Sensors, der ebenso wie eine verpasste erste Flanke ignoriert wird.
+ * Die Funktion benötigt keine Hardware und kann mit aufgezeichneten Zeitstempeln getestet werden.
+ *
+ * @param [in] times Zeitstempel der Flanken in µs
+ * @param [in] levels Pegel nach der jeweiligen Flanke (1 = High)
+ * @param [in] count Anzahl der Flanken
+ * @param [out] result Dekodierte Werte, valid ist nur bei korrekter Prüfsumme gesetzt
+ * @return true, wenn 40 Bits mit gültiger Prüfsumme gefunden wurden
+ */
+inline bool decodeDhtFrame(const std::uint32_t *times, const std::uint8_t *levels, std::size_t count, DhtResult &result)
+{
+    const std::uint32_t BIT_THRESHOLD_US = 48; // Zwischen 28 µs (0) und 70 µs (1)
+    const std::uint32_t MAX_PULSE_US = 120;    // Längere Pulse sind keine Datenbits
+
+    result = DhtResult();
+
+    // Rückwärts die letzten 40 High-Pulse einsammeln
+    std::uint8_t bits[40];
+    int found = 0;
+    for (std::size_t i = count; i >= 2 && found < 40; i--) {
+        std::size_t fall = i - 1;
+        std::size_t rise = i - 2;
+        if (levels[fall] != 0 || levels[rise] != 1) {
+            continue;
+        }
+        std::uint32_t width = times[fall] - times[rise];
+        if (width > MAX_PULSE_US) {
+            continue;
+        }
+        bits[39 - found] = width > BIT_THRESHOLD_US ? 1 : 0;
+        found++;
+    }
+    if (found < 40) {
+        return false;
+    }
+
+    for (int i = 0; i < 40; i++) {
+        result.data[i / 8] = static_cast<std::uint8_t>((result.data[i / 8] << 1) | bits[i]);
+    }
+    std::uint8_t checksum = static_cast<std::uint8_t>(result.data[0] + result.data[1] + result.data[2] + result.data[3]);
+    if (checksum != result.data[4]) {
+        return false;
+    }
+
+    // DHT11: ganzzahliger Teil und Zehntel, Bit 7 des Temperatur-Zehntels kennzeichnet negative Werte
+    result.humidity = result.data[0] + (result.data[1] & 0x0f) * 0.1f;
+    float temperature = result.data[2];
+    if (result.data[3] & 0x80) {
+        temperature = -1 - temperature;
+    }
+    result.temperature = temperature + (result.data[3] & 0x0f) * 0.1f;
+    result.valid = true;
+    return true;
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+
+/**
+ * @brief Asynchroner DHT11-Treiber
+ *
+ * Ablauf: start() zieht die Leitung für 20 ms auf Low, poll() gibt sie danach frei und zeichnet
+ * die Flanken der Antwort per External Interrupt (EIC) mit micros() auf. Nach Abschluss wird das
+ * Ergebnis dekodiert und an den Callback übergeben. Interrupts werden nie global gesperrt und
+ * der Aufrufer wartet an keiner Stelle aktiv.
+ */
+class DhtAsync
+{
+public:
+    typedef void (*ResultCallback)(const DhtResult &result);
+
+private:
+    enum State { IDLE, START_LOW, CAPTURING };
+
+    static const std::size_t MAX_EDGES = 96;          // 3 Antwortflanken + 80 Datenflanken + Reserve
+    static const std::uint32_t START_LOW_MS = 20;     // Startsignal mindestens 18 ms
+    static const std::uint32_t CAPTURE_TIMEOUT_MS = 8; // Ein Frame dauert höchstens ca. 5 ms
+
+    // Aktive Instanz für die Interrupt-Routine
+    static DhtAsync *&instance()
+    {
+        static DhtAsync *active = nullptr;
+        return active;
+    }
+
+    std::uint8_t pin;
+    ResultCallback callback = nullptr;
+    State state = IDLE;
+    std::uint32_t stateTime = 0;
+    volatile std::uint32_t edgeTimes[MAX_EDGES];
+    volatile std::uint8_t edgeLevels[MAX_EDGES];
+    volatile std::size_t edgeCount = 0;
+    std::uint32_t errors = 0;
+
+    static void onEdge()
+    {
+        DhtAsync *self = instance();
+        if (self == nullptr) return;
+        std::size_t n = self->edgeCount;
+        if (n < MAX_EDGES) {
+            self->edgeTimes[n] = micros();
+            self->edgeLevels[n] = static_cast<std::uint8_t>(digitalRead(self->pin));
+            self->edgeCount = n + 1;
+        }
+    }
+
+    void finish()
+    {
+        detachInterrupt(digitalPinToInterrupt(pin));
+        state = IDLE;
+
+        std::uint32_t times[MAX_EDGES];
+        std::uint8_t levels[MAX_EDGES];
+        std::size_t count = edgeCount;
+        for (std::size_t i = 0; i < count; i++) {
+            times[i] = edgeTimes[i];
+            levels[i] = edgeLevels[i];
+        }
+
+        DhtResult result;
+        if (!decodeDhtFrame(times, levels, count, result)) {
+            errors++;
+        }
+#ifdef DHT_TRACE
+        // Mitschnitt für tools/dht_replay: Ergebnis, dann die Flanken relativ zur ersten
+        if (result.valid) {
+            Serial.printf("ok:%.1f:%.1f", result.humidity, result.temperature);
+        } else {
+            Serial.print("fehler");
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            Serial.printf(" %lu,%u", (unsigned long)(times[i] - times[0]), (unsigned)levels[i]);
+        }
+        Serial.println();
+#endif
+        if (callback != nullptr) {
+            callback(result);
+        }
+    }
+
+public:
+    explicit DhtAsync(std::uint8_t pin) : pin(pin) {}
+
+    /**
+     * @brief Initialisiert den Pin. Es kann nur eine Instanz gleichzeitig aktiv sein.
+     */
+    void begin(ResultCallback callback)
+    {
+        this->callback = callback;
+        instance() = this;
+        pinMode(pin, INPUT_PULLUP);
+    }
+
+    /**
+     * @brief Startet eine Messung, sofern keine läuft.
+     * @return false, wenn bereits eine Messung läuft
+     */
+    bool start(std::uint32_t now)
+    {
+        if (state != IDLE) {
+            return false;
+        }
+        pinMode(pin, OUTPUT);
+        digitalWrite(pin, LOW);
+        state = START_LOW;
+        stateTime = now;
+        return true;
+    }
+
+    /**
+     * @brief Treibt den Zustandsautomaten weiter; muss regelmäßig (z.B. alle 1-2 ms) aufgerufen werden.
+     */
+    void poll(std::uint32_t now)
+    {
+        switch (state) {
+        case START_LOW:
+            if (now - stateTime >= START_LOW_MS) {
+                edgeCount = 0;
+                // Erst den Pin freigeben, dann den Interrupt anhängen (attachInterrupt schaltet den Pin auf den EIC)
+                pinMode(pin, INPUT_PULLUP);
+                attachInterrupt(digitalPinToInterrupt(pin), onEdge, CHANGE);
+                state = CAPTURING;
+                stateTime = now;
+            }
+            break;
+        case CAPTURING:
+            if (edgeCount >= MAX_EDGES || now - stateTime >= CAPTURE_TIMEOUT_MS) {
+                finish();
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool isBusy() const { return state != IDLE; }
+    std::uint32_t getErrors() const { return errors; }
+};
+#endif // ARDUINO
+
+#endif //DHT_ASYNC_HPP__
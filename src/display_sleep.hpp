@@ -0,0 +1,141 @@
+// Tiefer Standby: Hintergrundbeleuchtung aus und ILI9341 im Sleep-Modus, ohne SPI-Verkehr bis zum Aufwecken
+/**
+ * @file display_sleep.hpp
+*/
+
+#ifndef DISPLAY_SLEEP_HPP__
+#define DISPLAY_SLEEP_HPP__
+
+#include <cstdint>
+#include <TFT_eSPI.h>
+#include "lcd_backlight.hpp"
+
+/**
+ * @brief Zähler des Tiefschlafs
+ */
+struct DisplaySleepStats {
+    std::uint32_t sleeps = 0;        // Eintritte in den Tiefschlaf
+    std::uint32_t wakes = 0;         // Vollständige Aufwachvorgänge
+    std::uint32_t asleepMillis = 0;  // Summe der Zeit vom Sleep-In bis zum Aufwecken
+};
+
+/**
+ * @brief Zustandsautomat für den Sleep-Modus des Displays
+ *
+ * sleep() blendet die Hintergrundbeleuchtung aus, poll() sendet danach Sleep-In. Der Bildspeicher des
+ * ILI9341 bleibt im Sleep-Modus erhalten: nach dem Aufwecken steht das letzte Bild wieder da und muss
+ * nicht neu gezeichnet werden. Nach Sleep-Out braucht der Controller 5 ms, bevor er Befehle annimmt,
+ * und zwischen Sleep-In und Sleep-Out liegen mindestens 120 ms. wake() wartet darauf nicht, sondern
+ * liefert false, bis das Display bereit ist; der Aufrufer ruft es in jedem Durchlauf von loop() erneut auf.
+ *
+ * Solange isAwake() nicht gilt, darf weder gezeichnet noch die Helligkeit geändert werden.
+ */
+class DisplaySleep
+{
+public:
+    enum State {
+        AWAKE,   // Normalbetrieb
+        DIMMING, // Hintergrundbeleuchtung wird ausgeblendet, danach Sleep-In
+        ASLEEP,  // Sleep-In gesendet, kein SPI-Verkehr
+        WAKING   // Aufwecken angefordert, Sleep-Out gesendet bzw. noch gesperrt
+    };
+
+    static const std::uint32_t SLEEP_OUT_SETTLE = 5;  // ms nach Sleep-Out bis zum nächsten Befehl
+    static const std::uint32_t SLEEP_COMMAND_GAP = 120; // ms zwischen Sleep-In und Sleep-Out
+
+private:
+    TFT_eSPI &tft;
+    LCDBackLight &backLight;
+    State state = AWAKE;
+    bool sleepOutSent = false;
+    std::uint32_t commandTime = 0; // Zeitpunkt des letzten Sleep-In bzw. Sleep-Out
+    std::uint32_t sleepTime = 0;
+    std::uint8_t dimmedFrom = 0;   // Helligkeit vor dem Ausblenden
+    bool commandSent = false;
+    DisplaySleepStats stats;
+
+    bool commandAllowed(std::uint32_t now, std::uint32_t gap) const { return !commandSent || now - commandTime >= gap; }
+
+    void sendCommand(std::uint8_t command, std::uint32_t now)
+    {
+        tft.writecommand(command);
+        commandTime = now;
+        commandSent = true;
+    }
+
+public:
+    DisplaySleep(TFT_eSPI &tft, LCDBackLight &backLight) : tft(tft), backLight(backLight) {}
+
+    /**
+     * @brief Beginnt den Tiefschlaf; vorher muss eine laufende DMA-Übertragung beendet sein.
+     * @param [in] fadeMs Dauer des Ausblendens der Hintergrundbeleuchtung
+     */
+    void sleep(std::uint32_t now, std::uint16_t fadeMs)
+    {
+        if (state != AWAKE) {
+            return;
+        }
+        dimmedFrom = backLight.getBrightness();
+        backLight.fadeTo(0, fadeMs);
+        state = DIMMING;
+        poll(now);
+    }
+
+    /**
+     * @brief Sendet Sleep-In, sobald die Hintergrundbeleuchtung aus ist; aus loop() aufrufen.
+     */
+    void poll(std::uint32_t now)
+    {
+        if (state == DIMMING && backLight.isFadeComplete() && commandAllowed(now, SLEEP_COMMAND_GAP)) {
+            sendCommand(TFT_SLPIN, now);
+            sleepTime = now;
+            state = ASLEEP;
+            stats.sleeps++;
+        }
+    }
+
+    /**
+     * @brief Weckt das Display bzw. prüft, ob es nach dem Aufwecken bereit ist.
+     * Bricht wake() ein laufendes Ausblenden ab, stellt es die Helligkeit davor sofort wieder her, denn
+     * das Bild ist unverändert und der Aufrufer zeichnet in diesem Fall nicht neu.
+     * @return true, wenn wieder gezeichnet werden darf; nach Sleep-Out setzt der Aufrufer die Helligkeit
+     */
+    bool wake(std::uint32_t now)
+    {
+        if (state == AWAKE) {
+            return true;
+        }
+        if (state == DIMMING) {
+            // Noch kein Sleep-In gesendet, das Bild ist unverändert
+            backLight.fadeTo(dimmedFrom, 0);
+            state = AWAKE;
+            return true;
+        }
+        if (state == ASLEEP) {
+            state = WAKING;
+            sleepOutSent = false;
+            stats.asleepMillis += now - sleepTime;
+        }
+        if (!sleepOutSent) {
+            if (!commandAllowed(now, SLEEP_COMMAND_GAP)) {
+                return false;
+            }
+            sendCommand(TFT_SLPOUT, now);
+            sleepOutSent = true;
+            return false;
+        }
+        if (now - commandTime < SLEEP_OUT_SETTLE) {
+            return false;
+        }
+        state = AWAKE;
+        stats.wakes++;
+        return true;
+    }
+
+    State getState() const { return state; }
+    bool isAwake() const { return state == AWAKE; }
+    bool isWaking() const { return state == WAKING; }
+    const DisplaySleepStats &getStats() const { return stats; }
+};
+
+#endif //DISPLAY_SLEEP_HPP__
@@ -10,14 +10,78 @@
 //#include <samd51p19a.h>
 #include <cstdint>
 
+/**
+ * @brief Gamma 2.2 curve: duty cycle in 1/1000 of the PWM period for perceived levels 0..255
+ * @remark Generated with round(1000 * (i / 255) ** 2.2).
+ */
+static const std::uint16_t LCD_BACKLIGHT_GAMMA[256] = {
+       0,    0,    0,    0,    0,    0,    0,    0,    0,    1,    1,    1,    1,    1,    2,    2,
+       2,    3,    3,    3,    4,    4,    5,    5,    6,    6,    7,    7,    8,    8,    9,   10,
+      10,   11,   12,   13,   13,   14,   15,   16,   17,   18,   19,   20,   21,   22,   23,   24,
+      25,   27,   28,   29,   30,   32,   33,   34,   36,   37,   38,   40,   41,   43,   45,   46,
+      48,   49,   51,   53,   55,   56,   58,   60,   62,   64,   66,   68,   70,   72,   74,   76,
+      78,   80,   82,   85,   87,   89,   92,   94,   96,   99,  101,  104,  106,  109,  111,  114,
+     117,  119,  122,  125,  128,  130,  133,  136,  139,  142,  145,  148,  151,  154,  157,  160,
+     164,  167,  170,  173,  177,  180,  184,  187,  190,  194,  198,  201,  205,  208,  212,  216,
+     220,  223,  227,  231,  235,  239,  243,  247,  251,  255,  259,  263,  267,  272,  276,  280,
+     284,  289,  293,  298,  302,  307,  311,  316,  320,  325,  330,  334,  339,  344,  349,  354,
+     359,  364,  369,  374,  379,  384,  389,  394,  399,  405,  410,  415,  421,  426,  431,  437,
+     442,  448,  453,  459,  465,  470,  476,  482,  488,  494,  500,  505,  511,  517,  523,  530,
+     536,  542,  548,  554,  560,  567,  573,  580,  586,  592,  599,  605,  612,  619,  625,  632,
+     639,  646,  652,  659,  666,  673,  680,  687,  694,  701,  708,  715,  723,  730,  737,  745,
+     752,  759,  767,  774,  782,  789,  797,  805,  812,  820,  828,  836,  843,  851,  859,  867,
+     875,  883,  891,  899,  908,  916,  924,  932,  941,  949,  957,  966,  974,  983,  991, 1000
+};
+
 /**
  * @brief Controls Wio Terminal LCD back light brightness
+ *
+ * Brightness changes are written to the buffered compare register (CCBUF) and take effect at the next
+ * PWM period, so no caller waits for register synchronization. fadeTo() ramps along the gamma curve
+ * from the TC0 overflow interrupt; the application has to forward TC0_Handler() to handleOverflow().
  */
 class LCDBackLight
 {
 private:
-    std::uint8_t currentBrightness = 100;
+    volatile std::uint8_t currentBrightness = 100;
     std::uint8_t maxBrightness = 100;
+
+    // Fade state, shared with the overflow interrupt
+    volatile bool fading = false;
+    std::uint8_t fadeFromLevel = 0;  // Perceived level at the start
+    std::uint8_t fadeToLevel = 0;    // Perceived level at the end
+    std::uint8_t fadeTarget = 0;     // Exact brightness to set at the end
+    std::uint16_t fadeDuration = 0;  // ms
+    volatile std::uint16_t fadeElapsed = 0; // ms
+    std::uint16_t overflowsPerMs = 1;
+    volatile std::uint16_t overflowCount = 0;
+
+    void writeDuty(std::uint8_t duty)
+    {
+        this->currentBrightness = duty;
+        TC0->COUNT8.CCBUF[0].reg = duty;
+    }
+
+    std::uint8_t dutyFromLevel(std::uint8_t level) const
+    {
+        return static_cast<std::uint8_t>((LCD_BACKLIGHT_GAMMA[level] * this->maxBrightness + 500) / 1000);
+    }
+
+    std::uint8_t levelFromDuty(std::uint8_t duty) const
+    {
+        if (this->maxBrightness == 0) return 0;
+        std::uint32_t permille = static_cast<std::uint32_t>(duty) * 1000 / this->maxBrightness;
+        std::uint8_t level = 0;
+        while (level < 255 && LCD_BACKLIGHT_GAMMA[level] < permille) level++;
+        return level;
+    }
+
+    void stopFade()
+    {
+        TC0->COUNT8.INTENCLR.reg = TC_INTENCLR_OVF;
+        this->fading = false;
+    }
+
 public:
     /**
      * @brief Gets current brightness
@@ -37,9 +101,63 @@ public:
      */
     void setBrightness(std::uint8_t brightness)
     {
-        this->currentBrightness = brightness < this->maxBrightness ? brightness : this->maxBrightness;
-        TC0->COUNT8.CC[0].reg = this->currentBrightness;
-        while(TC0->COUNT8.SYNCBUSY.bit.CC0);
+        this->stopFade();
+        this->writeDuty(brightness < this->maxBrightness ? brightness : this->maxBrightness);
+    }
+
+    /**
+     * @brief Starts fading to a brightness without blocking; the ramp is linear in perceived brightness.
+     * @param [in] brightness target in the same units as setBrightness(), clipped to the maximum brightness.
+     * @param [in] durationMs length of the ramp; 0 sets the brightness at once.
+     * @remark A running fade is replaced. isFadeComplete() reports the end of the ramp.
+     */
+    void fadeTo(std::uint8_t brightness, std::uint16_t durationMs)
+    {
+        this->stopFade();
+        std::uint8_t target = brightness < this->maxBrightness ? brightness : this->maxBrightness;
+        if (durationMs == 0 || target == this->currentBrightness) {
+            this->writeDuty(target);
+            return;
+        }
+        // TC0 runs from GCLK0 / 16 and overflows every PER + 1 counts
+        std::uint32_t overflowRate = F_CPU / 16 / (static_cast<std::uint32_t>(this->maxBrightness) + 1);
+        this->overflowsPerMs = static_cast<std::uint16_t>(overflowRate >= 2000 ? overflowRate / 1000 : 1);
+        this->fadeFromLevel = this->levelFromDuty(this->currentBrightness);
+        this->fadeToLevel = this->levelFromDuty(target);
+        this->fadeTarget = target;
+        this->fadeDuration = durationMs;
+        this->fadeElapsed = 0;
+        this->overflowCount = 0;
+        this->fading = true;
+        TC0->COUNT8.INTFLAG.reg = TC_INTFLAG_OVF;
+        TC0->COUNT8.INTENSET.reg = TC_INTENSET_OVF;
+    }
+
+    /**
+     * @brief Gets whether the last fade has reached its target (also true if no fade was started).
+     */
+    bool isFadeComplete() const { return !this->fading; }
+
+    /**
+     * @brief Advances a running fade by one PWM period. Call from TC0_Handler().
+     */
+    void handleOverflow()
+    {
+        TC0->COUNT8.INTFLAG.reg = TC_INTFLAG_OVF;
+        if (!this->fading || ++this->overflowCount < this->overflowsPerMs) {
+            return;
+        }
+        this->overflowCount = 0;
+        std::uint16_t elapsed = this->fadeElapsed + 1;
+        this->fadeElapsed = elapsed;
+        if (elapsed >= this->fadeDuration) {
+            this->writeDuty(this->fadeTarget);
+            this->stopFade();
+            return;
+        }
+        std::int32_t span = static_cast<std::int32_t>(this->fadeToLevel) - this->fadeFromLevel;
+        std::int32_t level = this->fadeFromLevel + span * elapsed / this->fadeDuration;
+        this->writeDuty(this->dutyFromLevel(static_cast<std::uint8_t>(level)));
     }
     /**
      * @brief Sets maximum brightness.
@@ -48,14 +166,13 @@ public:
      */
     void setMaxBrightness(std::uint8_t maxBrightness)
     {
+        this->stopFade();
         this->maxBrightness = maxBrightness;
         if( this->currentBrightness > this->maxBrightness ) {
             this->currentBrightness = this->maxBrightness;
         }
-        TC0->COUNT8.PER.reg = this->maxBrightness;
-        while(TC0->COUNT8.SYNCBUSY.bit.PER);
-        TC0->COUNT8.CC[0].reg = this->currentBrightness;
-        while(TC0->COUNT8.SYNCBUSY.bit.CC0);
+        TC0->COUNT8.PERBUF.reg = this->maxBrightness;
+        TC0->COUNT8.CCBUF[0].reg = this->currentBrightness;
     }
 
     /**
@@ -94,7 +211,7 @@ public:
         
         TC0->COUNT8.CTRLA.reg = (0x01 << 2) | (0x01 << 4) | (0x04 << 8);   // MODE=COUNT8, PRESCALER=DIV16, PRESCSYNC=PRESC
         TC0->COUNT8.WAVE.reg  = 0x02; // WAVEGEN=NPWM;
-        TC0->COUNT8.CTRLBSET.reg = (1u<<1); // LUPD
+        TC0->COUNT8.CTRLBCLR.reg = (1u<<1); // Clear LUPD: PERBUF/CCBUF are copied at each overflow
         TC0->COUNT8.PER.reg = this->maxBrightness;
         TC0->COUNT8.CC[0].reg = this->currentBrightness;
         TC0->COUNT8.CC[1].reg = 0u;
@@ -104,6 +221,11 @@ public:
         
         TC0->COUNT8.CTRLA.bit.ENABLE = 1;   // ENABLE
         while( TC0->COUNT8.SYNCBUSY.bit.ENABLE );
+
+        /* Overflow interrupt is only enabled while fading */
+        TC0->COUNT8.INTENCLR.reg = TC_INTENCLR_MASK;
+        NVIC_SetPriority(TC0_IRQn, 3);
+        NVIC_EnableIRQ(TC0_IRQn);
     }
 };
 #endif //LCD_BACKLIGHT_HPP__
\ No newline at end of file
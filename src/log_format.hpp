@@ -0,0 +1,310 @@
+// Binäres Zeitreihenformat der Logdateien (Firmware und Host-Werkzeuge)
+/**
+ * @file log_format.hpp
+*/
+
+#ifndef LOG_FORMAT_HPP__
+#define LOG_FORMAT_HPP__
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+/*
+ * Aufbau einer Logdatei (alle Werte little-endian):
+ *
+ *   Sektor 0, 1   Dateikopf (LogFileHeader) in zwei Fächern A/B, Rest mit Nullen aufgefüllt
+ *   Sektor 2, 3   Angefangener letzter Block in zwei Fächern A/B
+ *   Sektor 4..n   Volle Blöcke an ihrer festen Position (Block b in Sektor 4 + b)
+ *
+ * Block (512 Byte): uint32 blockIndex, uint16 recordCount, uint16 reserved, uint32 crc32,
+ *                   recordCount Datensätze zu je 10 Byte, Rest mit Nullen aufgefüllt
+ *
+ * Datensatz: uint32 Epoch-Sekunden (Ortszeit der RTC), uint16 Bodenfeuchtigkeit (Rohwert),
+ *            int16 Temperatur in 0,01 °C, int16 Luftfeuchtigkeit in 0,01 %
+ *
+ * Die CRC32 eines Blocks umfasst die ersten 8 Byte des Blockkopfs und die belegten Datensätze.
+ * Gültig sind nur die ersten committedRecords Datensätze laut dem neueren gültigen Dateikopf (höhere
+ * commitSequence). Jeder Commit schreibt den Kopf in das Fach commitSequence % 2 und einen angefangenen
+ * Block in das Blockfach commitSequence % 2; ein abgebrochener Schreibvorgang trifft damit immer das Fach,
+ * auf das der vorige Commit nicht verweist. Bereits bestätigte Sektoren werden nie überschrieben.
+ *
+ * Die Logs sind nach Zeitraum aufgeteilt (standardmäßig ein Tag): <JJJJMMTT>.DAT bzw. bei kürzeren
+ * Zeiträumen <JJMMTTHH>.DAT. Zu jeder Datei gehört ein Index <Name>.IDX mit einem Eintrag pro Block:
+ *   uint32 Epoch-Sekunden des ersten Datensatzes, uint32 Byte-Offset der festen Position des Blocks in der .DAT-Datei
+ *   (solange der Block angefangen ist, liegt sein Inhalt im Blockfach, siehe logCommittedBlockOffset())
+ * Eine Zeitbereichsabfrage ist damit eine binäre Suche im Index und ein sequentielles Lesen ab dem gefundenen Block.
+ */
+
+static const std::size_t LOG_SECTOR_SIZE = 512;
+static const std::size_t LOG_RECORD_SIZE = 10;
+static const std::size_t LOG_BLOCK_HEADER_SIZE = 12;
+static const std::size_t LOG_RECORDS_PER_BLOCK = (LOG_SECTOR_SIZE - LOG_BLOCK_HEADER_SIZE) / LOG_RECORD_SIZE; // 50
+static const std::size_t LOG_INDEX_ENTRY_SIZE = 8;
+static const std::uint16_t LOG_FORMAT_VERSION = 4;
+static const std::uint32_t LOG_HEADER_SECTORS = 2; // Fächer A/B für den Dateikopf
+static const std::uint32_t LOG_TAIL_SECTORS = 2;   // Fächer A/B für den angefangenen Block
+static const std::uint32_t LOG_DATA_SECTOR = LOG_HEADER_SECTORS + LOG_TAIL_SECTORS; // Sektor des ersten vollen Blocks
+static const std::uint32_t LOG_DEFAULT_PARTITION_SPAN = 86400; // Ein Tag
+static const char LOG_FILE_MAGIC[4] = {'A', 'Q', 'B', 'N'};
+
+/**
+ * @brief Ein Messwert-Datensatz
+ */
+struct LogRecord {
+    std::uint32_t epoch = 0;      // Sekunden seit 1970
+    std::uint16_t moisture = 0;   // Rohwert ADC
+    std::int16_t temperature = 0; // 0,01 °C
+    std::int16_t humidity = 0;    // 0,01 %
+};
+
+/**
+ * @brief Dateikopf in Sektor 0 oder 1; wird nach den Datenblöcken geschrieben und dient als Commit-Marke
+ */
+struct LogFileHeader {
+    std::uint16_t version = LOG_FORMAT_VERSION;
+    std::uint16_t sectorSize = LOG_SECTOR_SIZE;
+    std::uint16_t recordSize = LOG_RECORD_SIZE;
+    std::uint16_t recordsPerBlock = LOG_RECORDS_PER_BLOCK;
+    std::uint32_t committedRecords = 0; // Anzahl gültiger Datensätze
+    std::uint32_t commitSequence = 0;   // Wird bei jedem Commit erhöht
+    std::uint32_t partitionStart = 0;   // Beginn des Zeitraums dieser Datei (Epoch-Sekunden)
+    std::uint32_t partitionSpan = LOG_DEFAULT_PARTITION_SPAN; // Länge des Zeitraums in Sekunden
+};
+
+/**
+ * @brief Indexeintrag für einen Block
+ */
+struct LogIndexEntry {
+    std::uint32_t firstEpoch = 0; // Zeitstempel des ersten Datensatzes im Block
+    std::uint32_t offset = 0;     // Byte-Offset des Blocks in der Datendatei
+};
+
+// Serialisierung unabhängig von Byte-Reihenfolge und Struct-Padding
+inline void logPutU16(std::uint8_t *p, std::uint16_t v) { p[0] = static_cast<std::uint8_t>(v); p[1] = static_cast<std::uint8_t>(v >> 8); }
+inline void logPutU32(std::uint8_t *p, std::uint32_t v) { logPutU16(p, static_cast<std::uint16_t>(v)); logPutU16(p + 2, static_cast<std::uint16_t>(v >> 16)); }
+inline std::uint16_t logGetU16(const std::uint8_t *p) { return static_cast<std::uint16_t>(p[0] | (p[1] << 8)); }
+inline std::uint32_t logGetU32(const std::uint8_t *p) { return logGetU16(p) | (static_cast<std::uint32_t>(logGetU16(p + 2)) << 16); }
+
+/**
+ * @brief CRC-32 (IEEE 802.3, wie zlib), bitweise ohne Tabelle
+ * @param [in] crc Zwischenergebnis eines vorherigen Aufrufs bzw. 0 beim Start
+ */
+inline std::uint32_t logCrc32(const std::uint8_t *data, std::size_t length, std::uint32_t crc = 0)
+{
+    crc = ~crc;
+    for (std::size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+/**
+ * @brief Rechnet einen Messwert in Hundertstel um und begrenzt ihn auf den int16-Bereich.
+ */
+inline std::int16_t logToCentis(float value)
+{
+    float scaled = value * 100.0f;
+    if (scaled > 32767.0f) return 32767;
+    if (scaled < -32768.0f) return -32768;
+    return static_cast<std::int16_t>(scaled < 0 ? scaled - 0.5f : scaled + 0.5f);
+}
+
+inline void encodeLogRecord(const LogRecord &record, std::uint8_t *p)
+{
+    logPutU32(p, record.epoch);
+    logPutU16(p + 4, record.moisture);
+    logPutU16(p + 6, static_cast<std::uint16_t>(record.temperature));
+    logPutU16(p + 8, static_cast<std::uint16_t>(record.humidity));
+}
+
+inline LogRecord decodeLogRecord(const std::uint8_t *p)
+{
+    LogRecord record;
+    record.epoch = logGetU32(p);
+    record.moisture = logGetU16(p + 4);
+    record.temperature = static_cast<std::int16_t>(logGetU16(p + 6));
+    record.humidity = static_cast<std::int16_t>(logGetU16(p + 8));
+    return record;
+}
+
+/**
+ * @brief Schreibt den Dateikopf inklusive CRC in einen 512-Byte-Sektor.
+ */
+inline void encodeLogFileHeader(const LogFileHeader &header, std::uint8_t *sector)
+{
+    std::memset(sector, 0, LOG_SECTOR_SIZE);
+    std::memcpy(sector, LOG_FILE_MAGIC, 4);
+    logPutU16(sector + 4, header.version);
+    logPutU16(sector + 6, header.sectorSize);
+    logPutU16(sector + 8, header.recordSize);
+    logPutU16(sector + 10, header.recordsPerBlock);
+    logPutU32(sector + 12, header.committedRecords);
+    logPutU32(sector + 16, header.commitSequence);
+    logPutU32(sector + 20, header.partitionStart);
+    logPutU32(sector + 24, header.partitionSpan);
+    logPutU32(sector + 28, logCrc32(sector, 28));
+}
+
+/**
+ * @brief Liest den Dateikopf aus einem Sektor.
+ * @return false bei falscher Kennung, Version oder CRC
+ */
+inline bool decodeLogFileHeader(const std::uint8_t *sector, LogFileHeader &header)
+{
+    if (std::memcmp(sector, LOG_FILE_MAGIC, 4) != 0 || logGetU32(sector + 28) != logCrc32(sector, 28)) {
+        return false;
+    }
+    header.version = logGetU16(sector + 4);
+    header.sectorSize = logGetU16(sector + 6);
+    header.recordSize = logGetU16(sector + 8);
+    header.recordsPerBlock = logGetU16(sector + 10);
+    header.committedRecords = logGetU32(sector + 12);
+    header.commitSequence = logGetU32(sector + 16);
+    header.partitionStart = logGetU32(sector + 20);
+    header.partitionSpan = logGetU32(sector + 24);
+    return header.version == LOG_FORMAT_VERSION && header.sectorSize == LOG_SECTOR_SIZE
+        && header.recordSize == LOG_RECORD_SIZE && header.recordsPerBlock == LOG_RECORDS_PER_BLOCK;
+}
+
+/**
+ * @brief Wählt aus den beiden Fächern den neueren gültigen Dateikopf.
+ * @return false, wenn keines der Fächer einen gültigen Kopf enthält
+ */
+inline bool selectLogFileHeader(const std::uint8_t *slotA, const std::uint8_t *slotB, LogFileHeader &header)
+{
+    LogFileHeader a;
+    LogFileHeader b;
+    bool validA = decodeLogFileHeader(slotA, a);
+    bool validB = decodeLogFileHeader(slotB, b);
+    if (validA && validB) {
+        // Vergleich, der den Überlauf der Sequenz übersteht
+        header = static_cast<std::int32_t>(b.commitSequence - a.commitSequence) > 0 ? b : a;
+    } else if (validA || validB) {
+        header = validA ? a : b;
+    }
+    return validA || validB;
+}
+
+// Byte-Offsets innerhalb einer Logdatei
+inline std::uint32_t logHeaderOffset(std::uint32_t commitSequence) { return (commitSequence % LOG_HEADER_SECTORS) * LOG_SECTOR_SIZE; }
+inline std::uint32_t logTailOffset(std::uint32_t commitSequence) { return (LOG_HEADER_SECTORS + commitSequence % LOG_TAIL_SECTORS) * LOG_SECTOR_SIZE; }
+inline std::uint32_t logBlockOffset(std::uint32_t block) { return (LOG_DATA_SECTOR + block) * LOG_SECTOR_SIZE; }
+
+/**
+ * @brief Offset, an dem ein bestätigter Block laut Dateikopf liegt: der angefangene letzte Block im Blockfach, sonst an seiner festen Position.
+ */
+inline std::uint32_t logCommittedBlockOffset(const LogFileHeader &header, std::uint32_t block)
+{
+    bool partial = header.committedRecords % LOG_RECORDS_PER_BLOCK != 0 && block == header.committedRecords / LOG_RECORDS_PER_BLOCK;
+    return partial ? logTailOffset(header.commitSequence) : logBlockOffset(block);
+}
+
+/**
+ * @brief Trägt Blocknummer, Anzahl und CRC in den Kopf eines Blocks ein.
+ */
+inline void sealLogBlock(std::uint8_t *block, std::uint32_t blockIndex, std::uint16_t recordCount)
+{
+    logPutU32(block, blockIndex);
+    logPutU16(block + 4, recordCount);
+    logPutU16(block + 6, 0);
+    std::uint32_t crc = logCrc32(block, 8);
+    crc = logCrc32(block + LOG_BLOCK_HEADER_SIZE, recordCount * LOG_RECORD_SIZE, crc);
+    logPutU32(block + 8, crc);
+}
+
+/**
+ * @brief Prüft einen Block.
+ * @param [out] recordCount Anzahl der Datensätze im Block
+ * @return false bei falscher Blocknummer, unplausibler Anzahl oder CRC-Fehler
+ */
+inline bool checkLogBlock(const std::uint8_t *block, std::uint32_t expectedIndex, std::uint16_t &recordCount)
+{
+    recordCount = logGetU16(block + 4);
+    if (logGetU32(block) != expectedIndex || recordCount > LOG_RECORDS_PER_BLOCK) {
+        return false;
+    }
+    std::uint32_t crc = logCrc32(block, 8);
+    crc = logCrc32(block + LOG_BLOCK_HEADER_SIZE, recordCount * LOG_RECORD_SIZE, crc);
+    return crc == logGetU32(block + 8);
+}
+
+inline void encodeLogIndexEntry(const LogIndexEntry &entry, std::uint8_t *p)
+{
+    logPutU32(p, entry.firstEpoch);
+    logPutU32(p + 4, entry.offset);
+}
+
+inline LogIndexEntry decodeLogIndexEntry(const std::uint8_t *p)
+{
+    LogIndexEntry entry;
+    entry.firstEpoch = logGetU32(p);
+    entry.offset = logGetU32(p + 4);
+    return entry;
+}
+
+/**
+ * @brief Binäre Suche im Blockindex.
+ * @param [in] entries Einträge, aufsteigend nach firstEpoch
+ * @param [in] count Anzahl der Einträge
+ * @param [in] epoch Gesuchter Zeitpunkt
+ * @return Index des letzten Blocks, der vor oder bei epoch beginnt (0, wenn epoch vor dem ersten Block liegt)
+ */
+inline std::size_t findLogBlock(const LogIndexEntry *entries, std::size_t count, std::uint32_t epoch)
+{
+    std::size_t low = 0;
+    std::size_t high = count;
+    while (low < high) {
+        std::size_t mid = low + (high - low) / 2;
+        if (entries[mid].firstEpoch <= epoch) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low > 0 ? low - 1 : 0;
+}
+
+/**
+ * @brief Beginn des Zeitraums, zu dem ein Zeitpunkt gehört.
+ */
+inline std::uint32_t logPartitionStart(std::uint32_t epoch, std::uint32_t span)
+{
+    return epoch - epoch % span;
+}
+
+/**
+ * @brief Bildet den 8.3-Dateinamen (ohne Endung) eines Zeitraums: JJJJMMTT für ganze Tage, sonst JJMMTTHH.
+ * @param [out] name Puffer mit mindestens 9 Zeichen
+ */
+inline void formatLogPartitionName(char *name, std::uint32_t partitionStart, std::uint32_t span)
+{
+    // Tage seit 1970 in ein Kalenderdatum umrechnen (Algorithmus "civil_from_days" von H. Hinnant)
+    std::int32_t days = static_cast<std::int32_t>(partitionStart / 86400) + 719468;
+    std::int32_t era = days / 146097;
+    std::uint32_t dayOfEra = static_cast<std::uint32_t>(days - era * 146097);
+    std::uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    std::uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    std::uint32_t mp = (5 * dayOfYear + 2) / 153;
+    std::uint32_t day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    std::uint32_t month = mp < 10 ? mp + 3 : mp - 9;
+    std::uint32_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+    std::uint32_t hour = (partitionStart % 86400) / 3600;
+
+    std::uint32_t fields[4];
+    if (span % 86400 == 0) {
+        fields[0] = year / 100; fields[1] = year % 100; fields[2] = month; fields[3] = day;
+    } else {
+        fields[0] = year % 100; fields[1] = month; fields[2] = day; fields[3] = hour;
+    }
+    for (int i = 0; i < 4; i++) {
+        name[2 * i] = static_cast<char>('0' + fields[i] / 10 % 10);
+        name[2 * i + 1] = static_cast<char>('0' + fields[i] % 10);
+    }
+    name[8] = '\0';
+}
+
+#endif //LOG_FORMAT_HPP__
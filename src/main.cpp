@@ -2,17 +2,36 @@
 #include "config.h" // Konfigurationsdatei für Netzwerkeinstellungen & Iot Hub
 #include <Arduino.h> // Arduino Standard-Bibliothek (Pin-, Serial-Funktionen, etc.)
 #include <TFT_eSPI.h> // Bibliothek für das TFT-Display des Wio Terminals
-#include "DHT.h" // Bibliothek für Grove Temperatur- & Feuchtigkeitssensor (DHT)
+#include "dht_async.hpp" // Nicht blockierender Treiber für den Grove Temperatur- & Feuchtigkeitssensor (DHT11)
 #include <rpcWiFi.h> // WLAN-Verbindung für das Wio Terminal
 #include <SD.h> // Zugriff auf die SD-Karte
 #include <WiFiUdp.h> // UDP-Protokoll für Netzwerkkommunikation (NTP)
 #include <Wire.h> // I2C-Bibliothek für die Kommunikation mit Sensoren
 #include <Adafruit_VL53L0X.h> // Entfernungssensor
+#include "presence_detector.hpp" // Anwesenheitserkennung mit dem Entfernungssensor
 #include "lcd_backlight.hpp" // Steuerung der LCD-Hintergrundbeleuchtung
+#include "scheduler.hpp" // Kooperativer Scheduler für die periodischen Aufgaben
+#include "sensor_snapshot.hpp" // Gemeinsamer Zwischenspeicher der Sensorwerte
+#include "sector_logger.hpp" // Gepufferter, sektorweise schreibender SD-Logger
+#include "telemetry_batch.hpp" // Sammelt Messwerte für gebündelte Telemetrie-Nachrichten
+#include "telemetry_queue.hpp" // Warteschlange auf der SD-Karte für nicht gesendete Telemetrie
+#include "telemetry_json.hpp" // Serialisierung der Telemetrie ohne Heap-Speicher
+#include "ui_compositor.hpp" // Anzeige-Elemente, die nur geänderte Bereiche neu zeichnen
+#include "sunflower_sprites.h" // Vorgerasterte Sonnenblumen für den Standby-Bildschirm
+#include "arc_raster.hpp" // Ganzzahliger Rasterizer für Kreisbögen
+#include "tft_dma.hpp" // Nicht blockierende Übertragung von Bildbereichen per DMA
+#include "profiler.hpp" // Laufzeitmessung der Abschnitte von loop()
+#include "trend_history.hpp" // Verlauf der Messwerte für den Verlaufsbildschirm
+#include "ambient_backlight.hpp" // Helligkeit nach dem Umgebungslicht
+#include "display_sleep.hpp" // Sleep-Modus des Displays im tiefen Standby
+#include "moisture_sampler.hpp" // Gefilterte Bodenfeuchte aus ADC-Bursts per DMA
+#include "watering_controller.hpp" // Zustandsautomat für Pumpe und Relais
+#include "mic_activity.hpp" // Geräuscherkennung am Mikrofon im Hintergrund
+#include "button_events.hpp" // Tasten per Interrupt, entprellt, als Ereignisse
+#include "timed_screen.hpp" // Meldungen mit Anzeigedauer ohne delay()
 #include <AzureIoTHub.h> // Azure IoT Hub SDK für Cloud-Anbindung
 #include <AzureIoTProtocol_MQTT.h> // MQTT-Protokoll für Azure IoT Hub
 #include <iothubtransportmqtt.h> // MQTT-Transport für IoT-Hub-Kommunikation
-#include <ArduinoJson.h> // JSON-Bibliothek für Datenserialisierung
 #include "DateTime.h" // Bibliothek für Datum- und Zeitverwaltung
 #include <time.h> // Standard-Zeitbibliothek für Zeitfunktionen
 #include "samd/NTPClientAz.h" // NTP (Network Time Protocol) für Zeitsynchronisation
@@ -24,7 +43,6 @@
 #define MOISTURE_PIN A2 // Pin A2 für den Feuchtigkeitssensor am rechten Grove-Anschluss
 #define RELAY_PIN D6 // Pin D6, für Relai
 #define DHT_PIN 0 // Grove-Analoganschluss für den DHT-Sensor (Standard ist D0 oder A0)
-#define DHT_TYPE DHT11 // Typ des DHT-Sensors
 #define SDCARD_SS_PIN // CS-Pin für die SD-Karte
 #define DIST_THRESHOLD 100  
 #define TFT_DARKORANGE  0xFCC0 //Farbdefinition Orange
@@ -34,14 +52,17 @@
 #define WIO_KEY_C BUTTON_1 // Knopf C
 
 // Objekte definieren
-File dataFile; // Dateiobjekt für das Speichern der Daten
-DHT dht(DHT_PIN, DHT_TYPE); // DHT-Sensor-Objekt erstellen
+DhtAsync dht(DHT_PIN); // DHT-Sensor-Objekt erstellen
 TFT_eSPI tft = TFT_eSPI();  // Display-Objekt erstellen
 RTC_SAMD51 rtc; // RTC-Objekt erstellen
 Adafruit_VL53L0X lox = Adafruit_VL53L0X(); // Instanz für Distanz-Sensor 
+PresenceDetector presence(lox, DIST_THRESHOLD); // Entprellte Anwesenheitserkennung
+LoopRateCounter loopRate; // Zähler für die Durchläufe von loop() pro Sekunde
 static LCDBackLight backLight; //Objekt für die Hintergrundbeleuchtung
+DisplaySleep displaySleep(tft, backLight); // Tiefer Standby: Display schläft, bis jemand kommt
 IOTHUB_DEVICE_CLIENT_LL_HANDLE _device_ll_handle; //Iot Hub
 TinyGPSPlus gps; //Objekt für GPS Sensor
+Scheduler scheduler; // Scheduler für die periodischen Aufgaben
 
 // Konfiguration für NTP
 WiFiUDP _udp;
@@ -49,21 +70,148 @@ NTPClientAz ntpClient;
 time_t epochTime = (time_t)-1;
 
 // Variablen definieren
-int lastMoistureValue = -1; // Speichern des vorherigen Feuchtigkeitswerts
-float lastTemperature = -1000; // Speichern des vorherigen Temperaturwerts
-float lastHumidity = -1000; // Speichern des vorherigen Feuchtigkeitswerts
-unsigned long previousTimeUpdate = 0; // Letzte Aktualisierung der Uhrzeit
-unsigned long previousSensorUpdate = 0; // Letzte Aktualisierung der Sensorwerte
 const unsigned long timeInterval = 1000; // Intervall für Zeitaktualisierung (1 Sekunde)
 const unsigned long sensorInterval = 4000; // Intervall für Sensoraktualisierung (4 Sekunden)
 const unsigned long displayTimeout = 20000; // Intervall für die Anzeige von Sensorwerten (20 Sekunden)
-const unsigned long IoTHubTimeout = 60000; // Intervall für die Iot Hub (60 Sekunden)
-unsigned long previousIoTHubUpdate = 0; // Letzte Sendung der Sensorwerte an Iot Hub
+const uint16_t backlightFadeInTime = 250; // Aufblenden der Hintergrundbeleuchtung beim Hauptbildschirm (250 Millisekunden)
+const uint16_t backlightFadeOutTime = 1500; // Abblenden beim Wechsel in den Standby (1,5 Sekunden)
+const unsigned long deepStandbyTimeout = 60000; // Nach 60 Sekunden Standby ohne Anwesenheit schläft das Display
+const uint16_t deepStandbyFadeTime = 1000; // Ausblenden vor dem Sleep-Modus (1 Sekunde)
+const unsigned long ambientLightInterval = 500; // Abtastintervall des Lichtsensors (0,5 Sekunden, geglättet über ca. 4 Sekunden)
+const uint16_t ambientFadeTime = 1000; // Nachführen der Helligkeit bei geändertem Umgebungslicht (1 Sekunde)
+const uint16_t ambientHysteresis = 20; // Mindeständerung des gefilterten Lichtsensors (Rohwert 0-1023) für eine neue Helligkeit
+const uint8_t standbyBrightnessPercent = 20; // Helligkeit im Standby in Prozent des Hauptbildschirms
+const uint32_t backlightFullCurrent = 60; // Strom der Hintergrundbeleuchtung bei 100 % in mA (Schätzwert, am Gerät nachmessen)
+// Kennlinie Lichtsensor -> Helligkeit: dunkler Raum, Zimmerbeleuchtung, Tageslicht
+const AmbientCurvePoint ambientCurve[] = {
+    {0, 15},
+    {60, 30},
+    {250, 60},
+    {600, 100}
+};
+AmbientBacklight ambientLight(ambientCurve, sizeof(ambientCurve) / sizeof(ambientCurve[0]), ambientHysteresis, standbyBrightnessPercent);
+BacklightEnergyMeter backlightEnergy(backlightFullCurrent); // Vergleich mit der festen Helligkeit 100 bzw. 20
+const unsigned long IoTHubTimeout = 60000; // Maximales Alter gesammelter Messwerte bis zum Senden an den Iot Hub (60 Sekunden)
+const size_t telemetryBatchSize = 15; // Messwerte pro Iot Hub Nachricht (15 x 4 Sekunden = 1 Minute)
+const unsigned long telemetryCheckInterval = 1000; // Intervall für die Prüfung, ob eine Nachricht fällig ist (1 Sekunde)
+const unsigned long IoTHubWorkInterval = 10; // Intervall für die MQTT-Verarbeitung des Iot Hub (10 Millisekunden)
+const unsigned long dhtPollInterval = 2; // Intervall für den Zustandsautomaten des DHT-Treibers (2 Millisekunden)
+const unsigned long dhtSettleTime = 50; // Wartezeit nach dem Anstoßen einer Messung, bis die Werte verarbeitet werden
+const uint16_t rangingInterval = 50; // Messintervall des Entfernungssensors im Dauermessbetrieb (50 Millisekunden)
+const unsigned long statsInterval = 60000; // Intervall für die Ausgabe der Scheduler-Statistik (60 Sekunden)
+SensorSnapshot sensors(2 * sensorInterval); // Zuletzt erfasste Sensorwerte, gelten nach zwei verpassten Messungen als veraltet
+uint32_t loggedSequence = 0; // SensorReading::sequence der zuletzt auf die SD-Karte geschriebenen Messung
+uint32_t sampledSequence = 0; // SensorReading::sequence der zuletzt für die Telemetrie gesammelten Messung
+MoistureSampler moistureSampler; // Misst die Bodenfeuchte in Bursts, der Wert ist Median und gleitendes Mittel
+const unsigned long wateringInterval = 250; // Intervall des Bewässerungsautomaten (250 Millisekunden, bestimmt die Genauigkeit der Pumpzeit)
+WateringController watering; // Entscheidet als einzige Stelle über das Relais
+bool relayOn = false; // Zuletzt an RELAY_PIN ausgegebener Zustand
+MicSampler micSampler; // Tastet das Mikrofon per Timer und DMA ab und meldet Geräusche
+const unsigned long logFlushInterval = 1000; // Intervall für die Prüfung der Schreibschwellen des SD-Loggers (1 Sekunde)
+const unsigned long logMaxBufferAge = 60000; // Daten bleiben höchstens 60 Sekunden im RAM-Puffer
+const uint32_t logPartitionSpan = 86400; // Zeitraum pro Logdatei in Sekunden (1 Tag)
+SectorLogger dataLog(1, logMaxBufferAge); // SD-Logger, schreibt jeden vollen Sektor bzw. spätestens nach 60 Sekunden
+TelemetryBatch telemetryBatch(telemetryBatchSize, IoTHubTimeout); // Gesammelte Messwerte für die nächste Nachricht
+const uint32_t telemetryQueueCapacity = 64800; // Plätze der Telemetrie-Warteschlange (3 Tage zu je 4 Sekunden, ca. 1 MB)
+const unsigned long telemetryDrainInterval = 5000; // Intervall für das Nachsenden aus der Warteschlange (5 Sekunden)
+const size_t telemetryDrainSamples = 30; // Messwerte pro nachgesendeter Nachricht (6 pro Sekunde, 24-mal schneller als neue anfallen)
+const unsigned long telemetryAckTimeout = 30000; // Ohne Bestätigung des Iot Hub wird nach 30 Sekunden erneut gesendet
+const unsigned long connectionCheckInterval = 30000; // Intervall für die Prüfung der WLAN- und Iot Hub Verbindung (30 Sekunden)
+TelemetryQueue telemetryQueue(telemetryQueueCapacity); // Nicht gesendete Messwerte, übersteht Neustarts
+bool iotHubConnected = false; // Iot Hub Verbindung laut Status-Callback
+bool drainInFlight = false; // Nachgesendete Nachricht wartet auf Bestätigung
+uint32_t drainLastSequence = 0; // Letzte Nummer der unterwegs befindlichen Nachricht
+uintptr_t drainMessageId = 0; // Kennung der unterwegs befindlichen Nachricht, verspätete Bestätigungen werden ignoriert
+unsigned long drainSentTime = 0; // Sendezeitpunkt der unterwegs befindlichen Nachricht
+static TelemetrySample liveInFlight[TelemetryBatch::MAX_SAMPLES]; // Aktuelle Messwerte der unbestätigten Nachricht
+size_t liveInFlightCount = 0; // Anzahl der unbestätigten aktuellen Messwerte (0 = keine Nachricht unterwegs)
+uintptr_t liveMessageId = 0; // Kennung der unterwegs befindlichen Nachricht, verspätete Bestätigungen werden ignoriert
+unsigned long liveSentTime = 0; // Sendezeitpunkt der unterwegs befindlichen Nachricht
+uint32_t drainedSamples = 0; // Bestätigte nachgesendete Messwerte
+uint32_t reportedDrainedSamples = 0; // Stand von drainedSamples bei der letzten Eigenschaften-Meldung
+unsigned long reportedDrainTime = 0; // Zeitpunkt der letzten Eigenschaften-Meldung
+const size_t telemetryJsonSize = 3072; // Größe des Nachrichtenpuffers (30 Messwerte mit Sequenznummer ca. 2,5 KB)
+static char telemetryJson[telemetryJsonSize]; // Statischer Puffer für die jeweils nächste Nachricht
 bool isDisplayingSensorValues = false; // Variable für Sensor-Werte Aktualisierung
 unsigned long displayUpdateTime = 0; // Variable für Display Aktualisierung
-bool firstMainScreen = false; // Variable erster MainScreen
-unsigned long previousFlowerUpdate = 0; // Variable vorherige Standby-Screen Aktualisierung
+unsigned long standbyStartTime = 0; // Beginn des Standby, zählt bis zum Sleep-Modus des Displays
 int plantMode; // Variable für die Pflanzen Modis
+const unsigned long keyHoldTime = 2000; // Knopf A bzw. C so lange halten, um den Verlauf bzw. die Debug-Anzeige ein- und auszuschalten (2 Sekunden)
+const unsigned long overlayScreenInterval = 1000; // Intervall für die Aktualisierung von Verlauf und Debug-Anzeige (1 Sekunde)
+const unsigned long wifiStatusTime = 2000; // Anzeigedauer der WLAN-Meldung beim Start (2 Sekunden)
+const unsigned long modeInfoTime = 1000; // Anzeigedauer der Meldung nach einem Moduswechsel (1 Sekunde)
+const unsigned long timedScreenInterval = 50; // Intervall, in dem der Ablauf einer Meldung geprüft wird (50 Millisekunden)
+
+// Zusatzanzeigen, die Haupt- und Standby-Bildschirm ersetzen, bis die Taste erneut gehalten wird
+enum OverlayScreen {
+    OVERLAY_NONE,
+    OVERLAY_DEBUG, // Laufzeiten des Profilers
+    OVERLAY_TREND  // Verlauf der Messwerte
+};
+OverlayScreen overlayScreen = OVERLAY_NONE;
+
+// Meldungen, die nach ihrer Anzeigedauer zum Hauptbildschirm zurückkehren
+enum TimedScreenId {
+    SCREEN_WIFI_STATUS = 1, // "WLAN verbunden!" bzw. "WLAN fehlgeschlagen!"
+    SCREEN_MODE_INFO        // "Modus: ..." nach einem Tastendruck
+};
+TimedScreen timedScreen;
+
+// Tasten in der Reihenfolge ihres Index in ButtonEvent::button
+enum KeyIndex {
+    KEY_INDEX_A,
+    KEY_INDEX_B,
+    KEY_INDEX_C,
+    KEY_INDEX_COUNT
+};
+const uint8_t keyPins[KEY_INDEX_COUNT] = {WIO_KEY_A, WIO_KEY_B, WIO_KEY_C};
+ButtonInput buttons; // Entprellt im Timer-Interrupt und liefert kurze und lange Tastendrücke
+uint8_t wakeKeys = 0; // Tasten (Bit je Index), die das Display geweckt haben; bis zum Loslassen lösen sie nichts aus
+TrendHistory trendHistory; // Minuten-, Viertelstunden- und Stundenwerte der letzten 1 h / 24 h / 7 d
+uint32_t trendRenderedRevision = 0; // Stand des Verlaufs beim letzten Zeichnen
+
+// Laufzeitmessung; die Abschnitte werden beim Start in dieser Reihenfolge angelegt
+Profiler profiler;
+const int profLoop = profiler.addSection("loop");
+const int profPresence = profiler.addSection("anwesenheit");
+const int profDisplayDma = profiler.addSection("display-dma");
+const int profIotHub = profiler.addSection("iothub");
+const int profDht = profiler.addSection("dht");
+const int profAcquire = profiler.addSection("erfassung");
+const int profDisplay = profiler.addSection("anzeige");
+const int profSunflower = profiler.addSection("sonnenblume");
+const int profSdLog = profiler.addSection("sd-log");
+const int profSdFlush = profiler.addSection("sd-flush");
+const int profTelemetry = profiler.addSection("telemetrie");
+const int profDrain = profiler.addSection("nachsenden");
+
+// Elemente des Hauptbildschirms; gezeichnet wird nur, was sich geändert hat
+UiScreen mainUi(TFT_BLACK);
+UiText titleText(160, 20, MC_DATUM, 3, TFT_WHITE, "AquaBotanica");
+UiText timeLabel(10, 60, TL_DATUM, 2, TFT_WHITE, "Uhrzeit:");
+UiText moistureLabel(10, 100, TL_DATUM, 2, TFT_WHITE, "Pflanze F.:");
+UiText temperatureLabel(10, 140, TL_DATUM, 2, TFT_WHITE, "Temperatur:");
+UiText humidityLabel(10, 180, TL_DATUM, 2, TFT_WHITE, "Luft F.:");
+GlyphAtlas glyphAtlas; // Vorgerasterte Ziffern und Einheiten der Messwertfelder
+UiGlyphField timeField(glyphAtlas, 200, 60, TFT_WHITE);
+UiGlyphField moistureField(glyphAtlas, 200, 100, TFT_WHITE);
+UiGlyphField temperatureField(glyphAtlas, 200, 140, TFT_WHITE);
+UiGlyphField humidityField(glyphAtlas, 200, 180, TFT_WHITE);
+UiText statusBanner(160, 220, MC_DATUM, 3, TFT_GREEN);
+PixelRateCounter displayPixels; // An das Display übertragene Pixel pro Sekunde
+TftDmaRenderer tftDma; // Überträgt die Sprites im Hintergrund, solange loop() weiterläuft
+
+// Stimmungen der Sonnenblume im Standby-Bildschirm
+enum SunflowerMood {
+    SUNFLOWER_MOOD_HAPPY,
+    SUNFLOWER_MOOD_NEUTRAL,
+    SUNFLOWER_MOOD_SAD
+};
+#ifdef SUNFLOWER_LIVE_DRAW
+SpriteStats sunflowerStats; // Zeichenzeiten der Vergleichsmessung
+#else
+SpriteView sunflowerView; // Zeichnet die Sonnenblume nur bei geänderter Stimmung
+#endif
 
 // Schwellenwerte für die Modi
 struct MoistureThreshold {
@@ -76,12 +224,40 @@ MoistureThreshold thresholds[3] = {
     {401, 600}   // Viel Wasserbedarf
 };
 
+// Überlauf-Interrupt von TC0 (PWM der Hintergrundbeleuchtung) treibt das Überblenden
+extern "C" void TC0_Handler(void) {
+    backLight.handleOverflow();
+}
+
+// 1-ms-Takt von TC3 entprellt die Tasten, solange eine prellt oder gedrückt ist
+extern "C" void TC3_Handler(void) {
+    buttons.handleTick();
+}
+
+// Funktion zum Löschen des ganzen Bildschirms für eine andere Anzeige; der Hauptbildschirm zeichnet danach nur seine Elemente neu
+void clearScreen() {
+    tftDma.finish(); // Laufende DMA-Übertragung abschließen, bevor blockierend gezeichnet wird
+    tft.fillScreen(TFT_BLACK);
+    displayPixels.add((uint32_t)tft.width() * tft.height());
+    mainUi.invalidate(true); // Bereits gelöscht, render() löscht nicht noch einmal
+#ifndef SUNFLOWER_LIVE_DRAW
+    sunflowerView.invalidate();
+#endif
+}
+
+// Funktion zum Zeichnen der geänderten Bereiche des Hauptbildschirms
+void renderMainScreen() {
+    ProfileScope scope(profiler, profDisplay);
+    tftDma.finish();
+    displayPixels.add(mainUi.render(tft));
+}
+
 // WLAN Verbindung
 void connectToWiFi() {
     int maxRetries = 2; // Maximale Anzahl an Versuchen
     int retryCount = 0; // Zähler für Versuche
 
-    tft.fillScreen(TFT_BLACK);            
+    clearScreen();
     tft.setTextDatum(MC_DATUM);           
     tft.setTextColor(TFT_WHITE);
     tft.setTextSize(2);
@@ -98,19 +274,19 @@ void connectToWiFi() {
     }
 
     if (WiFi.status() == WL_CONNECTED) {
-        tft.fillScreen(TFT_BLACK);
+        clearScreen();
         tft.setTextColor(TFT_GREEN);
         tft.setTextSize(3);
         tft.drawString("WLAN verbunden!", 160, 100);
         Serial.println("\nWLAN verbunden!");
     } else {
-        tft.fillScreen(TFT_BLACK);
+        clearScreen();
         tft.setTextColor(TFT_RED);
         tft.setTextSize(2);
         tft.drawString("WLAN fehlgeschlagen!", 160, 100);
         Serial.println("\nWLAN fehlgeschlagen!");
     }
-    delay(2000); 
+    timedScreen.show(SCREEN_WIFI_STATUS, millis(), wifiStatusTime); // Bleibt stehen, während setup() weiterläuft
 }
 
 // Aktuelle Uhrzeit setzen
@@ -151,33 +327,25 @@ static void initTime()
     Serial.println("RTC erfolgreich synchronisiert!");
 }
 
-
-// Funktion zum Zeichnen eines Kreisbogens
+#ifdef SUNFLOWER_LIVE_DRAW
+// Funktion zum Zeichnen eines Kreisbogens (waagrechte Linienstücke statt einzelner Pixel)
 void drawArc(int x, int y, int r, int startAngle, int endAngle, uint16_t color, int thickness) {
-    for (int i = startAngle; i <= endAngle; i++) {
-    float angle = i * 3.14159 / 180.0;
-    int x0 = x + (int)(cos(angle) * r);
-    int y0 = y - (int)(sin(angle) * r);
-    tft.drawPixel(x0, y0, color);
-
-        for (int j = -thickness / 2; j < thickness / 2; j++) {
-            tft.drawPixel(x0 + j, y0, color);
-        }
-    }
+    rasterizeArc(x, y, r, thickness, startAngle, endAngle, [color](int spanX, int spanY, int width) {
+        tft.drawFastHLine(spanX, spanY, width, color);
+    });
 }
 
 // Funktion zum Zeichnen der Blume für Standby-Screen
-void drawSunflower(String mood, uint16_t faceColor) {
-    tft.fillScreen(TFT_BLACK);
+void drawSunflower(SunflowerMood mood, uint16_t faceColor) {
+    clearScreen();
 
     int centerX = 160; // Horizontal zentriert
     int centerY = 90; // Vertikal zentriert
     int faceRadius = 50; // Radius des Gesichts
 
     for (int angle = 0; angle < 360; angle += 30) {
-    float rad = angle * 3.14159 / 180.0;
-    int xOffset = (int)(cos(rad) * 60);
-    int yOffset = (int)(sin(rad) * 60);
+    int xOffset = arcCos(angle) * 60 / (1 << ARC_TRIG_SHIFT);
+    int yOffset = arcSin(angle) * 60 / (1 << ARC_TRIG_SHIFT);
 
     tft.fillCircle(centerX + xOffset,centerY + yOffset,20,TFT_YELLOW);
     }
@@ -193,11 +361,11 @@ void drawSunflower(String mood, uint16_t faceColor) {
     int mouthY = centerY + 20;  
     int mouthRadius = 25;      
 
-    if (mood == "happy") {
+    if (mood == SUNFLOWER_MOOD_HAPPY) {
     // Lachender Mund (oben gewölbt)
     drawArc(centerX, mouthY, mouthRadius, 180, 360, TFT_BLACK, 4);
     } 
-    else if (mood == "sad") {
+    else if (mood == SUNFLOWER_MOOD_SAD) {
     // Trauriger Mund (unten gewölbt)
     drawArc(centerX, mouthY + 10, mouthRadius, 0, 180, TFT_BLACK, 4);
     } 
@@ -225,151 +393,184 @@ void drawSunflower(String mood, uint16_t faceColor) {
     // Rechtes Blatt
     tft.fillEllipse(centerX + leafOffsetX, leafCenterY, leafRadiusX, leafRadiusY, TFT_GREEN);
 }
+#endif
+
+// Funktion zum Anzeigen der Blume für den Standby-Screen; die Sprites liegen lauflängenkodiert im Flash
+void showSunflower(SunflowerMood mood, uint16_t faceColor) {
+    ProfileScope scope(profiler, profSunflower);
+#ifdef SUNFLOWER_LIVE_DRAW
+    // Vergleichsmessung: Blume bei jedem Aufruf komplett neu zeichnen
+    uint32_t start = micros();
+    drawSunflower(mood, faceColor);
+    uint32_t duration = micros() - start;
+    sunflowerStats.frames++;
+    sunflowerStats.lastDrawMicros = duration;
+    if (duration > sunflowerStats.maxDrawMicros) sunflowerStats.maxDrawMicros = duration;
+#else
+    static const RleSprite *sprites[] = {&SUNFLOWER_HAPPY, &SUNFLOWER_NEUTRAL, &SUNFLOWER_SAD};
+    const uint16_t palette[4] = {TFT_BLACK, TFT_YELLOW, faceColor, TFT_GREEN};
+#ifdef TFT_BLOCKING_BLIT
+    displayPixels.add(sunflowerView.show(tft, *sprites[mood], palette)); // Vergleichsmessung: blockierend übertragen
+#else
+    displayPixels.add(sunflowerView.show(tft, tftDma, *sprites[mood], palette));
+#endif
+#endif
+}
+
+// Funktion für die Zeichenstatistik der Sonnenblume
+const SpriteStats &getSunflowerStats() {
+#ifdef SUNFLOWER_LIVE_DRAW
+    return sunflowerStats;
+#else
+    return sunflowerView.getStats();
+#endif
+}
 
 // Funktion zum Aktualisieren der Anzeige-Zeit
 void updateTimeDisplay() {
     DateTime now = rtc.now();
     char timeBuffer[16];
     snprintf(timeBuffer, sizeof(timeBuffer), "%02d:%02d:%02d", now.hour(), now.minute(), now.second());
-    tft.fillRect(200, 60, 100, 30, TFT_BLACK);
-    tft.setCursor(200, 60);
-    tft.setTextColor(TFT_WHITE);
-    tft.setTextSize(2);
-    tft.println(timeBuffer);
+    timeField.set(timeBuffer);
+    renderMainScreen();
 }
 
-// Funktion für das Ein- und Ausschalten des Relai
-void controlRelayBasedOnMoisture(int moistureValue) {
+// Funktion zum Formatieren eines Messwerts mit zwei Nachkommastellen wie tft.print(float), ohne Float-printf
+void formatValue(char *buffer, size_t size, float value, const char *unit) {
+    if (isnan(value)) {
+        snprintf(buffer, size, "-- %s", unit);
+        return;
+    }
+    int centis = logToCentis(value);
+    int magnitude = centis < 0 ? -centis : centis;
+    snprintf(buffer, size, "%s%d.%02d %s", centis < 0 ? "-" : "", magnitude / 100, magnitude % 100, unit);
+}
+
+// Funktion zum Wechseln des Pflanzenmodus; die Bewässerung gießt ab der unteren Schwelle bis zur Mitte des Bereichs "Bald Giessen"
+void setPlantMode(int mode) {
+    plantMode = mode;
     MoistureThreshold currentThreshold = thresholds[plantMode - 1];
-    if (moistureValue <= currentThreshold.low) { 
-        digitalWrite(RELAY_PIN, HIGH);  // Relais einschalten
-    } else if (moistureValue > currentThreshold.low && moistureValue <= currentThreshold.high) {
-        digitalWrite(RELAY_PIN, LOW);  // Relais ausschalten
-    } else {
-        digitalWrite(RELAY_PIN, LOW);  // Relais ausschalten
+    WateringConfig config = watering.getConfig();
+    config.startAtOrBelow = currentThreshold.low;
+    config.stopAbove = (currentThreshold.low + currentThreshold.high) / 2;
+    watering.setConfig(config);
+}
+
+// Callback des DHT-Treibers, sobald eine Messung abgeschlossen ist
+void onDhtResult(const DhtResult &result) {
+    float temperature = result.valid ? result.temperature : NAN;
+    float humidity = result.valid ? result.humidity : NAN;
+    if (!sensors.publishClimate(temperature, humidity, millis())) {
+        Serial.println("Fehler beim Lesen eines Sensors!");
     }
 }
 
-// Funktion zum Aktualisieren der Sensorwerte
-void updateSensorData(int moistureValue, float temperature, float humidity) {
-    if (moistureValue != lastMoistureValue || firstMainScreen) {
-        tft.fillRect(200, 100, 80, 30, TFT_BLACK);
-        tft.setCursor(200, 100);
-        tft.setTextColor(TFT_WHITE);
-        tft.setTextSize(2);
-        tft.print(moistureValue);
-        lastMoistureValue = moistureValue;
+// Funktion zum Erfassen der Sensorwerte (einziger Hardwarezugriff auf Feuchtigkeits- und DHT-Sensor)
+void acquireSensors() {
+    unsigned long now = millis();
+    if (moistureSampler.isReady()) {
+        if (micSampler.sharesAdc(MOISTURE_PIN)) {
+            micSampler.pause(); // Der ADC gehört bis zum Ende des Bursts der Bodenfeuchte
+        }
+        if (!moistureSampler.start()) {
+            micSampler.resume();
+        }
+    } else {
+        sensors.publishMoisture(analogRead(MOISTURE_PIN), now); // Ohne DMA-Kanal: Einzelmessung
     }
 
-    if (temperature != lastTemperature || firstMainScreen) {
-        tft.fillRect(200, 140, 100, 30, TFT_BLACK);
-        tft.setCursor(200, 140);
-        tft.setTextColor(TFT_WHITE);
-        tft.setTextSize(2);
-        tft.print(temperature);
-        tft.print(" C");
-        lastTemperature = temperature;
+    // DHT-Messung nur anstoßen, das Ergebnis kommt über onDhtResult
+    if (sensors.isClimateDue(now)) {
+        dht.start(now);
     }
+}
 
-    if (humidity != lastHumidity || firstMainScreen) {
-        tft.fillRect(200, 180, 100, 30, TFT_BLACK);
-        tft.setCursor(200, 180);
-        tft.setTextColor(TFT_WHITE);
-        tft.setTextSize(2);
-        tft.print(humidity);
-        tft.print(" %");
-        lastHumidity = humidity;
+// Funktion zum Übernehmen eines fertigen Bursts der Bodenfeuchte
+void pollMoistureSampler() {
+    if (moistureSampler.poll()) {
+        micSampler.resume();
+        const MoistureFilter &filter = moistureSampler.getFilter();
+        sensors.publishMoisture(filter.getValue(), millis(), filter.getNoiseTenths());
     }
+}
 
-    tft.fillRect(0, 200, 320, 40, TFT_BLACK);
-    String statusMessage;
-    MoistureThreshold currentThreshold = thresholds[plantMode - 1];
+// Funktion zum Aktualisieren der Sensorwerte (übertragen werden nur geänderte Felder)
+void updateSensorData(int moistureValue, float temperature, float humidity) {
+    char buffer[UiText::MAX_TEXT];
+    snprintf(buffer, sizeof(buffer), "%d", moistureValue);
+    moistureField.set(buffer);
+    formatValue(buffer, sizeof(buffer), temperature, "C");
+    temperatureField.set(buffer);
+    formatValue(buffer, sizeof(buffer), humidity, "%");
+    humidityField.set(buffer);
 
     // Anzeige der drei Status
+    MoistureThreshold currentThreshold = thresholds[plantMode - 1];
     if (moistureValue <= currentThreshold.low) {
-        statusMessage = "Giessen";
-        tft.setTextColor(TFT_RED);
+        statusBanner.set("Giessen", TFT_RED);
     } else if (moistureValue > currentThreshold.low && moistureValue <= currentThreshold.high) {
-        statusMessage = "Bald Giessen";
-        tft.setTextColor(TFT_YELLOW);
+        statusBanner.set("Bald Giessen", TFT_YELLOW);
     } else {
-        statusMessage = "Alles Gut";
-        tft.setTextColor(TFT_GREEN);
+        statusBanner.set("Alles Gut", TFT_GREEN);
     }
+    renderMainScreen();
+}
 
-    tft.setTextDatum(MC_DATUM);
-    tft.setTextSize(3);
-    tft.drawString(statusMessage, 160, 220);
-
-    // Relai
-    controlRelayBasedOnMoisture(moistureValue);
-}
-
-// Funktion zum schreiben der Daten auf die SD-Karte
-void logDataToCSV(int moistureValue, float temperature, float humidity) {
-    dataFile = SD.open("sensors.csv", FILE_WRITE); // Datei im Anhängemodus öffnen
-
-    if (dataFile) {
-        DateTime now = rtc.now(); // Aktuelle Uhrzeit abrufen
-        char timeBuffer[16];
-        snprintf(timeBuffer, sizeof(timeBuffer), "%02d:%02d:%02d", now.hour(), now.minute(), now.second());
-
-        // Datenzeile in die CSV schreiben
-        dataFile.print(timeBuffer); // Zeit
-        dataFile.print(",");
-        dataFile.print(moistureValue); // Feuchtigkeit
-        dataFile.print(",");
-        dataFile.print(temperature); // Temperatur
-        dataFile.print(",");
-        dataFile.println(humidity); // Luftfeuchtigkeit
-        dataFile.close(); // Datei schließen
-    } else {
-        Serial.println("Fehler beim Öffnen der CSV-Datei!");
+// Funktion zum schreiben der Daten auf die SD-Karte (nur in den RAM-Puffer, geschrieben wird blockweise)
+void logData(int moistureValue, float temperature, float humidity) {
+    LogRecord record;
+    record.epoch = rtc.now().unixtime(); // Aktuelle Uhrzeit abrufen
+    record.moisture = static_cast<uint16_t>(moistureValue);
+    record.temperature = logToCentis(temperature);
+    record.humidity = logToCentis(humidity);
+
+    uint32_t rotations = dataLog.getStats().rotations;
+    bool wasOpen = dataLog.isReady();
+    if (!dataLog.append(record, millis())) {
+        Serial.println("Fehler beim Puffern der Logdaten!");
+    } else if (!wasOpen || dataLog.getStats().rotations != rotations) {
+        Serial.printf("Logdatei: %s\n", dataLog.getPartitionName());
+    }
+}
+
+// Funktion zum Zusammenstellen des Hauptbildschirms aus seinen Elementen
+void setupMainScreen() {
+    UiElement *elements[] = {&titleText, &timeLabel, &moistureLabel, &temperatureLabel, &humidityLabel,
+                             &timeField, &moistureField, &temperatureField, &humidityField, &statusBanner};
+    for (UiElement *element : elements) {
+        mainUi.add(*element);
     }
 }
 
-// Funktion für den Hauptbildschirm
+// Funktion für den Hauptbildschirm (nach einer anderen Anzeige komplett, sonst nur geänderte Bereiche)
 void mainScreen() {
+    // Nach einer anderen Anzeige einmal löschen, die Elemente werden dann vollständig gezeichnet
+    if (!isDisplayingSensorValues) {
+        clearScreen();
+    }
+
     // Anzeige definieren
-    backLight.setBrightness(100);
-    tft.fillScreen(TFT_BLACK);
-    tft.setTextDatum(MC_DATUM);   
-    tft.setTextSize(3);           
-    tft.setTextColor(TFT_WHITE);
-    tft.drawString("AquaBotanica", 160, 20);  
-    tft.setTextDatum(TL_DATUM);
-    tft.setTextColor(TFT_WHITE);
-    tft.setTextSize(2);
-    tft.setCursor(10, 60);
-    tft.println("Uhrzeit:");
-    tft.setCursor(10, 100);
-    tft.println("Pflanze F.:");
-    tft.setCursor(10, 140);
-    tft.println("Temperatur:");
-    tft.setCursor(10, 180);
-    tft.println("Luft F.:");
+    backLight.fadeTo(ambientLight.getMainBrightness(), backlightFadeInTime);
 
     // Aktualiserung der Sensordaten, Zeit und Relai
-    int moistureValue = analogRead(MOISTURE_PIN);
-    float temperature = dht.readTemperature();
-    float humidity = dht.readHumidity();
-    updateSensorData(moistureValue, temperature, humidity);
+    const SensorReading &reading = sensors.get();
+    updateSensorData(reading.moisture, reading.temperature, reading.humidity);
     updateTimeDisplay();
-    controlRelayBasedOnMoisture(moistureValue);
     isDisplayingSensorValues = true;
 }
 
 // Funktion für den Standby-Screen
 void showStandbyScreen() {
-    tft.fillScreen(TFT_BLACK); 
-    backLight.setBrightness(20);
-    tft.setCursor(10, 10);
-    drawSunflower("neutral", TFT_DARKYELLOW);
+    clearScreen();
+    backLight.fadeTo(ambientLight.getStandbyBrightness(), backlightFadeOutTime);
+    showSunflower(SUNFLOWER_MOOD_NEUTRAL, TFT_DARKYELLOW);
+    standbyStartTime = millis();
 }
 
 // Funktion für IoT Hub Verbindung Prüfung
 static void connectionStatusCallback(IOTHUB_CLIENT_CONNECTION_STATUS result, IOTHUB_CLIENT_CONNECTION_STATUS_REASON reason, void *user_context)
 {
+    iotHubConnected = result == IOTHUB_CLIENT_CONNECTION_AUTHENTICATED;
     if (result == IOTHUB_CLIENT_CONNECTION_AUTHENTICATED)
     {
         Serial.println("The device client is connected to IoT Hub");
@@ -381,11 +582,9 @@ static void connectionStatusCallback(IOTHUB_CLIENT_CONNECTION_STATUS result, IOT
     }
 }
 
-// Funktion für die IoT Hub Verbindung
-void connectIoTHub()
+// Funktion zum Erstellen des Iot Hub Clients
+void createIoTHubClient()
 {
-    IoTHub_Init();
-
     _device_ll_handle = IoTHubDeviceClient_LL_CreateFromConnectionString(CONNECTION_STRING, MQTT_Protocol);
     
     if (_device_ll_handle == NULL)
@@ -397,39 +596,577 @@ void connectIoTHub()
     IoTHubDeviceClient_LL_SetConnectionStatusCallback(_device_ll_handle, connectionStatusCallback, NULL);
 }
 
-// Funktion zum senden der Daten an den IoT Hub
-void sendTelemetry(const char *telemetry)
+// Funktion für die IoT Hub Verbindung
+void connectIoTHub()
+{
+    IoTHub_Init();
+    createIoTHubClient();
+}
+
+// Funktion zum senden der Daten an den IoT Hub, der Callback meldet die Bestätigung durch den Hub
+bool sendTelemetry(const char *telemetry, IOTHUB_CLIENT_EVENT_CONFIRMATION_CALLBACK callback = NULL, void *context = NULL)
 {
+    if (_device_ll_handle == NULL) {
+        return false;
+    }
     IOTHUB_MESSAGE_HANDLE message_handle = IoTHubMessage_CreateFromString(telemetry);
     if (message_handle == NULL) {
     Serial.println("Failed to create IoT Hub message!");
-    return;
+    return false;
 }
-    IoTHubDeviceClient_LL_SendEventAsync(_device_ll_handle, message_handle, NULL, NULL);
+    IOTHUB_CLIENT_RESULT result = IoTHubDeviceClient_LL_SendEventAsync(_device_ll_handle, message_handle, callback, context);
     IoTHubMessage_Destroy(message_handle);
- 
+    return result == IOTHUB_CLIENT_OK;
+}
+
+// Funktion zum Lesen der GPS-Position
+void readGpsPosition(double &latitude, double &longitude)
+{
+    while (Serial1.available() > 0)
+    {
+        char c = Serial1.read(); // Zeichen vom GPS-Modul lesen
+        gps.encode(c); // GPS-Daten verarbeiten
+    }
+
+    // Standardwert: FH Joanneum 
+    latitude = 47.06895;
+    longitude = 15.40643;
+
+    if (gps.location.isValid())
+    {
+        latitude = gps.location.lat();
+        longitude = gps.location.lng();
+    }
+}
+
+// Funktion zum Erstellen der Telemetrie-Nachricht im statischen Puffer; nachgesendete Messwerte tragen ihre Nummer aus der Warteschlange
+const char *serializeTelemetry(const TelemetrySample *samples, size_t count, bool queued, uint32_t firstSequence)
+{
+    TelemetryHeader header;
+    readGpsPosition(header.latitude, header.longitude);
+    header.queued = queued;
+    header.firstSequence = firstSequence;
+
+    if (encodeTelemetryJson(header, samples, count, telemetryJson, sizeof(telemetryJson)) == 0) {
+        Serial.println("Telemetrie-Nachricht passt nicht in den Puffer!");
+        return NULL;
+    }
+    return telemetryJson;
+}
+
+// Bestätigung des Iot Hub für nachgesendete Messwerte; erst dann werden sie aus der Warteschlange entfernt
+static void drainConfirmationCallback(IOTHUB_CLIENT_CONFIRMATION_RESULT result, void *user_context)
+{
+    if (!drainInFlight || (uintptr_t)user_context != drainMessageId) {
+        return; // Nach Zeitüberschreitung bereits erneut gesendet, drainLastSequence gehört zu einer anderen Nachricht
+    }
+    drainInFlight = false;
+    if (result == IOTHUB_CLIENT_CONFIRMATION_OK) {
+        uint32_t released = telemetryQueue.getStats().released;
+        telemetryQueue.release(drainLastSequence);
+        drainedSamples += telemetryQueue.getStats().released - released;
+    } else {
+        Serial.printf("Nachgesendete Telemetrie nicht bestaetigt (%d), wird wiederholt\n", result);
+    }
+}
+
+// Unbestätigte aktuelle Messwerte in die Warteschlange übernehmen, sie werden gedrosselt nachgesendet
+void queueLiveInFlight()
+{
+    size_t stored = telemetryQueue.push(liveInFlight, liveInFlightCount);
+    Serial.printf("%u von %u unbestaetigten Messwerten gespeichert (Warteschlange: %lu)\n",
+                  (unsigned)stored, (unsigned)liveInFlightCount, (unsigned long)telemetryQueue.getDepth());
+    liveInFlightCount = 0;
+}
+
+// Bestätigung des Iot Hub für aktuelle Messwerte; bei Fehler wandern sie in die Warteschlange
+static void liveConfirmationCallback(IOTHUB_CLIENT_CONFIRMATION_RESULT result, void *user_context)
+{
+    if (liveInFlightCount == 0 || (uintptr_t)user_context != liveMessageId) {
+        return; // Nach Zeitüberschreitung bereits gespeichert
+    }
+    if (result == IOTHUB_CLIENT_CONFIRMATION_OK) {
+        liveInFlightCount = 0;
+        return;
+    }
+    Serial.printf("Telemetrie nicht bestaetigt (%d): ", result);
+    queueLiveInFlight();
+}
+
+// Aufgabe: MQTT-Verarbeitung des Iot Hub
+void iotHubWorkTask() {
+    ProfileScope scope(profiler, profIotHub);
+    IoTHubDeviceClient_LL_DoWork(_device_ll_handle);
+}
+
+// Aufgabe: Uhrzeit jede Sekunde aktualisieren
+void timeDisplayTask() {
+    if (isDisplayingSensorValues) {
+        updateTimeDisplay();
+    }
+}
+
+// Aufgabe: Sensorwerte einmal pro Periode erfassen
+void acquisitionTask() {
+    ProfileScope scope(profiler, profAcquire);
+    acquireSensors();
+}
+
+// Aufgabe: Zustandsautomat des DHT-Treibers weiterschalten
+void dhtTask() {
+    ProfileScope scope(profiler, profDht);
+    dht.poll(millis());
+}
+
+// Aufgabe: Sensorwerte alle 4 Sekunden auf dem Hauptbildschirm aktualisieren
+void sensorTask() {
+    unsigned long now = millis();
+    const SensorReading &reading = sensors.get();
+    if (sensors.isMoistureStale(now)) {
+        return;
+    }
+
+    if (isDisplayingSensorValues && !sensors.isClimateStale(now)) {
+        updateSensorData(reading.moisture, reading.temperature, reading.humidity);
+    }
+}
+
+// Aufgabe: Bewässerungsautomat weiterschalten, Relais schalten und jede Wassergabe protokollieren
+void wateringTask() {
+    unsigned long now = millis();
+    const SensorReading &reading = sensors.get();
+    bool pump = watering.update(static_cast<uint16_t>(reading.moisture), !sensors.isMoistureStale(now), now);
+    if (pump != relayOn) {
+        digitalWrite(RELAY_PIN, pump ? HIGH : LOW);
+        relayOn = pump;
+    }
+
+    WateringDose dose;
+    while (watering.popDose(dose)) {
+        Serial.printf("Bewaesserung: %lu ms gepumpt, Feuchte vorher %u, beim Abschalten %u, Budget %lu/%lu ms%s\n",
+                      (unsigned long)dose.duration, (unsigned)dose.moistureBefore, (unsigned)dose.moistureAtStop,
+                      (unsigned long)dose.budgetUsed, (unsigned long)watering.getConfig().dailyBudget,
+                      dose.budgetLimited ? " (Tagesbudget erreicht)" : "");
+    }
+}
+
+// Aufgabe: Standby Screen; nach deepStandbyTimeout ohne Anwesenheit schläft das Display (dann kein Zeichnen mehr)
+void standbyTask() {
+    if (isDisplayingSensorValues || overlayScreen != OVERLAY_NONE || timedScreen.isActive() || !displaySleep.isAwake()) {
+        return;
+    }
+
+    int moistureValue = sensors.get().moisture;
+    uint16_t faceColor = TFT_DARKORANGE;
+    MoistureThreshold currentThreshold = thresholds[plantMode - 1];
+
+    if (moistureValue > currentThreshold.high) { // In Ordnung
+        showSunflower(SUNFLOWER_MOOD_HAPPY, faceColor);
+    } else if (moistureValue > currentThreshold.low) { // Bald gießen
+        showSunflower(SUNFLOWER_MOOD_NEUTRAL, faceColor);
+    } else { // Sofort gießen
+        showSunflower(SUNFLOWER_MOOD_SAD, faceColor);
+    }
+
+    unsigned long now = millis();
+    if (!presence.isPresent() && now - standbyStartTime >= deepStandbyTimeout) {
+        tftDma.finish(); // Sonnenblume fertig übertragen, das Bild bleibt im Display-Speicher
+        displaySleep.sleep(now, deepStandbyFadeTime);
+    }
+}
+
+// Aufgabe: Daten auf SD Karte schreiben alle 4 Sekunden
+void loggingTask() {
+    ProfileScope scope(profiler, profSdLog);
+    unsigned long now = millis();
+    const SensorReading &reading = sensors.get();
+
+    // Jede Messung nur einmal speichern: ohne neue Messung seit dem letzten Eintrag wird nichts geloggt,
+    // auch wenn die Werte noch nicht als veraltet gelten
+    if (reading.sequence == loggedSequence) {
+        return;
+    }
+    if (!sensors.isMoistureStale(now) && !sensors.isClimateStale(now)) {
+        loggedSequence = reading.sequence;
+        logData(reading.moisture, reading.temperature, reading.humidity);
+    } else {
+        Serial.println("Keine aktuellen Sensorwerte zum Speichern!");
+    }
+}
+
+// Aufgabe: Gepufferte Logdaten bei Erreichen der Größen- oder Zeitschwelle auf die SD-Karte schreiben
+void logFlushTask() {
+    ProfileScope scope(profiler, profSdFlush);
+    dataLog.service(millis());
+}
+
+// Aufgabe: Aktuelle Messwerte für die Telemetrie sammeln
+void telemetrySampleTask() {
+    unsigned long now = millis();
+    const SensorReading &reading = sensors.get();
+    if (reading.sequence == sampledSequence || sensors.isMoistureStale(now) || sensors.isClimateStale(now)) {
+        return;
+    }
+    sampledSequence = reading.sequence;
+
+    TelemetrySample sample;
+    sample.epoch = rtc.now().unixtime();
+    sample.moisture = reading.moisture;
+    sample.temperature = reading.temperature;
+    sample.humidity = reading.humidity;
+    telemetryBatch.add(sample, now);
+    trendHistory.add(sample.epoch, sample.moisture, sample.temperature, sample.humidity);
+}
+
+// Aufgabe: Gesammelte Messwerte als eine Nachricht an den IoT Hub senden
+void telemetryTask() {
+    unsigned long now = millis();
+    if (liveInFlightCount > 0 && now - liveSentTime >= telemetryAckTimeout) {
+        // Keine Bestätigung: nachsenden, die Nachricht kann den Empfänger trotzdem erreicht haben
+        Serial.print("Telemetrie nicht bestaetigt (Zeitueberschreitung): ");
+        queueLiveInFlight();
+    }
+    if (!telemetryBatch.isReady(now)) {
+        return;
+    }
+    ProfileScope scope(profiler, profTelemetry);
+
+    // Nur eine aktuelle Nachricht gleichzeitig unterwegs, sonst geht es über die Warteschlange
+    if (iotHubConnected && liveInFlightCount == 0) {
+        const char *telemetry = serializeTelemetry(telemetryBatch.data(), telemetryBatch.size(), false, 0);
+
+        // Daten an Iot Hub senden, bis zur Bestätigung bleibt eine Kopie im RAM
+        Serial.printf("Sending telemetry (%u samples): ", (unsigned)telemetryBatch.size());
+        Serial.println(telemetry != NULL ? telemetry : "");
+        liveMessageId++;
+        if (telemetry != NULL && sendTelemetry(telemetry, liveConfirmationCallback, (void *)liveMessageId)) {
+            memcpy(liveInFlight, telemetryBatch.data(), telemetryBatch.size() * sizeof(TelemetrySample));
+            liveInFlightCount = telemetryBatch.size();
+            liveSentTime = now;
+            telemetryBatch.clear();
+            return;
+        }
+    }
+
+    // Keine Verbindung: Messwerte für das spätere Nachsenden auf der SD-Karte speichern
+    size_t stored = telemetryQueue.push(telemetryBatch.data(), telemetryBatch.size());
+    Serial.printf("Iot Hub nicht erreichbar, %u von %u Messwerten gespeichert (Warteschlange: %lu)\n",
+                  (unsigned)stored, (unsigned)telemetryBatch.size(), (unsigned long)telemetryQueue.getDepth());
+    telemetryBatch.clear();
+}
+
+// Aufgabe: Gespeicherte Messwerte gedrosselt nachsenden, während die aktuellen normal weiterlaufen
+void telemetryDrainTask() {
+    unsigned long now = millis();
+    if (drainInFlight) {
+        if (now - drainSentTime < telemetryAckTimeout) {
+            return;
+        }
+        // Keine Bestätigung: erneut senden, der Empfänger erkennt Doppelte an der Nummer
+        drainInFlight = false;
+    }
+    if (!iotHubConnected || telemetryQueue.isEmpty()) {
+        return;
+    }
+    ProfileScope scope(profiler, profDrain);
+
+    static TelemetrySample drainBuffer[telemetryDrainSamples];
+    uint32_t firstSequence = 0;
+    size_t count = telemetryQueue.peek(drainBuffer, telemetryDrainSamples, firstSequence);
+    if (count == 0) {
+        return;
+    }
+    const char *telemetry = serializeTelemetry(drainBuffer, count, true, firstSequence);
+    drainMessageId++;
+    if (telemetry != NULL && sendTelemetry(telemetry, drainConfirmationCallback, (void *)drainMessageId)) {
+        drainInFlight = true;
+        drainLastSequence = firstSequence + count - 1;
+        drainSentTime = now;
+    }
+}
+
+// Aufgabe: WLAN und Iot Hub Client bei Bedarf neu verbinden
+void connectionTask() {
+    if (WiFi.status() != WL_CONNECTED) {
+        Serial.println("WLAN getrennt, neuer Verbindungsversuch...");
+        iotHubConnected = false;
+        WiFi.begin(ssid, password);
+        return;
+    }
+    // Die MQTT-Verbindung stellt der Client selbst wieder her, fehlen kann nur der Client
+    if (_device_ll_handle == NULL) {
+        createIoTHubClient();
+    }
+}
+
+// Aufgabe: Füllstand und Durchsatz der Warteschlange als Geräteeigenschaften melden
+void queuePropertiesTask() {
+    unsigned long now = millis();
+    if (!iotHubConnected) {
+        return;
+    }
+    unsigned long elapsed = now - reportedDrainTime;
+    uint32_t drainRate = elapsed > 0 ? (uint32_t)((uint64_t)(drainedSamples - reportedDrainedSamples) * 60000 / elapsed) : 0;
+    const TelemetryQueueStats &queueStats = telemetryQueue.getStats();
+
+    char properties[192];
+    snprintf(properties, sizeof(properties),
+             "{\"telemetryQueue\":{\"depth\":%lu,\"capacity\":%lu,\"dropped\":%lu,\"drained\":%lu,\"drainRatePerMin\":%lu}}",
+             (unsigned long)telemetryQueue.getDepth(), (unsigned long)telemetryQueue.getCapacity(), (unsigned long)queueStats.dropped,
+             (unsigned long)drainedSamples, (unsigned long)drainRate);
+    if (IoTHubDeviceClient_LL_SendReportedState(_device_ll_handle, (const unsigned char *)properties, strlen(properties), NULL, NULL) == IOTHUB_CLIENT_OK) {
+        reportedDrainedSamples = drainedSamples;
+        reportedDrainTime = now;
+    }
+}
+
+// Aufgabe: Lichtsensor abtasten, Helligkeit nachführen und den Strom der Hintergrundbeleuchtung mitzählen
+void ambientLightTask() {
+    bool standby = !isDisplayingSensorValues && overlayScreen == OVERLAY_NONE && !timedScreen.isActive();
+    if (moistureSampler.isBusy()) {
+        return; // Der ADC gehört gerade dem Burst der Bodenfeuchte, nächste Abtastung abwarten
+    }
+    bool shared = micSampler.sharesAdc(WIO_LIGHT);
+    if (shared) {
+        micSampler.pause();
+    }
+    uint16_t light = analogRead(WIO_LIGHT);
+    if (shared) {
+        micSampler.resume();
+    }
+    if (ambientLight.update(light) && displaySleep.isAwake()) {
+        backLight.fadeTo(standby ? ambientLight.getStandbyBrightness() : ambientLight.getMainBrightness(), ambientFadeTime);
+    }
+    uint8_t percent = backLight.getBrightness() * 100 / backLight.getMaxBrightness();
+    backlightEnergy.update(millis(), percent, standby ? 20 : 100);
+}
+
+// Aufgabe: Jitter- und Overrun-Zähler aller Aufgaben ausgeben
+void statsTask() {
+    Serial.println("Aufgabe        Periode  Laeufe  Overruns  Ausgelassen  Jitter max  Laufzeit max");
+    for (size_t i = 0; i < scheduler.getTaskCount(); i++) {
+        const TaskStats &stats = scheduler.getStats(i);
+        Serial.printf("%-14s %7lu  %6lu  %8lu  %11lu  %7lu ms  %9lu ms\n",
+                      scheduler.getTaskName(i), (unsigned long)scheduler.getTaskPeriod(i),
+                      (unsigned long)stats.runs, (unsigned long)stats.overruns, (unsigned long)stats.skipped,
+                      (unsigned long)stats.maxJitter, (unsigned long)stats.maxRuntime);
+    }
+    const SectorLogStats &logStats = dataLog.getStats();
+    Serial.printf("SD-Log: %lu Datensaetze, %lu Schreibvorgaenge, %lu Sektoren, %lu verworfen, %lu wiederhergestellt, Dauer letzte %lu us / max %lu us / mittel %lu us\n",
+                  (unsigned long)logStats.recordsAppended, (unsigned long)logStats.flushes, (unsigned long)logStats.sectorsWritten,
+                  (unsigned long)logStats.recordsDropped, (unsigned long)logStats.recoveries, (unsigned long)logStats.lastFlushMicros, (unsigned long)logStats.maxFlushMicros,
+                  (unsigned long)(logStats.flushes > 0 ? logStats.totalFlushMicros / logStats.flushes : 0));
+    Serial.printf("Telemetrie: %u Messwerte gesammelt, %lu ueberschrieben\n",
+                  (unsigned)telemetryBatch.size(), (unsigned long)telemetryBatch.getOverwritten());
+    const TelemetryQueueStats &queueStats = telemetryQueue.getStats();
+    Serial.printf("Warteschlange: %lu/%lu Messwerte, %lu gespeichert, %lu nachgesendet, %lu verworfen, %lu beschaedigt, %lu wiederhergestellt, %lu Fehler\n",
+                  (unsigned long)telemetryQueue.getDepth(), (unsigned long)telemetryQueue.getCapacity(), (unsigned long)queueStats.pushed,
+                  (unsigned long)drainedSamples, (unsigned long)queueStats.dropped, (unsigned long)queueStats.corrupt,
+                  (unsigned long)queueStats.recoveries, (unsigned long)queueStats.errors);
+    Serial.printf("Anzeige: %lu Pixel/s (max %lu Pixel/s), gesamt %lu kPixel\n",
+                  (unsigned long)displayPixels.getRate(), (unsigned long)displayPixels.getMaxRate(), (unsigned long)(displayPixels.getTotal() / 1000));
+    const SpriteStats &spriteStats = getSunflowerStats();
+    Serial.printf("Sonnenblume: %lu gezeichnet, %lu unveraendert, %lu verschoben, Dauer letzte %lu us / max %lu us\n",
+                  (unsigned long)spriteStats.frames, (unsigned long)spriteStats.unchanged, (unsigned long)spriteStats.deferred,
+                  (unsigned long)spriteStats.lastDrawMicros, (unsigned long)spriteStats.maxDrawMicros);
+    const TftDmaStats &dmaStats = tftDma.getStats();
+    Serial.printf("Display-DMA: %lu Bereiche, %lu Kacheln, Dauer letzte %lu us / max %lu us, Befuellen %lu us, %lu mal gewartet\n",
+                  (unsigned long)dmaStats.regions, (unsigned long)dmaStats.tiles, (unsigned long)dmaStats.lastRegionMicros,
+                  (unsigned long)dmaStats.maxRegionMicros, (unsigned long)dmaStats.composeMicros, (unsigned long)dmaStats.finishWaits);
+    Serial.printf("Hintergrundbeleuchtung: Licht %u, Helligkeit %u/%u, %lu mAh/Tag (fest 100/20: %lu mAh/Tag)\n",
+                  (unsigned)ambientLight.getLight(), (unsigned)ambientLight.getMainBrightness(), (unsigned)ambientLight.getStandbyBrightness(),
+                  (unsigned long)backlightEnergy.getActualPerDay(), (unsigned long)backlightEnergy.getBaselinePerDay());
+    const MoistureSamplerStats &moistureStats = moistureSampler.getStats();
+    const MoistureFilter &moistureFilter = moistureSampler.getFilter();
+    Serial.printf("Bodenfeuchte: %u (Median %u, Rauschen %u.%u), %lu Bursts, Dauer %lu us, Filter %lu us, %lu uebersprungen\n",
+                  (unsigned)moistureFilter.getValue(), (unsigned)moistureFilter.getLastMedian(),
+                  (unsigned)(moistureFilter.getNoiseTenths() / 10), (unsigned)(moistureFilter.getNoiseTenths() % 10),
+                  (unsigned long)moistureStats.bursts, (unsigned long)moistureStats.lastBurstMicros,
+                  (unsigned long)moistureStats.filterMicros, (unsigned long)moistureStats.busySkips);
+    const WateringStats &wateringStats = watering.getStats();
+    Serial.printf("Bewaesserung: %s, %lu Gaben, %lu Schaltvorgaenge, %lu s gepumpt, heute %lu/%lu ms, %lu durch Budget beendet, %lu ohne Messwert beendet\n",
+                  WateringController::stateName(watering.getState()), (unsigned long)wateringStats.doses, (unsigned long)wateringStats.switches,
+                  (unsigned long)(wateringStats.totalOnTime / 1000), (unsigned long)watering.getBudgetUsed(millis()),
+                  (unsigned long)watering.getConfig().dailyBudget, (unsigned long)wateringStats.budgetStops, (unsigned long)wateringStats.staleStops);
+    const MicSamplerStats &micStats = micSampler.getStats();
+    const MicEnvelope &micEnvelope = micSampler.getEnvelope();
+    Serial.printf("Mikrofon: %lu Geraeusche, Pegel %lu, Grundrauschen %lu, %lu Fenster, %lu verworfen, %lu Pausen, Auswertung max %lu us\n",
+                  (unsigned long)micEnvelope.getEvents(), (unsigned long)micEnvelope.getRms(), (unsigned long)micEnvelope.getFloor(),
+                  (unsigned long)micStats.windows, (unsigned long)micStats.overruns, (unsigned long)micStats.pauses,
+                  (unsigned long)micStats.maxWindowMicros);
+    const DisplaySleepStats &sleepStats = displaySleep.getStats();
+    Serial.printf("Display-Schlaf: %lu mal eingeschlafen, %lu mal geweckt, %lu s geschlafen\n",
+                  (unsigned long)sleepStats.sleeps, (unsigned long)sleepStats.wakes, (unsigned long)(sleepStats.asleepMillis / 1000));
+    ButtonInputStats buttonStats = buttons.getStats();
+    Serial.printf("Tasten: %lu Flanken, %lu Entprell-Takte, %lu Ereignisse verworfen\n",
+                  (unsigned long)buttonStats.edges, (unsigned long)buttonStats.ticks, (unsigned long)buttons.getDropped());
+    Serial.printf("Schleifenrate: %lu/s (min %lu/s, max %lu/s)\n",
+                  (unsigned long)loopRate.getRate(), (unsigned long)loopRate.getMinRate(), (unsigned long)loopRate.getMaxRate());
+
+    // Laufzeiten seit dem letzten Bericht, danach neu zählen
+    char line[64];
+    Serial.println(Profiler::header());
+    for (size_t i = 0; i < profiler.getSectionCount(); i++) {
+        profiler.formatLine(line, sizeof(line), i);
+        Serial.println(line);
+    }
+    profiler.reset();
+}
+
+// Funktion zum Zeichnen der Debug-Anzeige mit den Laufzeiten seit dem letzten seriellen Bericht
+void renderDebugScreen() {
+    tftDma.finish();
+    char line[64];
+    uint32_t pixels = 0;
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextSize(1);
+    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.drawString("Profiler (C halten: zurueck)", 4, 4);
+    tft.setTextColor(TFT_WHITE, TFT_BLACK);
+    tft.drawString(Profiler::header(), 4, 20);
+    pixels += (tft.textWidth("Profiler (C halten: zurueck)") + tft.textWidth(Profiler::header())) * 8;
+    for (size_t i = 0; i < profiler.getSectionCount(); i++) {
+        profiler.formatLine(line, sizeof(line), i);
+        tft.drawString(line, 4, 34 + i * 12);
+        pixels += tft.textWidth(line) * 8;
+    }
+    displayPixels.add(pixels);
+}
+
+// Funktion zum Zeichnen des Verlaufsbildschirms: je Messwert eine Zeile mit 1 h, 24 h und 7 d
+void renderTrendScreen() {
+    static const char *titles[] = {"Pflanze F.", "Temperatur (C)", "Luft F. (%)"};
+    static const uint16_t colors[] = {TFT_CYAN, TFT_ORANGE, TFT_GREENYELLOW};
+    static const char *columns[] = {"1 h", "24 h", "7 d"};
+    static TrendPoint points[TrendHistory::MAX_POINTS];
+
+    tftDma.finish();
+    uint32_t pixels = 0;
+    tft.setTextSize(1);
+    tft.setTextDatum(TL_DATUM);
+    tft.setTextColor(TFT_YELLOW, TFT_BLACK);
+    tft.drawString("Verlauf (A halten: zurueck)", 4, 2);
+    tft.setTextDatum(TC_DATUM);
+    for (int column = 0; column < 3; column++) {
+        tft.drawString(columns[column], 54 + column * 106, 2);
+    }
+    tft.setTextDatum(TL_DATUM);
+    for (size_t channel = 0; channel < TREND_CHANNELS; channel++) {
+        int16_t top = 16 + channel * 74;
+        tft.setTextColor(colors[channel], TFT_BLACK);
+        tft.drawString(titles[channel], 4, top);
+        for (int column = 0; column < 3; column++) {
+            size_t count = trendHistory.snapshot(static_cast<TrendHistory::Range>(column), channel, points);
+            UiRect box(4 + column * 106, top + 12, 100, 58);
+            pixels += drawSparkline(tft, box, points, count, colors[channel], TFT_DARKGREY, TFT_BLACK);
+        }
+    }
+    trendRenderedRevision = trendHistory.getRevision();
+    displayPixels.add(pixels + 320 * 8 * 4); // Dazu die Kopfzeile und drei Zeilentitel, je höchstens eine Textzeile
+}
+
+// Funktion zum Ein- und Ausschalten einer Zusatzanzeige; ist sie bereits sichtbar, geht es zurück zum Hauptbildschirm
+void toggleOverlayScreen(OverlayScreen screen) {
+    if (overlayScreen == screen) {
+        overlayScreen = OVERLAY_NONE;
+        displayUpdateTime = millis();
+        mainScreen();
+        return;
+    }
+    overlayScreen = screen;
+    isDisplayingSensorValues = false;
+    timedScreen.cancel(); // Die Zusatzanzeige ersetzt eine noch sichtbare Meldung
+    clearScreen();
+    backLight.fadeTo(ambientLight.getMainBrightness(), backlightFadeInTime);
+    if (screen == OVERLAY_DEBUG) {
+        renderDebugScreen();
+    } else {
+        renderTrendScreen();
+    }
+}
+
+// Aufgabe: Nach Ablauf einer Meldung zum Hauptbildschirm zurückkehren
+void timedScreenTask() {
+    if (timedScreen.poll(millis()) != TimedScreen::NONE) {
+        displayUpdateTime = millis();
+        mainScreen();
+    }
+}
+
+// Aufgabe: Zusatzanzeige aktualisieren, solange sie sichtbar ist (der Verlauf nur nach einem abgeschlossenen Zeitraum)
+void overlayScreenTask() {
+    if (overlayScreen == OVERLAY_DEBUG) {
+        renderDebugScreen();
+    } else if (overlayScreen == OVERLAY_TREND && trendHistory.getRevision() != trendRenderedRevision) {
+        renderTrendScreen();
+    }
+}
+
+// Aufgabe beim Scheduler registrieren; ist kein Platz mehr frei, würde sie sonst nie ausgeführt
+void addTask(const char *name, Scheduler::TaskFunction function, unsigned long period, unsigned long deadline, uint8_t priority, unsigned long start) {
+    if (scheduler.addTask(name, function, period, deadline, priority, start) == Scheduler::INVALID_TASK) {
+        Serial.printf("Aufgabe %s nicht registriert, Scheduler voll (%u Plaetze)!\n", name, (unsigned)Scheduler::MAX_TASKS);
+    }
+}
+
+// Aufgaben beim Scheduler registrieren
+void setupTasks() {
+    unsigned long now = millis();
+    scheduler.setClock([]() -> uint32_t { return millis(); });
+    addTask("iothub", iotHubWorkTask, IoTHubWorkInterval, IoTHubWorkInterval * 5, 3, now);
+    addTask("erfassung", acquisitionTask, sensorInterval, 0, 4, now);
+    addTask("dht", dhtTask, dhtPollInterval, 0, 4, now);
+    addTask("sensoren", sensorTask, sensorInterval, 0, 2, now + dhtSettleTime);
+    addTask("tele-sammeln", telemetrySampleTask, sensorInterval, 0, 1, now + dhtSettleTime);
+    addTask("telemetrie", telemetryTask, telemetryCheckInterval, 0, 2, now);
+    addTask("nachsenden", telemetryDrainTask, telemetryDrainInterval, 0, 1, now);
+    addTask("verbindung", connectionTask, connectionCheckInterval, 0, 0, now + connectionCheckInterval);
+    addTask("eigenschaften", queuePropertiesTask, statsInterval, 0, 0, now + statsInterval);
+    addTask("uhrzeit", timeDisplayTask, timeInterval, 0, 1, now);
+    addTask("sd-log", loggingTask, sensorInterval, 0, 1, now + dhtSettleTime);
+    addTask("sd-flush", logFlushTask, logFlushInterval, 0, 0, now);
+    addTask("standby", standbyTask, sensorInterval, 0, 0, now);
+    addTask("statistik", statsTask, statsInterval, 0, 0, now + statsInterval);
+    addTask("zusatzanzeige", overlayScreenTask, overlayScreenInterval, 0, 0, now);
+    addTask("umgebungslicht", ambientLightTask, ambientLightInterval, 0, 0, now);
+    addTask("bewaesserung", wateringTask, wateringInterval, 0, 2, now + dhtSettleTime);
+    addTask("meldung", timedScreenTask, timedScreenInterval, 0, 1, now);
 }
 
 // Setup Funktion beim Starten des Wio Terminals
 void setup() {
+    Profiler::begin(); // Zykluszähler für die Laufzeitmessung starten
     Serial.begin(115200); // Serial Monitor starten
     Serial1.begin(9600); // Serial Monitor GPS
-    pinMode(WIO_KEY_A, INPUT_PULLUP); // Taste A 
-    pinMode(WIO_KEY_B, INPUT_PULLUP); // Taste B 
-    pinMode(WIO_KEY_C, INPUT_PULLUP); // Taste C 
+    ButtonTiming keyTiming;
+    keyTiming.longPressTime = keyHoldTime;
+    buttons.begin(keyPins, KEY_INDEX_COUNT, keyTiming); // Tasten A, B und C mit Pull-up und Flanken-Interrupt
     pinMode(MOISTURE_PIN, INPUT); // Feuchtigkeitssensor als Eingang konfigurieren
     pinMode(RELAY_PIN, OUTPUT); // Relais-Pin als Ausgang konfigurieren
     pinMode(WIO_MIC, INPUT); // Mikrofon als Eingang festlegen
+    if (!micSampler.begin(WIO_MIC)) {
+        Serial.println("Mikrofon kann nicht im Hintergrund abgetastet werden, es wird einzeln gemessen.");
+    }
+    pinMode(WIO_LIGHT, INPUT); // Lichtsensor als Eingang festlegen
+    if (!moistureSampler.begin(MOISTURE_PIN)) {
+        Serial.println("Kein DMA-Kanal fuer den Feuchtigkeitssensor, es wird einzeln gemessen.");
+    }
     digitalWrite(PIN_WIRE_SCL, LOW); // Relais im Default-Zustand auf LOW setzen (ausgeschaltet)
-    plantMode = 1; // Pflanzmodus auf Standardwert setzen
+    setPlantMode(1); // Pflanzmodus auf Standardwert setzen
     
     // Display initialisieren
     tft.begin();
     tft.setRotation(3); // Querformat
     tft.fillScreen(TFT_BLACK); // Hintergrundfarbe auf Schwarz setzen
+    if (!buildGlyphAtlas(glyphAtlas, tft)) {
+        Serial.println("Glyphen-Atlas konnte nicht erstellt werden!");
+    }
+    if (!tftDma.begin(tft)) {
+        Serial.println("Kein DMA-Kanal fuer das Display, Sprites werden blockierend gezeichnet.");
+    }
 
     // DHT-Sensor initialisieren
-    dht.begin();
+    dht.begin(onDhtResult);
     
     // RTC initialisieren
     if (!rtc.begin()) {
@@ -444,6 +1181,12 @@ void setup() {
     } else {
         Serial.println("VL53L0X Sensor initialisiert.");
     }
+#ifndef PRESENCE_SINGLE_SHOT
+    // Dauermessbetrieb starten, die Messwerte werden in loop() nur noch abgeholt
+    if (!presence.begin(rangingInterval)) {
+        Serial.println("VL53L0X Dauermessbetrieb konnte nicht gestartet werden.");
+    }
+#endif
 
     // Hintergrundbeleuchtung initialisieren
     backLight.initialize();
@@ -455,20 +1198,17 @@ void setup() {
     }
     Serial.println("SD-Karte erfolgreich initialisiert!");
 
-    // CSV-Datei erstellen/öffnen und Kopfzeilen schreiben
-    if (!SD.exists("sensors.csv")) {
-        // Datei existiert nicht, neu erstellen und Header schreiben
-        dataFile = SD.open("sensors.csv", FILE_WRITE);
-        if (dataFile) {
-            dataFile.println("Zeit,Feuchtigkeit_Pflanze,Temperatur,Luftfeuchtigkeit");
-            dataFile.close();
-            Serial.println("Kopfzeile in CSV-Datei geschrieben.");
-        } else {
-            Serial.println("Konnte CSV-Datei nicht erstellen!");
-            while (1);
-        }
-    } else {
-        Serial.println("CSV-Datei existiert bereits, kein Header geschrieben.");
+    // Logverzeichnis anlegen; die Datei des jeweiligen Tages wird beim ersten Datensatz geöffnet bzw. rotiert
+    if (!dataLog.begin("/logs", logPartitionSpan)) {
+        Serial.println("Konnte Logverzeichnis nicht erstellen!");
+        while (1);
+    }
+
+    // Warteschlange für nicht gesendete Telemetrie öffnen; ohne sie wird nur live gesendet
+    if (!telemetryQueue.begin("/TELEMQ.DAT")) {
+        Serial.println("Telemetrie-Warteschlange konnte nicht geoeffnet werden!");
+    } else if (!telemetryQueue.isEmpty()) {
+        Serial.printf("Telemetrie-Warteschlange: %lu Messwerte warten auf das Nachsenden\n", (unsigned long)telemetryQueue.getDepth());
     }
     
     // WLAN initialisieren
@@ -477,15 +1217,22 @@ void setup() {
     initTime();
     // Iot Hub Verbindung initialisieren
     connectIoTHub();
-    delay(2000);
-    tft.fillScreen(TFT_BLACK); // Bildschirm erneut leeren für Sensoranzeige
-    // Hauptbildschirm laden
-    mainScreen();
+    // Erste Messung für den Hauptbildschirm
+    acquireSensors();
+    while (dht.isBusy()) {
+        dht.poll(millis());
+    }
+    // Hauptbildschirm zusammenstellen; gezeichnet wird er nach Ablauf der WLAN-Meldung von timedScreenTask()
+    setupMainScreen();
+    // Periodische Aufgaben registrieren
+    setupTasks();
+    reportedDrainTime = millis();
 }
 
 // Funktion für die Pflanzen Modis bzw. Anzeige bei Modi-Wechsel
 void displayModeInfo() {
-    tft.fillScreen(TFT_BLACK);
+    overlayScreen = OVERLAY_NONE;
+    clearScreen();
     tft.setTextDatum(MC_DATUM);
     tft.setTextColor(TFT_WHITE);
     tft.setTextSize(3);
@@ -501,162 +1248,110 @@ void displayModeInfo() {
     }
     tft.drawString(modeText1, 160, 110);
     tft.drawString(modeText2, 160, 140);
-    delay(1000);
-    mainScreen();
+    isDisplayingSensorValues = false; // Bis zum Ablauf der Meldung keine Messwerte darüber zeichnen
+    timedScreen.show(SCREEN_MODE_INFO, millis(), modeInfoTime);
+}
+
+// Funktion zum Abarbeiten der Tastenereignisse; wartet nie, mehrere Moduswechsel ergeben nur eine Anzeige
+void handleButtons(unsigned long now) {
+    int requestedMode = 0;
+    ButtonEvent event;
+    while (buttons.pop(event)) {
+        uint8_t bit = 1 << event.button;
+        // Schläft das Display, weckt eine Taste es nur; bis zum Loslassen löst sie nichts aus
+        if (event.gesture == BUTTON_DOWN && !displaySleep.isAwake()) {
+            displaySleep.wake(now);
+            wakeKeys |= bit;
+        }
+        if (wakeKeys & bit) {
+            if (event.gesture == BUTTON_UP) {
+                wakeKeys &= ~bit;
+            }
+            continue;
+        }
+        if (!displaySleep.isAwake()) {
+            continue;
+        }
+        switch (event.button) {
+        case KEY_INDEX_A: // Kurz gedrückt -> Modus 1, 2 Sekunden gehalten -> Verlauf ein bzw. aus
+            if (event.gesture == BUTTON_SHORT) {
+                requestedMode = 1;
+            } else if (event.gesture == BUTTON_LONG) {
+                toggleOverlayScreen(OVERLAY_TREND);
+            }
+            break;
+        case KEY_INDEX_B: // Gedrückt -> Modus 2
+            if (event.gesture == BUTTON_DOWN) {
+                requestedMode = 2;
+            }
+            break;
+        case KEY_INDEX_C: // Kurz gedrückt -> Modus 3, 2 Sekunden gehalten -> Debug-Anzeige ein bzw. aus
+            if (event.gesture == BUTTON_SHORT) {
+                requestedMode = 3;
+            } else if (event.gesture == BUTTON_LONG) {
+                toggleOverlayScreen(OVERLAY_DEBUG);
+            }
+            break;
+        }
+    }
+    if (requestedMode != 0) {
+        setPlantMode(requestedMode);
+        displayModeInfo();
+    }
 }
 
 // Loop Funktion wird laufend ausgeführt und liest Werte bzw. für Aktionen aus
 void loop() {
     
     // Variablen definieren
+    ProfileScope loopScope(profiler, profLoop);
     unsigned long currentMillis = millis(); // Aktuelle Zeit in Millisekunden
-    uint16_t distance = lox.readRange(); // Distance lesen
-    int micValue = analogRead(WIO_MIC); // Mikrofonwert lesen
-
-    // Knopf A gedrückt -> Modus 1
-    if (digitalRead(WIO_KEY_A) == LOW) {
-        plantMode = 1;
-        displayModeInfo();
-        firstMainScreen = true;
-        mainScreen();
+    loopRate.tick(currentMillis);
+    displayPixels.update(currentMillis);
+    {
+        ProfileScope scope(profiler, profDisplayDma);
+        tftDma.poll(); // Frei gewordenen Kachelpuffer befüllen, der DMA-Interrupt startet ihn direkt nach dem vorigen
     }
-
-    // Knopf B gedrückt -> Modus 2
-    if (digitalRead(WIO_KEY_B) == LOW) {
-        plantMode = 2;
-        displayModeInfo();
-        firstMainScreen = true;
-        mainScreen();
+    displaySleep.poll(currentMillis); // Nach dem Ausblenden Sleep-In senden
+    PresenceEvent presenceEvent;
+    {
+        ProfileScope scope(profiler, profPresence);
+#ifdef PRESENCE_SINGLE_SHOT
+        presenceEvent = presence.pollSingleShot(); // Vergleichsmessung: blockierende Einzelmessung
+#else
+        presenceEvent = presence.poll(); // Fertige Messung abholen, falls vorhanden
+#endif
     }
-
-    // Knopf C gedrückt -> Modus 3
-    if (digitalRead(WIO_KEY_C) == LOW) {
-        plantMode = 3;
-        displayModeInfo();
-        firstMainScreen = true;
-        mainScreen();
+    pollMoistureSampler();
+    bool soundEvent = false;
+    if (micSampler.isReady()) {
+        micSampler.poll(); // Volle Fenster auswerten, ein Geräusch wird als Ereignis gemeldet
+        soundEvent = micSampler.takeEvent();
+    } else if (!moistureSampler.isBusy()) {
+        soundEvent = analogRead(WIO_MIC) > 650; // Ohne Timer und DMA: einzelner Mikrofonwert
     }
 
-    // Main-Screen und Standby-Screen Anzeige
-    if (distance <= DIST_THRESHOLD || micValue > 650) {
-        if (!isDisplayingSensorValues) {
+    handleButtons(currentMillis); // Tastenereignisse aus dem Interrupt abarbeiten
+
+    // Main-Screen und Standby-Screen Anzeige (nicht während der Debug-Anzeige)
+    if (presenceEvent == PRESENCE_LEFT) {
+        displayUpdateTime = currentMillis; // Timeout ab dem Weggehen der Person zählen
+    }
+    if (overlayScreen != OVERLAY_NONE || timedScreen.isActive()) {
+        // Zusatzanzeige bleibt, bis die Taste erneut gehalten wird; eine Meldung bis zum Ablauf ihrer Zeit
+    } else if (presenceEvent == PRESENCE_APPROACHED || soundEvent || displaySleep.isWaking()) {
+        // Aus dem Sleep-Modus erst zeichnen, wenn das Display wieder Befehle annimmt
+        if (!isDisplayingSensorValues && displaySleep.wake(currentMillis)) {
             displayUpdateTime = currentMillis;  // Timer starten, wenn der Abstand oder Mikrowert unter bzw. über der Schwelle liegt
-            isDisplayingSensorValues = true;
-            firstMainScreen = true;
-            mainScreen(); // Hauptbildschirm anzeigen
+            mainScreen(); // Hauptbildschirm anzeigen (setzt isDisplayingSensorValues, vorher wird die Sonnenblume gelöscht)
         }
     } else {
-        if (isDisplayingSensorValues && currentMillis - displayUpdateTime >= displayTimeout) {
+        if (isDisplayingSensorValues && !presence.isPresent() && currentMillis - displayUpdateTime >= displayTimeout) {
             showStandbyScreen(); // Standby-Bildschirm anzeigen
             isDisplayingSensorValues = false;
-            firstMainScreen = false;
-        }
-    }
-
-    // Relai 
-    if (!isDisplayingSensorValues && currentMillis - previousSensorUpdate >= sensorInterval) {
-        previousSensorUpdate = currentMillis;
-        int moistureValue = analogRead(MOISTURE_PIN);
-        controlRelayBasedOnMoisture(moistureValue);
-    }
-
-    // Uhrzeit jede Sekunde aktualisieren
-    if (isDisplayingSensorValues && currentMillis - previousTimeUpdate >= timeInterval) {
-        previousTimeUpdate = currentMillis;
-        updateTimeDisplay();
-    }
-
-    // Sensorwerte alle 4 Sekunden aktualisieren
-    if (isDisplayingSensorValues && currentMillis - previousSensorUpdate >= sensorInterval) {
-        previousSensorUpdate = currentMillis;
-        firstMainScreen = false;
-        int moistureValue = analogRead(MOISTURE_PIN);
-        float temperature = dht.readTemperature();
-        float humidity = dht.readHumidity();
-
-        if (!isnan(temperature) && !isnan(humidity)) {
-            updateSensorData(moistureValue, temperature, humidity);
-            controlRelayBasedOnMoisture(moistureValue);
-        } else {
-            Serial.println("Fehler beim Lesen eines Sensors!");
-        }
-    }
-
-    // Standby Screen
-    if (!isDisplayingSensorValues && currentMillis - previousFlowerUpdate >= sensorInterval) {
-        previousFlowerUpdate = currentMillis;
-
-        int moistureValue = analogRead(MOISTURE_PIN);
-        uint16_t faceColor = TFT_DARKORANGE;
-        MoistureThreshold currentThreshold = thresholds[plantMode - 1];
-
-        if (moistureValue > currentThreshold.high) { // In Ordnung
-            drawSunflower("happy", faceColor);
-        } else if (moistureValue > currentThreshold.low) { // Bald gießen
-            drawSunflower("neutral", faceColor);
-        } else { // Sofort gießen
-            drawSunflower("sad", faceColor);
         }
     }
 
-    // Daten auf SD Karte schreiben alle 4 Sekunden
-    if (currentMillis - previousSensorUpdate >= sensorInterval) {
-        previousSensorUpdate = currentMillis;
-
-        int moistureValue = analogRead(MOISTURE_PIN);
-        float temperature = dht.readTemperature();
-        float humidity = dht.readHumidity();
-
-        if (!isnan(temperature) && !isnan(humidity)) {
-            logDataToCSV(moistureValue, temperature, humidity);
-        } else {
-            Serial.println("Fehler beim Lesen eines Sensors!");
-        }
-    }
-    
-    // IoT Hub
-    if (currentMillis - previousIoTHubUpdate >= IoTHubTimeout) {
-        previousIoTHubUpdate = currentMillis;
-
-        while (Serial1.available() > 0)
-        {
-            char c = Serial1.read(); // Zeichen vom GPS-Modul lesen
-            gps.encode(c); // GPS-Daten verarbeiten
-        }
-
-        // Standardwert: FH Joanneum 
-        double latitude = 47.06895;
-        double longitude = 15.40643;
-
-        if (gps.location.isValid())
-        {
-            latitude = gps.location.lat();
-            longitude = gps.location.lng();
-        }
-
-        // Sensordaten abrufen
-        int moistureValue = analogRead(MOISTURE_PIN);
-        float temperature = dht.readTemperature();
-        float humidity = dht.readHumidity();
-
-        // JSON dokument mit Daten erstellen
-        DynamicJsonDocument doc(1024);
-        doc["deviceId"] = "Wio";
-        doc["temperature"] = temperature;
-        doc["humidity"] = humidity;
-        doc["moisture"] = moistureValue;
-        doc["latitude"] = latitude;
-        doc["longitude"] = longitude;
-        
-        // Daten als String
-        String telemetry;
-        serializeJson(doc, telemetry);
-
-        // Daten an Iot Hub senden
-        Serial.print("Sending telemetry: ");
-        Serial.println(telemetry.c_str());
-        sendTelemetry(telemetry.c_str());
-           
-    }
-    IoTHubDeviceClient_LL_DoWork(_device_ll_handle); 
-}
\ No newline at end of file
+    // Fällige Aufgaben ausführen
+    scheduler.run(millis());
+}
@@ -0,0 +1,367 @@
+// Geräuscherkennung am Mikrofon: Hüllkurve über kurze Fenster mit nachgeführtem Grundrauschen, Abtastung per Timer und DMA
+/**
+ * @file mic_activity.hpp
+*/
+
+#ifndef MIC_ACTIVITY_HPP__
+#define MIC_ACTIVITY_HPP__
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Ganzzahlige Quadratwurzel (abgerundet)
+ */
+inline std::uint32_t micIsqrt(std::uint32_t value)
+{
+    std::uint32_t result = 0;
+    std::uint32_t bit = 1UL << 30;
+    while (bit > value) bit >>= 2;
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return result;
+}
+
+/**
+ * @brief Hüllkurve und Schwelle für Geräusche
+ *
+ * Pro Fenster wird der Gleichanteil (gleitend über viele Fenster) abgezogen und der Effektivwert
+ * gebildet. Das Grundrauschen folgt leiseren Fenstern schnell und lauteren nur sehr langsam, so
+ * passt sich die Schwelle an Lüfter oder Straßenlärm an, ohne Sprache "wegzulernen". Geräusch liegt
+ * vor, wenn der Effektivwert das Grundrauschen um den Faktor ACTIVITY_RATIO und mindestens um
+ * ACTIVITY_MARGIN übersteigt; es gilt noch HOLD_WINDOWS Fenster nach dem letzten lauten Fenster.
+ */
+class MicEnvelope
+{
+public:
+    static const std::uint32_t ACTIVITY_RATIO = 3;    // Effektivwert / Grundrauschen
+    static const std::uint32_t ACTIVITY_MARGIN = 24;  // ADC-Schritte (12 Bit) über dem Grundrauschen
+    static const std::uint32_t HOLD_WINDOWS = 12;     // Nachlauf in Fenstern
+    static const std::uint32_t MIN_FLOOR = 4;         // Untergrenze des Grundrauschens in ADC-Schritten
+
+private:
+    std::int32_t dc = -1;          // Gleichanteil, skaliert mit 16 (-1 = noch nicht bestimmt)
+    std::uint32_t floor = 0;       // Grundrauschen, skaliert mit 256
+    std::uint32_t rms = 0;
+    std::uint32_t peak = 0;
+    std::uint32_t hold = 0;
+    bool active = false;
+    std::uint32_t events = 0;      // Übergänge ruhig -> Geräusch
+    bool pendingEvent = false;
+
+public:
+    /**
+     * @brief Verarbeitet ein Fenster von 12-Bit-Werten.
+     * @return true, wenn mit diesem Fenster ein Geräusch beginnt
+     */
+    bool addWindow(const std::uint16_t *samples, std::size_t count)
+    {
+        if (count == 0) return false;
+        std::uint32_t sum = 0;
+        for (std::size_t i = 0; i < count; i++) sum += samples[i];
+        std::int32_t mean = static_cast<std::int32_t>(sum / count);
+        bool first = dc < 0;
+        if (first) {
+            dc = mean * 16;
+        } else {
+            dc += (mean * 16 - dc) / 32;
+        }
+        std::int32_t offset = dc / 16;
+
+        std::uint64_t squares = 0;
+        std::uint32_t windowPeak = 0;
+        for (std::size_t i = 0; i < count; i++) {
+            std::int32_t v = static_cast<std::int32_t>(samples[i]) - offset;
+            std::uint32_t magnitude = static_cast<std::uint32_t>(v < 0 ? -v : v);
+            squares += static_cast<std::uint64_t>(magnitude) * magnitude;
+            if (magnitude > windowPeak) windowPeak = magnitude;
+        }
+        rms = micIsqrt(static_cast<std::uint32_t>(squares / count));
+        peak = windowPeak;
+        if (first) {
+            // Das erste Fenster gilt als Grundrauschen, sonst löst ein Lüfter beim Einschalten aus
+            floor = (rms > MIN_FLOOR ? rms : MIN_FLOOR) * 256;
+            return false;
+        }
+
+        std::uint32_t level = getFloor();
+        bool loud = rms > level * ACTIVITY_RATIO && rms > level + ACTIVITY_MARGIN;
+        // Leiser: schnell folgen; lauter: langsam folgen (nach einigen Sekunden gleichbleibender Lautstärke
+        // gilt sie als neues Grundrauschen, ein kurzes Geräusch hebt es kaum an)
+        std::uint32_t target = rms * 256;
+        if (target < floor) {
+            floor -= (floor - target) / 8;
+        } else {
+            floor += (target - floor) / 512;
+        }
+        if (floor < MIN_FLOOR * 256) floor = MIN_FLOOR * 256;
+
+        bool started = false;
+        if (loud) {
+            if (!active) {
+                started = true;
+                events++;
+                pendingEvent = true;
+            }
+            active = true;
+            hold = HOLD_WINDOWS;
+        } else if (hold > 0) {
+            hold--;
+        } else {
+            active = false;
+        }
+        return started;
+    }
+
+    /**
+     * @brief Holt ein noch nicht abgeholtes Geräusch ab (jedes Geräusch genau einmal).
+     */
+    bool takeEvent()
+    {
+        bool event = pendingEvent;
+        pendingEvent = false;
+        return event;
+    }
+
+    bool isActive() const { return active; }
+    std::uint32_t getRms() const { return rms; }
+    std::uint32_t getPeak() const { return peak; }
+    std::uint32_t getFloor() const { return (floor + 128) / 256; }
+    std::uint32_t getEvents() const { return events; }
+};
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <Adafruit_ZeroDMA.h>
+#include <wiring_private.h>
+
+// Timer und Ereigniskanal für den Abtasttakt (TC0 und Ereigniskanal 0 belegt die Hintergrundbeleuchtung)
+#ifndef MIC_SAMPLER_TC
+#define MIC_SAMPLER_TC TC2
+#define MIC_SAMPLER_TC_GCLK_ID TC2_GCLK_ID
+#define MIC_SAMPLER_TC_APBBMASK MCLK_APBBMASK_TC2
+#define MIC_SAMPLER_TC_EVENT EVSYS_ID_GEN_TC2_OVF
+#define MIC_SAMPLER_EVSYS_CHANNEL 1
+#endif
+
+/**
+ * @brief Zähler des Mikrofon-Samplers
+ */
+struct MicSamplerStats {
+    std::uint32_t windows = 0;        // Ausgewertete Fenster
+    std::uint32_t overruns = 0;       // Fenster, die poll() zu spät gesehen hat und verworfen wurden
+    std::uint32_t pauses = 0;         // pause() für andere Messungen am selben ADC
+    std::uint32_t maxWindowMicros = 0; // Längste Auswertung eines Fensters
+};
+
+/**
+ * @brief Tastet das Mikrofon mit SAMPLE_RATE im Hintergrund ab
+ *
+ * Ein Timer-Überlauf startet über das Event-System jede Wandlung, die DMA schreibt die Ergebnisse
+ * abwechselnd in zwei Fensterpuffer und meldet jedes volle Fenster. poll() aus loop() wertet volle
+ * Fenster mit MicEnvelope aus; die CPU rechnet also einmal pro Fenster statt pro Wert.
+ *
+ * Der Sampler belegt seinen ADC dauerhaft. Andere Messungen am selben ADC (sharesAdc()) müssen ihn
+ * mit pause() anhalten und danach mit resume() fortsetzen.
+ */
+class MicSampler
+{
+public:
+    static const std::uint32_t SAMPLE_RATE = 8000;   // Hz
+    static const std::size_t WINDOW_SAMPLES = 128;   // 16 ms pro Fenster
+
+private:
+    Adafruit_ZeroDMA dma;
+    DmacDescriptor *descriptors[2] = {nullptr, nullptr};
+    Adc *adc = nullptr;
+    std::uint8_t channel = 0;
+    bool alternate = false;
+    std::uint16_t windows[2][WINDOW_SAMPLES];
+    std::uint32_t processed = 0;
+    MicEnvelope envelope;
+    bool ready = false;
+    bool running = false;
+    // Register, die analogRead() voraussetzt
+    std::uint16_t savedInputCtrl = 0;
+    std::uint16_t savedCtrlB = 0;
+    std::uint8_t savedAvgCtrl = 0;
+    MicSamplerStats stats;
+
+    // Wird im DMA-Interrupt pro vollem Fenster erhöht; es gibt nur ein Mikrofon
+    static volatile std::uint32_t &completedWindows()
+    {
+        static volatile std::uint32_t count = 0;
+        return count;
+    }
+
+    static void onWindowComplete(Adafruit_ZeroDMA *) { completedWindows() = completedWindows() + 1; }
+
+    void setAdcEnabled(bool enabled)
+    {
+        adc->CTRLA.bit.ENABLE = enabled ? 1 : 0;
+        while (adc->SYNCBUSY.bit.ENABLE);
+    }
+
+    void setTimerEnabled(bool enabled)
+    {
+        MIC_SAMPLER_TC->COUNT16.CTRLA.bit.ENABLE = enabled ? 1 : 0;
+        while (MIC_SAMPLER_TC->COUNT16.SYNCBUSY.bit.ENABLE);
+    }
+
+    void startSampling()
+    {
+        setAdcEnabled(false);
+        savedInputCtrl = adc->INPUTCTRL.reg;
+        savedCtrlB = adc->CTRLB.reg;
+        savedAvgCtrl = adc->AVGCTRL.reg;
+        adc->INPUTCTRL.reg = ADC_INPUTCTRL_MUXPOS(channel) | ADC_INPUTCTRL_MUXNEG_GND;
+        adc->AVGCTRL.reg = ADC_AVGCTRL_SAMPLENUM_1;
+        adc->CTRLB.reg = ADC_CTRLB_RESSEL_12BIT;
+        adc->EVCTRL.reg = ADC_EVCTRL_STARTEI;
+        while (adc->SYNCBUSY.reg & (ADC_SYNCBUSY_INPUTCTRL | ADC_SYNCBUSY_AVGCTRL | ADC_SYNCBUSY_CTRLB));
+
+        completedWindows() = 0;
+        processed = 0;
+        dma.startJob();
+        setAdcEnabled(true);
+        setTimerEnabled(true);
+        running = true;
+    }
+
+    void stopSampling()
+    {
+        setTimerEnabled(false);
+        // Eine bereits gestartete Wandlung abwarten, sonst holt die DMA sie nach dem Abbruch nicht mehr ab
+        while (adc->STATUS.bit.ADCBUSY);
+        dma.abort();
+        setAdcEnabled(false);
+        adc->EVCTRL.reg = 0;
+        adc->CTRLB.reg = savedCtrlB;
+        adc->AVGCTRL.reg = savedAvgCtrl;
+        adc->INPUTCTRL.reg = savedInputCtrl;
+        while (adc->SYNCBUSY.reg & (ADC_SYNCBUSY_INPUTCTRL | ADC_SYNCBUSY_AVGCTRL | ADC_SYNCBUSY_CTRLB));
+        adc->INTFLAG.reg = ADC_INTFLAG_RESRDY;
+        running = false;
+    }
+
+public:
+    /**
+     * @brief Richtet Timer, Event-System und DMA ein und startet die Abtastung.
+     * @return false, wenn der Pin kein Analogeingang oder kein DMA-Kanal frei ist
+     */
+    bool begin(std::uint32_t pin)
+    {
+        const PinDescription &description = g_APinDescription[pin];
+        if (description.ulADCChannelNumber == No_ADC_Channel) {
+            return false;
+        }
+        alternate = (description.ulPinAttribute & PIN_ATTR_ANALOG_ALT) != 0;
+        adc = alternate ? ADC1 : ADC0;
+        channel = static_cast<std::uint8_t>(description.ulADCChannelNumber);
+        pinPeripheral(pin, alternate ? PIO_ANALOG_ALT : PIO_ANALOG);
+
+        if (dma.allocate() != DMA_STATUS_OK) {
+            return false;
+        }
+        dma.setTrigger(alternate ? ADC1_DMAC_ID_RESRDY : ADC0_DMAC_ID_RESRDY);
+        dma.setAction(DMA_TRIGGER_ACTON_BEAT);
+        for (int i = 0; i < 2; i++) {
+            descriptors[i] = dma.addDescriptor((void *)&adc->RESULT.reg, windows[i], WINDOW_SAMPLES, DMA_BEAT_SIZE_HWORD, false, true);
+            if (descriptors[i] == nullptr) {
+                return false;
+            }
+            // Interrupt nach jedem Fenster, nicht erst am Ende der Kette
+            descriptors[i]->BTCTRL.bit.BLOCKACT = DMA_BLOCK_ACTION_INT;
+        }
+        dma.loop(true);
+        dma.setCallback(onWindowComplete);
+
+        // Timer: GCLK1 (48 MHz), Überlauf mit SAMPLE_RATE erzeugt ein Ereignis
+        MCLK->APBBMASK.reg |= MIC_SAMPLER_TC_APBBMASK | MCLK_APBBMASK_EVSYS;
+        GCLK->PCHCTRL[MIC_SAMPLER_TC_GCLK_ID].reg = GCLK_PCHCTRL_GEN_GCLK1 | GCLK_PCHCTRL_CHEN;
+        while (!(GCLK->PCHCTRL[MIC_SAMPLER_TC_GCLK_ID].reg & GCLK_PCHCTRL_CHEN));
+        MIC_SAMPLER_TC->COUNT16.CTRLA.bit.SWRST = 1;
+        while (MIC_SAMPLER_TC->COUNT16.SYNCBUSY.bit.SWRST);
+        MIC_SAMPLER_TC->COUNT16.CTRLA.reg = TC_CTRLA_MODE_COUNT16 | TC_CTRLA_PRESCALER_DIV1;
+        MIC_SAMPLER_TC->COUNT16.WAVE.reg = TC_WAVE_WAVEGEN_MFRQ;
+        MIC_SAMPLER_TC->COUNT16.CC[0].reg = 48000000UL / SAMPLE_RATE - 1;
+        while (MIC_SAMPLER_TC->COUNT16.SYNCBUSY.bit.CC0);
+        MIC_SAMPLER_TC->COUNT16.EVCTRL.reg = TC_EVCTRL_OVFEO;
+
+        EVSYS->USER[alternate ? EVSYS_ID_USER_ADC1_START : EVSYS_ID_USER_ADC0_START].reg = MIC_SAMPLER_EVSYS_CHANNEL + 1;
+        EVSYS->Channel[MIC_SAMPLER_EVSYS_CHANNEL].CHANNEL.reg = EVSYS_CHANNEL_EVGEN(MIC_SAMPLER_TC_EVENT) |
+                                                                EVSYS_CHANNEL_PATH_ASYNCHRONOUS | EVSYS_CHANNEL_EDGSEL_NO_EVT_OUTPUT;
+
+        ready = true;
+        startSampling();
+        return true;
+    }
+
+    /**
+     * @brief Wertet volle Fenster aus; aus loop() aufrufen.
+     * @return true, wenn ein Geräusch begonnen hat
+     */
+    bool poll()
+    {
+        if (!running) {
+            return false;
+        }
+        std::uint32_t completed = completedWindows();
+        if (completed - processed > 1) {
+            // Mehr als ein Fenster im Rückstand: der ältere Puffer wird schon wieder überschrieben
+            stats.overruns += completed - processed - 1;
+            processed = completed - 1;
+        }
+        bool started = false;
+        while (processed != completed) {
+            std::uint32_t start = micros();
+            started |= envelope.addWindow(windows[processed % 2], WINDOW_SAMPLES);
+            std::uint32_t duration = micros() - start;
+            if (duration > stats.maxWindowMicros) stats.maxWindowMicros = duration;
+            stats.windows++;
+            processed++;
+        }
+        return started;
+    }
+
+    /**
+     * @brief true, wenn pin am selben ADC hängt und analogRead() dafür pause() erfordert
+     */
+    bool sharesAdc(std::uint32_t pin) const
+    {
+        return ready && ((g_APinDescription[pin].ulPinAttribute & PIN_ATTR_ANALOG_ALT) != 0) == alternate;
+    }
+
+    /**
+     * @brief Hält die Abtastung an und stellt die ADC-Register für analogRead() wieder her.
+     */
+    void pause()
+    {
+        if (running) {
+            stopSampling();
+            stats.pauses++;
+        }
+    }
+
+    void resume()
+    {
+        if (ready && !running) {
+            startSampling();
+        }
+    }
+
+    bool isReady() const { return ready; }
+    bool takeEvent() { return envelope.takeEvent(); }
+    const MicEnvelope &getEnvelope() const { return envelope; }
+    const MicSamplerStats &getStats() const { return stats; }
+};
+#endif // ARDUINO
+
+#endif //MIC_ACTIVITY_HPP__
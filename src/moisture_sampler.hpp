@@ -0,0 +1,240 @@
+// Bodenfeuchte: ADC-Bursts per DMA mit Hardware-Mittelung, Median und gleitendem Mittel samt Rauschschätzung
+/**
+ * @file moisture_sampler.hpp
+*/
+
+#ifndef MOISTURE_SAMPLER_HPP__
+#define MOISTURE_SAMPLER_HPP__
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Median von count Werten; values wird dabei sortiert (Einfügesortieren, für kurze Bursts)
+ */
+inline std::uint16_t moistureMedian(std::uint16_t *values, std::size_t count)
+{
+    if (count == 0) return 0;
+    for (std::size_t i = 1; i < count; i++) {
+        std::uint16_t value = values[i];
+        std::size_t j = i;
+        while (j > 0 && values[j - 1] > value) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+    return values[count / 2];
+}
+
+/**
+ * @brief Robuste Filterung der Bursts: Median je Burst, darüber ein gleitendes Mittel (Gewicht 1/4)
+ *
+ * Der Median verwirft einzelne Ausreißer eines Bursts vollständig, das gleitende Mittel glättet das
+ * verbleibende Rauschen über mehrere Bursts. Als Rauschen wird der Median der absoluten Abweichungen
+ * vom Median (MAD) geschätzt und mit 1,4826 auf eine Standardabweichung umgerechnet; sie wird ebenfalls
+ * gleitend gemittelt und in Zehnteln ADC-Schritten geliefert.
+ */
+class MoistureFilter
+{
+public:
+    static const std::size_t MAX_BURST = 32;
+
+private:
+    std::uint32_t value = 0;      // Gefilterter Wert, skaliert mit 16
+    std::uint32_t noise = 0;      // Rauschen in Zehnteln, skaliert mit 16
+    std::uint16_t lastMedian = 0;
+    bool started = false;
+
+public:
+    /**
+     * @brief Verarbeitet einen Burst (höchstens MAX_BURST Werte, die Reihenfolge geht verloren).
+     */
+    void addBurst(std::uint16_t *samples, std::size_t count)
+    {
+        if (count == 0) return;
+        if (count > MAX_BURST) count = MAX_BURST;
+        std::uint16_t median = moistureMedian(samples, count);
+        std::uint16_t deviations[MAX_BURST];
+        for (std::size_t i = 0; i < count; i++) {
+            deviations[i] = samples[i] > median ? samples[i] - median : median - samples[i];
+        }
+        // MAD in Zehnteln x 1,4826 (bei MAD 0 bleibt die halbe Quantisierungsstufe als Untergrenze)
+        std::uint32_t mad = moistureMedian(deviations, count);
+        std::uint32_t sigmaTenths = mad > 0 ? mad * 14826 / 1000 : 5;
+
+        lastMedian = median;
+        if (!started) {
+            value = static_cast<std::uint32_t>(median) * 16;
+            noise = sigmaTenths * 16;
+            started = true;
+            return;
+        }
+        value = value - value / 4 + static_cast<std::uint32_t>(median) * 4;
+        noise = noise - noise / 4 + sigmaTenths * 4;
+    }
+
+    bool hasValue() const { return started; }
+    std::uint16_t getValue() const { return static_cast<std::uint16_t>((value + 8) / 16); }
+    std::uint16_t getLastMedian() const { return lastMedian; }
+    std::uint16_t getNoiseTenths() const { return static_cast<std::uint16_t>((noise + 8) / 16); }
+};
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <Adafruit_ZeroDMA.h>
+#include <wiring_private.h>
+
+/**
+ * @brief Zähler und Laufzeiten des Samplers
+ */
+struct MoistureSamplerStats {
+    std::uint32_t bursts = 0;         // Abgeschlossene Bursts
+    std::uint32_t busySkips = 0;      // start() während eines laufenden Bursts
+    std::uint32_t lastBurstMicros = 0; // Dauer vom Start bis zum letzten Wert (ADC und DMA, ohne CPU)
+    std::uint32_t filterMicros = 0;   // CPU-Zeit für Median und Filter des letzten Bursts
+};
+
+/**
+ * @brief Misst den Feuchtigkeitssensor im Freilaufbetrieb des ADC, die DMA schreibt die Ergebnisse in einen Puffer
+ *
+ * Jedes Ergebnis mittelt der ADC selbst über 16 Wandlungen (AVGCTRL) und liefert es wie analogRead()
+ * mit 10 Bit. Ein Burst von BURST_SAMPLES Ergebnissen dauert wenige Millisekunden; poll() aus loop()
+ * erkennt das Ende, stellt die ADC-Register für analogRead() wieder her und filtert den Burst.
+ *
+ * Während isBusy() darf analogRead() nicht aufgerufen werden, da es denselben ADC umkonfiguriert.
+ */
+class MoistureSampler
+{
+public:
+    static const std::size_t BURST_SAMPLES = 15; // Ungerade, damit der Median ein Messwert ist
+
+private:
+    Adafruit_ZeroDMA dma;
+    DmacDescriptor *descriptor = nullptr;
+    Adc *adc = nullptr;
+    std::uint8_t channel = 0;
+    std::uint16_t samples[BURST_SAMPLES];
+    MoistureFilter filter;
+    bool ready = false;
+    bool active = false;
+    std::uint32_t startMicros = 0;
+    // Register, die analogRead() voraussetzt
+    std::uint16_t savedInputCtrl = 0;
+    std::uint16_t savedCtrlB = 0;
+    std::uint8_t savedAvgCtrl = 0;
+    MoistureSamplerStats stats;
+
+    // Wird im DMA-Interrupt gesetzt; es gibt nur einen Feuchtigkeitssensor und damit nur einen Kanal
+    static volatile bool &transferComplete()
+    {
+        static volatile bool flag = false;
+        return flag;
+    }
+
+    static void onTransferComplete(Adafruit_ZeroDMA *) { transferComplete() = true; }
+
+    void setEnabled(bool enabled)
+    {
+        adc->CTRLA.bit.ENABLE = enabled ? 1 : 0;
+        while (adc->SYNCBUSY.bit.ENABLE);
+    }
+
+public:
+    /**
+     * @brief Reserviert den DMA-Kanal für den ADC des Pins; nach pinMode() aufrufen.
+     * @return false, wenn der Pin kein Analogeingang oder kein DMA-Kanal frei ist
+     */
+    bool begin(std::uint32_t pin)
+    {
+        const PinDescription &description = g_APinDescription[pin];
+        if (description.ulADCChannelNumber == No_ADC_Channel) {
+            return false;
+        }
+        bool alternate = (description.ulPinAttribute & PIN_ATTR_ANALOG_ALT) != 0;
+        adc = alternate ? ADC1 : ADC0;
+        channel = static_cast<std::uint8_t>(description.ulADCChannelNumber);
+        pinPeripheral(pin, alternate ? PIO_ANALOG_ALT : PIO_ANALOG);
+
+        if (dma.allocate() != DMA_STATUS_OK) {
+            return false;
+        }
+        dma.setTrigger(alternate ? ADC1_DMAC_ID_RESRDY : ADC0_DMAC_ID_RESRDY);
+        dma.setAction(DMA_TRIGGER_ACTON_BEAT);
+        descriptor = dma.addDescriptor((void *)&adc->RESULT.reg, samples, BURST_SAMPLES, DMA_BEAT_SIZE_HWORD, false, true);
+        if (descriptor == nullptr) {
+            return false;
+        }
+        dma.setCallback(onTransferComplete);
+        ready = true;
+        return true;
+    }
+
+    /**
+     * @brief Startet einen Burst.
+     * @return false, wenn noch ein Burst läuft oder begin() fehlgeschlagen ist
+     */
+    bool start()
+    {
+        if (!ready) {
+            return false;
+        }
+        if (active) {
+            stats.busySkips++;
+            return false;
+        }
+        setEnabled(false);
+        savedInputCtrl = adc->INPUTCTRL.reg;
+        savedCtrlB = adc->CTRLB.reg;
+        savedAvgCtrl = adc->AVGCTRL.reg;
+
+        adc->INPUTCTRL.reg = ADC_INPUTCTRL_MUXPOS(channel) | ADC_INPUTCTRL_MUXNEG_GND;
+        // 16 Wandlungen aufsummiert (16 Bit) und um 6 Bit geschoben ergibt 10 Bit wie bei analogRead()
+        adc->AVGCTRL.reg = ADC_AVGCTRL_SAMPLENUM_16 | ADC_AVGCTRL_ADJRES(6);
+        adc->CTRLB.reg = ADC_CTRLB_RESSEL_16BIT | ADC_CTRLB_FREERUN;
+        while (adc->SYNCBUSY.reg & (ADC_SYNCBUSY_INPUTCTRL | ADC_SYNCBUSY_AVGCTRL | ADC_SYNCBUSY_CTRLB));
+
+        transferComplete() = false;
+        active = true;
+        startMicros = micros();
+        dma.changeDescriptor(descriptor, (void *)&adc->RESULT.reg, samples, BURST_SAMPLES);
+        dma.startJob();
+        // Die erste Wandlung nach dem Einschalten kann abweichen; als einzelner Ausreißer fällt sie beim Median heraus
+        setEnabled(true);
+        adc->SWTRIG.bit.START = 1;
+        return true;
+    }
+
+    /**
+     * @brief Wertet einen fertigen Burst aus; aus loop() aufrufen.
+     * @return true, wenn ein neuer gefilterter Wert vorliegt
+     */
+    bool poll()
+    {
+        if (!active || !transferComplete()) {
+            return false;
+        }
+        stats.lastBurstMicros = micros() - startMicros;
+        setEnabled(false);
+        adc->CTRLB.reg = savedCtrlB;
+        adc->AVGCTRL.reg = savedAvgCtrl;
+        adc->INPUTCTRL.reg = savedInputCtrl;
+        while (adc->SYNCBUSY.reg & (ADC_SYNCBUSY_INPUTCTRL | ADC_SYNCBUSY_AVGCTRL | ADC_SYNCBUSY_CTRLB));
+        adc->INTFLAG.reg = ADC_INTFLAG_RESRDY;
+        active = false;
+
+        std::uint32_t start = micros();
+        filter.addBurst(samples, BURST_SAMPLES);
+        stats.filterMicros = micros() - start;
+        stats.bursts++;
+        return true;
+    }
+
+    bool isReady() const { return ready; }
+    bool isBusy() const { return active; }
+    const MoistureFilter &getFilter() const { return filter; }
+    const MoistureSamplerStats &getStats() const { return stats; }
+};
+#endif // ARDUINO
+
+#endif //MOISTURE_SAMPLER_HPP__
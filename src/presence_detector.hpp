@@ -0,0 +1,134 @@
+// Anwesenheitserkennung mit dem VL53L0X im Dauermessbetrieb
+/**
+ * @file presence_detector.hpp
+*/
+
+#ifndef PRESENCE_DETECTOR_HPP__
+#define PRESENCE_DETECTOR_HPP__
+
+#include <cstdint>
+
+/**
+ * @brief Ereignisse der Anwesenheitserkennung
+ */
+enum PresenceEvent {
+    PRESENCE_NONE,       // Keine Änderung
+    PRESENCE_APPROACHED, // Jemand hat sich genähert
+    PRESENCE_LEFT        // Die Person hat sich entfernt
+};
+
+/**
+ * @brief Entprellfilter für Entfernungsmessungen
+ *
+ * Eine Person gilt erst nach enterCount aufeinanderfolgenden Messungen unter der Schwelle als
+ * anwesend und erst nach leaveCount Messungen über Schwelle + Hysterese wieder als abwesend.
+ * Einzelne Ausreißer des Sensors lösen so keinen Bildschirmwechsel aus.
+ */
+class PresenceFilter
+{
+private:
+    std::uint16_t threshold;
+    std::uint16_t hysteresis;
+    std::uint8_t enterCount;
+    std::uint8_t leaveCount;
+    std::uint8_t counter = 0;
+    bool present = false;
+
+public:
+    PresenceFilter(std::uint16_t threshold, std::uint16_t hysteresis, std::uint8_t enterCount, std::uint8_t leaveCount)
+        : threshold(threshold), hysteresis(hysteresis), enterCount(enterCount), leaveCount(leaveCount) {}
+
+    /**
+     * @brief Verarbeitet eine neue Messung.
+     * @param [in] distance Entfernung in mm
+     * @param [in] valid false bei Messfehler oder außerhalb der Reichweite (zählt als "niemand da")
+     * @return Ereignis, falls sich der Zustand geändert hat
+     */
+    PresenceEvent update(std::uint16_t distance, bool valid)
+    {
+        bool near = valid && distance <= threshold;
+        bool far = !valid || distance > threshold + hysteresis;
+
+        if (!present) {
+            counter = near ? counter + 1 : 0;
+            if (counter >= enterCount) {
+                present = true;
+                counter = 0;
+                return PRESENCE_APPROACHED;
+            }
+        } else {
+            counter = far ? counter + 1 : 0;
+            if (counter >= leaveCount) {
+                present = false;
+                counter = 0;
+                return PRESENCE_LEFT;
+            }
+        }
+        return PRESENCE_NONE;
+    }
+
+    bool isPresent() const { return present; }
+};
+
+#ifdef ARDUINO
+#include <Adafruit_VL53L0X.h>
+
+/**
+ * @brief Liest den VL53L0X im Dauermessbetrieb aus, ohne auf eine Messung zu warten.
+ *
+ * Der Sensor misst selbstständig im eingestellten Intervall; poll() prüft nur, ob ein neuer
+ * Messwert bereitsteht, und gibt ihn an den Entprellfilter weiter.
+ */
+class PresenceDetector
+{
+private:
+    Adafruit_VL53L0X &sensor;
+    PresenceFilter filter;
+    std::uint16_t lastDistance = 0xffff;
+    std::uint32_t measurements = 0;
+
+public:
+    PresenceDetector(Adafruit_VL53L0X &sensor, std::uint16_t threshold)
+        : sensor(sensor), filter(threshold, threshold / 5, 2, 3) {}
+
+    /**
+     * @brief Startet den Dauermessbetrieb.
+     * @param [in] periodMs Messintervall des Sensors in ms
+     */
+    bool begin(std::uint16_t periodMs)
+    {
+        return sensor.startRangeContinuous(periodMs);
+    }
+
+    /**
+     * @brief Holt eine fertige Messung ab, falls vorhanden.
+     * @return Ereignis des Entprellfilters
+     */
+    PresenceEvent poll()
+    {
+        if (!sensor.isRangeComplete()) {
+            return PRESENCE_NONE;
+        }
+        lastDistance = sensor.readRangeResult();
+        measurements++;
+        // Der Sensor meldet außerhalb der Reichweite Werte ab ca. 8 m
+        return filter.update(lastDistance, lastDistance < 8000);
+    }
+
+    /**
+     * @brief Blockierende Einzelmessung wie vor dem Dauermessbetrieb (nur für Vergleichsmessungen der Schleifenrate).
+     */
+    PresenceEvent pollSingleShot()
+    {
+        lastDistance = sensor.readRange();
+        measurements++;
+        return filter.update(lastDistance, lastDistance < 8000);
+    }
+
+    bool isPresent() const { return filter.isPresent(); }
+    std::uint16_t getLastDistance() const { return lastDistance; }
+    std::uint32_t getMeasurements() const { return measurements; }
+};
+#endif // ARDUINO
+
+#endif //PRESENCE_DETECTOR_HPP__
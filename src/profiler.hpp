@@ -0,0 +1,245 @@
+// Laufzeitmessung einzelner Abschnitte von loop() mit Histogramm (min/mittel/max/p99) in festem Speicher
+/**
+ * @file profiler.hpp
+*/
+
+#ifndef PROFILER_HPP__
+#define PROFILER_HPP__
+
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+/**
+ * @brief Messwerte eines Abschnitts seit dem letzten reset()
+ *
+ * Das Histogramm hat zwei Fächer pro Zweierpotenz (1 µs bis ca. 2 s), dadurch liegt ein
+ * Perzentil höchstens 50 % über dem wahren Wert und der Speicher bleibt fest. Längere Laufzeiten
+ * landen im letzten Fach; fällt ein Perzentil dorthin, wird das Maximum gemeldet.
+ */
+struct ProfileSection {
+    static const std::size_t BUCKETS = 44;
+
+    const char *name = nullptr;
+    std::uint32_t count = 0;
+    std::uint64_t totalMicros = 0;
+    std::uint32_t minMicros = 0;
+    std::uint32_t maxMicros = 0;
+    std::uint32_t buckets[BUCKETS] = {};
+};
+
+/**
+ * @brief Sammelt die Laufzeiten aller Abschnitte
+ *
+ * Auf dem Wio Terminal zählt der Zykluszähler (DWT) des Cortex-M4, auf dem Host std::chrono in µs.
+ * Die Ticks werden beim Erfassen in Mikrosekunden umgerechnet; ein Abschnitt darf daher höchstens
+ * einen Überlauf des 32-Bit-Zählers lang sein (Gerät ca. 35 Sekunden bei 120 MHz, Host ca. 71 Minuten).
+ */
+class Profiler
+{
+public:
+    static const std::size_t MAX_SECTIONS = 16;
+    static const int INVALID_SECTION = -1;
+
+private:
+    ProfileSection sections[MAX_SECTIONS];
+    std::size_t sectionCount = 0;
+
+    static std::size_t bucketIndex(std::uint32_t micros)
+    {
+        if (micros == 0) return 0;
+        int octave = 31 - __builtin_clz(micros);
+        std::uint32_t half = octave > 0 ? (micros >> (octave - 1)) & 1 : 0;
+        std::size_t index = 1 + static_cast<std::size_t>(octave) * 2 + half;
+        return index < ProfileSection::BUCKETS ? index : ProfileSection::BUCKETS - 1;
+    }
+
+    // Größter Wert, der noch in das Fach fällt (das letzte Fach nimmt auch alle längeren Laufzeiten auf)
+    static std::uint32_t bucketUpper(std::size_t index)
+    {
+        if (index == 0) return 0;
+        if (index >= ProfileSection::BUCKETS - 1) return UINT32_MAX;
+        int octave = static_cast<int>((index - 1) / 2);
+        std::uint32_t base = 1u << octave;
+        std::uint32_t step = octave > 0 ? base / 2 : 1;
+        return base + step * static_cast<std::uint32_t>((index - 1) % 2 + 1) - 1;
+    }
+
+public:
+    /**
+     * @brief Startet den Zykluszähler (auf dem Gerät einmal in setup() aufrufen).
+     */
+    static void begin()
+    {
+#ifdef ARDUINO
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+    }
+
+    /**
+     * @brief Aktueller Zeitstempel in Ticks
+     */
+    static std::uint32_t now()
+    {
+#ifdef ARDUINO
+        return DWT->CYCCNT;
+#else
+        // Mikrosekunden statt Nanosekunden, sonst liefe der 32-Bit-Zähler alle 4,3 Sekunden über
+        return static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static std::uint32_t ticksToMicros(std::uint32_t ticks)
+    {
+#ifdef ARDUINO
+        return ticks / (F_CPU / 1000000);
+#else
+        return ticks;
+#endif
+    }
+
+    /**
+     * @return Nummer des Abschnitts oder INVALID_SECTION, wenn kein Platz mehr frei ist
+     */
+    int addSection(const char *name)
+    {
+        if (sectionCount >= MAX_SECTIONS) {
+            return INVALID_SECTION;
+        }
+        sections[sectionCount].name = name;
+        return static_cast<int>(sectionCount++);
+    }
+
+    void record(int section, std::uint32_t micros)
+    {
+        if (section < 0 || static_cast<std::size_t>(section) >= sectionCount) {
+            return;
+        }
+        ProfileSection &s = sections[section];
+        if (s.count == 0 || micros < s.minMicros) s.minMicros = micros;
+        if (micros > s.maxMicros) s.maxMicros = micros;
+        s.count++;
+        s.totalMicros += micros;
+        s.buckets[bucketIndex(micros)]++;
+    }
+
+    /**
+     * @brief Setzt die Messwerte aller Abschnitte zurück (die Abschnitte selbst bleiben).
+     */
+    void reset()
+    {
+        for (std::size_t i = 0; i < sectionCount; i++) {
+            const char *name = sections[i].name;
+            sections[i] = ProfileSection();
+            sections[i].name = name;
+        }
+    }
+
+    std::size_t getSectionCount() const { return sectionCount; }
+    const ProfileSection &getSection(std::size_t i) const { return sections[i]; }
+
+    std::uint32_t getAverage(std::size_t i) const
+    {
+        return sections[i].count > 0 ? static_cast<std::uint32_t>(sections[i].totalMicros / sections[i].count) : 0;
+    }
+
+    /**
+     * @brief Perzentil aus dem Histogramm (Obergrenze des Fachs, höchstens das Maximum)
+     * @param [in] permille z.B. 990 für p99
+     */
+    std::uint32_t getPercentile(std::size_t i, std::uint32_t permille) const
+    {
+        const ProfileSection &s = sections[i];
+        if (s.count == 0) return 0;
+        std::uint64_t target = (static_cast<std::uint64_t>(s.count) * permille + 999) / 1000;
+        std::uint64_t seen = 0;
+        for (std::size_t b = 0; b < ProfileSection::BUCKETS; b++) {
+            seen += s.buckets[b];
+            if (seen >= target) {
+                std::uint32_t upper = bucketUpper(b);
+                return upper < s.maxMicros ? upper : s.maxMicros;
+            }
+        }
+        return s.maxMicros;
+    }
+
+    /**
+     * @brief Eine Zeile für Bericht und Debug-Anzeige: Name, Anzahl, min/mittel/p99/max in µs
+     */
+    void formatLine(char *buffer, std::size_t size, std::size_t i) const
+    {
+        const ProfileSection &s = sections[i];
+        snprintf(buffer, size, "%-12s %7lu %6lu %6lu %7lu %7lu", s.name, (unsigned long)s.count, (unsigned long)s.minMicros,
+                 (unsigned long)getAverage(i), (unsigned long)getPercentile(i, 990), (unsigned long)s.maxMicros);
+    }
+
+    static const char *header() { return "Abschnitt     Anzahl min us mit us  p99 us  max us"; }
+};
+
+/**
+ * @brief Misst die Laufzeit vom Anlegen bis zum Verlassen des Gültigkeitsbereichs
+ */
+class ProfileScope
+{
+private:
+    Profiler &profiler;
+    int section;
+    std::uint32_t start;
+
+public:
+    ProfileScope(Profiler &profiler, int section) : profiler(profiler), section(section), start(Profiler::now()) {}
+    ~ProfileScope() { profiler.record(section, Profiler::ticksToMicros(Profiler::now() - start)); }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+};
+
+/**
+ * @brief Zählt die Durchläufe von loop() und ermittelt daraus die Schleifenrate pro Sekunde
+ */
+class LoopRateCounter
+{
+private:
+    std::uint32_t windowStart = 0;
+    std::uint32_t count = 0;
+    std::uint32_t lastRate = 0;
+    std::uint32_t minRate = UINT32_MAX;
+    std::uint32_t maxRate = 0;
+    bool started = false;
+
+public:
+    /**
+     * @brief Muss einmal pro Durchlauf von loop() aufgerufen werden.
+     */
+    void tick(std::uint32_t now)
+    {
+        if (!started) {
+            windowStart = now;
+            started = true;
+        }
+        count++;
+        std::uint32_t elapsed = now - windowStart;
+        if (elapsed >= 1000) {
+            lastRate = static_cast<std::uint32_t>(static_cast<std::uint64_t>(count) * 1000 / elapsed);
+            if (lastRate < minRate) minRate = lastRate;
+            if (lastRate > maxRate) maxRate = lastRate;
+            count = 0;
+            windowStart = now;
+        }
+    }
+
+    std::uint32_t getRate() const { return lastRate; }
+    std::uint32_t getMinRate() const { return minRate == UINT32_MAX ? 0 : minRate; }
+    std::uint32_t getMaxRate() const { return maxRate; }
+};
+
+#endif //PROFILER_HPP__
@@ -0,0 +1,264 @@
+// Lauflängenkodierte Sprites mit 4-Farben-Palette, werden aus dem Flash in einem Fenster an das Display übertragen
+/**
+ * @file rle_sprite.hpp
+*/
+
+#ifndef RLE_SPRITE_HPP__
+#define RLE_SPRITE_HPP__
+
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * Kodierung: Die Pixel werden zeilenweise (von links nach rechts, von oben nach unten) als Folge von
+ * Läufen gespeichert. Ein Lauf ist ein uint16: Bit 15..14 Palettenindex, Bit 13..0 Länge (1..16383).
+ * Ein Lauf darf über das Zeilenende hinausgehen. Die Farben kommen erst beim Zeichnen aus der Palette,
+ * dadurch kann z.B. die Gesichtsfarbe der Sonnenblume ohne weiteres Sprite geändert werden.
+ */
+
+static const std::uint16_t RLE_SPRITE_MAX_RUN = 0x3fff;
+
+/**
+ * @brief Sprite im Flash samt Position auf dem Bildschirm
+ */
+struct RleSprite {
+    std::int16_t x;
+    std::int16_t y;
+    std::int16_t w;
+    std::int16_t h;
+    const std::uint16_t *runs;
+    std::size_t runCount;
+};
+
+inline std::uint16_t rleSpriteRun(std::uint8_t index, std::uint16_t length)
+{
+    return static_cast<std::uint16_t>((static_cast<std::uint16_t>(index & 0x3) << 14) | (length & RLE_SPRITE_MAX_RUN));
+}
+
+inline std::uint8_t rleSpriteRunIndex(std::uint16_t run) { return static_cast<std::uint8_t>(run >> 14); }
+inline std::uint16_t rleSpriteRunLength(std::uint16_t run) { return run & RLE_SPRITE_MAX_RUN; }
+
+/**
+ * @brief Kodiert ein Bild aus Palettenindizes.
+ * @param [out] runs Ziel für höchstens maxRuns Läufe (nullptr, um nur zu zählen)
+ * @return Anzahl der Läufe
+ */
+inline std::size_t encodeRleSprite(const std::uint8_t *pixels, std::size_t count, std::uint16_t *runs, std::size_t maxRuns)
+{
+    std::size_t runCount = 0;
+    std::size_t i = 0;
+    while (i < count) {
+        std::uint8_t index = pixels[i];
+        std::size_t length = 1;
+        while (i + length < count && pixels[i + length] == index && length < RLE_SPRITE_MAX_RUN) {
+            length++;
+        }
+        if (runs != nullptr && runCount < maxRuns) {
+            runs[runCount] = rleSpriteRun(index, static_cast<std::uint16_t>(length));
+        }
+        runCount++;
+        i += length;
+    }
+    return runCount;
+}
+
+/**
+ * @brief Dekodiert ein Sprite in Palettenindizes (für Host-Werkzeuge und Prüfungen).
+ * @return Anzahl der geschriebenen Pixel
+ */
+inline std::size_t decodeRleSprite(const RleSprite &sprite, std::uint8_t *pixels, std::size_t maxPixels)
+{
+    std::size_t written = 0;
+    for (std::size_t r = 0; r < sprite.runCount; r++) {
+        std::uint8_t index = rleSpriteRunIndex(sprite.runs[r]);
+        for (std::uint16_t n = rleSpriteRunLength(sprite.runs[r]); n > 0 && written < maxPixels; n--) {
+            pixels[written++] = index;
+        }
+    }
+    return written;
+}
+
+/**
+ * @brief Liest ein Sprite abschnittsweise als Farben, z.B. kachelweise für die DMA-Übertragung
+ */
+class RleReader
+{
+private:
+    const RleSprite *sprite = nullptr;
+    std::size_t run = 0;
+    std::uint16_t remaining = 0; // Restlänge des aktuellen Laufs
+    std::uint16_t palette[4] = {0, 0, 0, 0};
+
+public:
+    /**
+     * @param [in] colors Farben der vier Palettenindizes, so wie sie in den Ausgabepuffer geschrieben werden
+     */
+    void reset(const RleSprite &source, const std::uint16_t colors[4])
+    {
+        sprite = &source;
+        run = 0;
+        remaining = source.runCount > 0 ? rleSpriteRunLength(source.runs[0]) : 0;
+        for (int i = 0; i < 4; i++) {
+            palette[i] = colors[i];
+        }
+    }
+
+    /**
+     * @brief Schreibt die nächsten höchstens count Pixel.
+     * @return Anzahl der geschriebenen Pixel (weniger am Ende des Sprites)
+     */
+    std::size_t read(std::uint16_t *pixels, std::size_t count)
+    {
+        std::size_t written = 0;
+        while (written < count && sprite != nullptr && run < sprite->runCount) {
+            std::uint16_t color = palette[rleSpriteRunIndex(sprite->runs[run])];
+            std::size_t n = count - written < remaining ? count - written : remaining;
+            for (std::size_t i = 0; i < n; i++) {
+                pixels[written++] = color;
+            }
+            remaining -= static_cast<std::uint16_t>(n);
+            if (remaining == 0 && ++run < sprite->runCount) {
+                remaining = rleSpriteRunLength(sprite->runs[run]);
+            }
+        }
+        return written;
+    }
+};
+
+/**
+ * @brief Zeichenstatistik
+ */
+struct SpriteStats {
+    std::uint32_t frames = 0;         // Gezeichnete Bilder
+    std::uint32_t unchanged = 0;      // Ausgelassen, da unverändert
+    std::uint32_t lastDrawMicros = 0; // Dauer des letzten Bilds
+    std::uint32_t maxDrawMicros = 0;  // Längstes Bild
+    std::uint32_t deferred = 0;       // Verschoben, da das Display noch belegt war
+};
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include "tft_dma.hpp"
+
+/**
+ * @brief Überträgt ein Sprite in einem einzigen Adressfenster; jeder Lauf ist ein Block gleicher Farbe.
+ * @param [in] palette Farben (RGB565) der vier Palettenindizes
+ * @return Anzahl der übertragenen Pixel
+ */
+inline std::uint32_t blitRleSprite(TFT_eSPI &tft, const RleSprite &sprite, const std::uint16_t palette[4])
+{
+    tft.startWrite();
+    tft.setWindow(sprite.x, sprite.y, sprite.x + sprite.w - 1, sprite.y + sprite.h - 1);
+    for (std::size_t r = 0; r < sprite.runCount; r++) {
+        tft.pushColor(palette[rleSpriteRunIndex(sprite.runs[r])], rleSpriteRunLength(sprite.runs[r]));
+    }
+    tft.endWrite();
+    return static_cast<std::uint32_t>(sprite.w) * static_cast<std::uint32_t>(sprite.h);
+}
+
+/**
+ * @brief Zeigt eines von mehreren Sprites an und zeichnet nur, wenn sich Sprite oder Palette ändern
+ */
+class SpriteView
+{
+private:
+    const RleSprite *current = nullptr;
+    std::uint16_t palette[4] = {0, 0, 0, 0};
+    SpriteStats stats;
+    RleReader reader;          // Lesezeiger der laufenden DMA-Übertragung
+    std::uint32_t startMicros = 0;
+
+    bool isUnchanged(const RleSprite &sprite, const std::uint16_t newPalette[4]) const
+    {
+        bool samePalette = true;
+        for (int i = 0; i < 4; i++) {
+            samePalette = samePalette && palette[i] == newPalette[i];
+        }
+        return current == &sprite && samePalette;
+    }
+
+    void accept(const RleSprite &sprite, const std::uint16_t newPalette[4])
+    {
+        current = &sprite;
+        for (int i = 0; i < 4; i++) {
+            palette[i] = newPalette[i];
+        }
+    }
+
+    void record(std::uint32_t duration)
+    {
+        stats.frames++;
+        stats.lastDrawMicros = duration;
+        if (duration > stats.maxDrawMicros) stats.maxDrawMicros = duration;
+    }
+
+    static void composeTile(std::uint16_t *pixels, std::size_t count, void *context)
+    {
+        static_cast<SpriteView *>(context)->reader.read(pixels, count);
+    }
+
+    static void transferDone(void *context)
+    {
+        SpriteView *view = static_cast<SpriteView *>(context);
+        view->record(micros() - view->startMicros);
+    }
+
+public:
+    /**
+     * @brief Der Bildschirm wurde überschrieben: beim nächsten show() in jedem Fall zeichnen.
+     */
+    void invalidate() { current = nullptr; }
+
+    /**
+     * @return Anzahl der übertragenen Pixel (0, wenn unverändert)
+     */
+    std::uint32_t show(TFT_eSPI &tft, const RleSprite &sprite, const std::uint16_t newPalette[4])
+    {
+        if (isUnchanged(sprite, newPalette)) {
+            stats.unchanged++;
+            return 0;
+        }
+
+        std::uint32_t start = micros();
+        std::uint32_t pixels = blitRleSprite(tft, sprite, newPalette);
+        record(micros() - start);
+        accept(sprite, newPalette);
+        return pixels;
+    }
+
+    /**
+     * @brief Wie show(), überträgt aber per DMA im Hintergrund; die Dauer wird erst am Ende der Übertragung erfasst.
+     * @return Anzahl der Pixel der gestarteten Übertragung (0, wenn unverändert oder das Display noch belegt ist)
+     */
+    std::uint32_t show(TFT_eSPI &tft, TftDmaRenderer &dma, const RleSprite &sprite, const std::uint16_t newPalette[4])
+    {
+        if (isUnchanged(sprite, newPalette)) {
+            stats.unchanged++;
+            return 0;
+        }
+        if (dma.isBusy()) {
+            // Beim nächsten Aufruf erneut versuchen
+            stats.deferred++;
+            return 0;
+        }
+
+        std::uint16_t colors[4];
+        for (int i = 0; i < 4; i++) {
+            colors[i] = tftDmaColor(newPalette[i]);
+        }
+        reader.reset(sprite, colors);
+        startMicros = micros();
+        if (!dma.start(sprite.x, sprite.y, sprite.w, sprite.h, composeTile, transferDone, this)) {
+            // Kein DMA-Kanal: blockierend übertragen
+            return show(tft, sprite, newPalette);
+        }
+        accept(sprite, newPalette);
+        return static_cast<std::uint32_t>(sprite.w) * static_cast<std::uint32_t>(sprite.h);
+    }
+
+    const SpriteStats &getStats() const { return stats; }
+};
+#endif // ARDUINO
+
+#endif //RLE_SPRITE_HPP__
@@ -0,0 +1,180 @@
+// Kooperativer Scheduler für die periodischen Aufgaben in loop()
+/**
+ * @file scheduler.hpp
+*/
+
+#ifndef SCHEDULER_HPP__
+#define SCHEDULER_HPP__
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Laufzeitstatistik einer Aufgabe
+ */
+struct TaskStats {
+    std::uint32_t runs = 0;        // Anzahl Ausführungen
+    std::uint32_t overruns = 0;    // Ausführungen, die nach Ablauf der Deadline gestartet wurden
+    std::uint32_t skipped = 0;     // Ganze Perioden, die wegen Verspätung ausgelassen wurden
+    std::uint32_t lastJitter = 0;  // Verspätung der letzten Ausführung gegenüber dem Soll-Zeitpunkt (ms)
+    std::uint32_t maxJitter = 0;   // Größte gemessene Verspätung (ms)
+    std::uint32_t lastRuntime = 0; // Laufzeit der letzten Ausführung (ms)
+    std::uint32_t maxRuntime = 0;  // Längste Laufzeit (ms)
+};
+
+/**
+ * @brief Deadline-gesteuerter, kooperativer Scheduler mit fester Kapazität
+ *
+ * Jede Aufgabe hat eine eigene Periode, eine relative Deadline und eine Priorität.
+ * Die Aufgaben liegen in einem Min-Heap nach Soll-Zeitpunkt (bei Gleichstand entscheidet
+ * die Priorität), run() führt alle fälligen Aufgaben aus und plant sie neu ein.
+ * Es wird kein Heap-Speicher verwendet.
+ */
+class Scheduler
+{
+public:
+    typedef void (*TaskFunction)();
+    typedef std::uint32_t (*ClockFunction)();
+
+    static const std::size_t MAX_TASKS = 20;
+    static const int INVALID_TASK = -1;
+
+private:
+    struct Task {
+        const char *name;
+        TaskFunction function;
+        std::uint32_t period;
+        std::uint32_t deadline;
+        std::uint8_t priority;
+        std::uint32_t nextRun;
+        TaskStats stats;
+    };
+
+    Task tasks[MAX_TASKS];
+    std::uint8_t heap[MAX_TASKS]; // Indizes in tasks[], geordnet nach nextRun
+    std::size_t taskCount = 0;
+    ClockFunction clock = nullptr;
+
+    // Zeitvergleich, der den Überlauf von millis() nach ~49 Tagen übersteht
+    static bool isBefore(std::uint32_t a, std::uint32_t b) { return static_cast<std::int32_t>(a - b) < 0; }
+
+    bool runsBefore(std::uint8_t a, std::uint8_t b) const
+    {
+        if (tasks[a].nextRun != tasks[b].nextRun) {
+            return isBefore(tasks[a].nextRun, tasks[b].nextRun);
+        }
+        return tasks[a].priority > tasks[b].priority;
+    }
+
+    void siftUp(std::size_t i)
+    {
+        while (i > 0) {
+            std::size_t parent = (i - 1) / 2;
+            if (!runsBefore(heap[i], heap[parent])) break;
+            std::uint8_t tmp = heap[i]; heap[i] = heap[parent]; heap[parent] = tmp;
+            i = parent;
+        }
+    }
+
+    void siftDown(std::size_t i)
+    {
+        while (true) {
+            std::size_t left = 2 * i + 1;
+            std::size_t right = left + 1;
+            std::size_t first = i;
+            if (left < taskCount && runsBefore(heap[left], heap[first])) first = left;
+            if (right < taskCount && runsBefore(heap[right], heap[first])) first = right;
+            if (first == i) break;
+            std::uint8_t tmp = heap[i]; heap[i] = heap[first]; heap[first] = tmp;
+            i = first;
+        }
+    }
+
+public:
+    /**
+     * @brief Legt die Zeitquelle fest (z.B. millis), die während run() für Laufzeitmessungen verwendet wird.
+     */
+    void setClock(ClockFunction clock) { this->clock = clock; }
+
+    /**
+     * @brief Registriert eine periodische Aufgabe.
+     * @param [in] name Name für Statistik-Ausgaben
+     * @param [in] function Aufgabe
+     * @param [in] period Periode in ms (0 = bei jedem Durchlauf)
+     * @param [in] deadline Relative Deadline in ms ab Soll-Zeitpunkt (0 = gleich der Periode)
+     * @param [in] priority Höhere Werte werden bei gleichem Soll-Zeitpunkt zuerst ausgeführt
+     * @param [in] now Aktuelle Zeit; die erste Ausführung erfolgt sofort
+     * @return Id der Aufgabe oder INVALID_TASK, wenn kein Platz mehr frei ist
+     */
+    int addTask(const char *name, TaskFunction function, std::uint32_t period, std::uint32_t deadline, std::uint8_t priority, std::uint32_t now)
+    {
+        if (taskCount >= MAX_TASKS || function == nullptr) {
+            return INVALID_TASK;
+        }
+        std::size_t id = taskCount;
+        Task &task = tasks[id];
+        task.name = name;
+        task.function = function;
+        task.period = period;
+        task.deadline = deadline != 0 ? deadline : period;
+        task.priority = priority;
+        task.nextRun = now;
+        task.stats = TaskStats();
+        heap[taskCount] = static_cast<std::uint8_t>(id);
+        taskCount++;
+        siftUp(taskCount - 1);
+        return static_cast<int>(id);
+    }
+
+    /**
+     * @brief Führt alle Aufgaben aus, deren Soll-Zeitpunkt erreicht ist.
+     * @param [in] now Aktuelle Zeit in ms
+     * @return Anzahl der ausgeführten Aufgaben
+     */
+    std::size_t run(std::uint32_t now)
+    {
+        std::size_t executed = 0;
+        // Jede Aufgabe höchstens einmal pro Aufruf, damit eine Aufgabe mit Periode 0 die anderen nicht aushungert
+        for (std::size_t n = 0; n < taskCount && taskCount > 0; n++) {
+            std::uint8_t id = heap[0];
+            Task &task = tasks[id];
+            if (isBefore(now, task.nextRun)) {
+                break;
+            }
+
+            std::uint32_t jitter = now - task.nextRun;
+            task.stats.lastJitter = jitter;
+            if (jitter > task.stats.maxJitter) task.stats.maxJitter = jitter;
+            if (task.deadline != 0 && jitter >= task.deadline) task.stats.overruns++;
+
+            std::uint32_t start = clock != nullptr ? clock() : now;
+            task.function();
+            std::uint32_t runtime = (clock != nullptr ? clock() : now) - start;
+            task.stats.lastRuntime = runtime;
+            if (runtime > task.stats.maxRuntime) task.stats.maxRuntime = runtime;
+            task.stats.runs++;
+            executed++;
+
+            // Neu einplanen im festen Raster; verpasste Perioden werden übersprungen statt nachgeholt
+            if (task.period == 0) {
+                task.nextRun = now + 1;
+            } else {
+                task.nextRun += task.period;
+                if (!isBefore(now, task.nextRun)) {
+                    std::uint32_t missed = (now - task.nextRun) / task.period + 1;
+                    task.stats.skipped += missed;
+                    task.nextRun += missed * task.period;
+                }
+            }
+            siftDown(0);
+        }
+        return executed;
+    }
+
+    std::size_t getTaskCount() const { return taskCount; }
+    const char *getTaskName(std::size_t id) const { return id < taskCount ? tasks[id].name : ""; }
+    std::uint32_t getTaskPeriod(std::size_t id) const { return id < taskCount ? tasks[id].period : 0; }
+    const TaskStats &getStats(std::size_t id) const { return tasks[id < taskCount ? id : 0].stats; }
+};
+
+#endif //SCHEDULER_HPP__
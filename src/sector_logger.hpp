@@ -0,0 +1,451 @@
+// Gepufferter, sektorweise schreibender Logger für die SD-Karte
+/**
+ * @file sector_logger.hpp
+*/
+
+#ifndef SECTOR_LOGGER_HPP__
+#define SECTOR_LOGGER_HPP__
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "log_format.hpp"
+
+/**
+ * @brief Statistik des Loggers
+ */
+struct SectorLogStats {
+    std::uint32_t recordsAppended = 0; // Angenommene Datensätze
+    std::uint32_t recordsDropped = 0;  // Verworfene Datensätze (Puffer voll)
+    std::uint32_t recoveries = 0;      // Dateien ohne gültigen Dateikopf, deren Stand aus den Blöcken ermittelt wurde
+    std::uint32_t flushes = 0;         // Anzahl Schreibvorgänge (inkl. Commit)
+    std::uint32_t sectorsWritten = 0;  // Geschriebene Datensektoren
+    std::uint32_t lastFlushMicros = 0; // Dauer des letzten Schreibvorgangs
+    std::uint32_t maxFlushMicros = 0;  // Längster Schreibvorgang
+    std::uint64_t totalFlushMicros = 0;
+    std::uint32_t rotations = 0;       // Gewechselte Logdateien (Zeitraum)
+};
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <SD.h>
+
+/**
+ * @brief Sammelt Datensätze in einem Ringpuffer im RAM und schreibt nur ganze 512-Byte-Blöcke
+ * (Format siehe log_format.hpp) an feste Positionen einer vorreservierten Datei.
+ *
+ * Die Datei bleibt dauerhaft geöffnet, es gibt keine open/seek/close-Zyklen pro Datensatz.
+ * Geschrieben wird, sobald flushBlocks volle Blöcke bereitliegen oder die ältesten
+ * ungeschriebenen Daten älter als maxAgeMs sind (dann auch der angefangene Block).
+ * Volle Blöcke landen an ihrer festen Position, der angefangene Block und danach der Dateikopf
+ * als Commit-Marke im jeweils nicht aktuellen Fach A/B. Kein Schreibvorgang trifft bereits
+ * bestätigte Daten, ein Stromausfall kostet damit höchstens den Inhalt des RAM-Puffers.
+ * Ist keiner der beiden Dateiköpfe lesbar, wird der Stand aus den versiegelten Blöcken ermittelt;
+ * eine Datei mit fremdem Inhalt wird nie neu angelegt.
+ *
+ * Für jeden Zeitraum (z.B. einen Tag) wird eine eigene Datei samt Blockindex angelegt. Der Wechsel
+ * passiert automatisch beim ersten Datensatz, dessen Zeitstempel außerhalb der aktuellen Datei liegt.
+ */
+class SectorLogger
+{
+public:
+    static const std::size_t SECTOR_SIZE = LOG_SECTOR_SIZE;
+    static const std::size_t RING_SECTORS = 4;        // 2 KB RAM-Puffer
+    static const std::uint32_t PREALLOC_SECTORS = 64; // Datei wird in Schritten von 32 KB vergrößert
+
+private:
+    File file;
+    File indexFile;
+    char directory[16];
+    char partitionName[9] = "";
+    std::uint32_t partitionSpan = LOG_DEFAULT_PARTITION_SPAN;
+    std::uint32_t partitionStart = 0;
+    std::uint32_t indexedBlocks = 0; // Blöcke mit Eintrag im Index
+    std::uint8_t ring[RING_SECTORS * SECTOR_SIZE];
+    std::uint32_t appendedRecords = 0;  // Anzahl Datensätze inklusive RAM-Puffer
+    std::uint32_t committedRecords = 0; // Bis hierhin sind die Datensätze auf der Karte
+    std::uint32_t commitSequence = 0;
+    std::uint32_t allocatedSectors = 0; // Vorreservierte Datensektoren
+    std::uint32_t oldestPendingTime = 0;
+    bool pending = false;
+    bool isOpen = false;
+    std::size_t flushBlocks;
+    std::uint32_t maxAgeMs;
+    SectorLogStats stats;
+
+    std::uint8_t *slot(std::uint32_t block) { return ring + (block % RING_SECTORS) * SECTOR_SIZE; }
+
+    // Dateikopf in das Fach von sequence schreiben
+    bool writeHeader(std::uint32_t records, std::uint32_t sequence)
+    {
+        std::uint8_t sector[SECTOR_SIZE];
+        LogFileHeader header;
+        header.committedRecords = records;
+        header.commitSequence = sequence;
+        header.partitionStart = partitionStart;
+        header.partitionSpan = partitionSpan;
+        encodeLogFileHeader(header, sector);
+        return file.seek(logHeaderOffset(sequence)) && file.write(sector, SECTOR_SIZE) == SECTOR_SIZE;
+    }
+
+    // Neue Datei: Dateikopf in Fach A, Fach B und die Blockfächer leer
+    bool initialize()
+    {
+        std::uint8_t zero[SECTOR_SIZE];
+        std::memset(zero, 0, sizeof(zero));
+        if (!writeHeader(0, 0)) {
+            return false;
+        }
+        for (std::uint32_t sector = 1; sector < LOG_DATA_SECTOR; sector++) {
+            if (file.write(zero, SECTOR_SIZE) != SECTOR_SIZE) {
+                return false;
+            }
+        }
+        file.flush();
+        return true;
+    }
+
+    // Angefangenen Block aus dem Blockfach von sequence in den Puffer laden
+    bool loadTail(std::uint32_t sequence, std::uint32_t block, std::uint16_t &count)
+    {
+        std::uint8_t *buffer = slot(block);
+        count = 0;
+        return file.seek(logTailOffset(sequence)) && file.read(buffer, SECTOR_SIZE) == static_cast<int>(SECTOR_SIZE)
+            && checkLogBlock(buffer, block, count) && count > 0 && count < LOG_RECORDS_PER_BLOCK;
+    }
+
+    // Stand ohne gültigen Dateikopf aus den versiegelten Blöcken ermitteln: volle Blöcke bis zum ersten
+    // ungültigen, danach der längere gültige angefangene Block aus den Blockfächern. commitSequence wird
+    // auf dessen Fach gesetzt, damit der neue Dateikopf darauf verweist.
+    bool recover(std::uint32_t size)
+    {
+        std::uint8_t sector[SECTOR_SIZE];
+        std::uint32_t blocks = 0;
+        std::uint16_t count = 0;
+        while (logBlockOffset(blocks) + SECTOR_SIZE <= size && file.seek(logBlockOffset(blocks))
+               && file.read(sector, SECTOR_SIZE) == static_cast<int>(SECTOR_SIZE)
+               && checkLogBlock(sector, blocks, count) && count == LOG_RECORDS_PER_BLOCK) {
+            blocks++;
+        }
+        committedRecords = blocks * LOG_RECORDS_PER_BLOCK;
+        std::uint16_t tailCount = 0;
+        for (std::uint32_t sequence = 0; sequence < LOG_TAIL_SECTORS; sequence++) {
+            if (loadTail(sequence, blocks, count) && count > tailCount) {
+                tailCount = count;
+                commitSequence = sequence;
+            }
+        }
+        if (tailCount > 0) {
+            loadTail(commitSequence, blocks, count);
+            committedRecords += tailCount;
+        }
+        appendedRecords = committedRecords;
+        stats.recoveries++;
+        return committedRecords > 0;
+    }
+
+    // Trägt eines der Kopf-Fächer die Kennung, stammt die Datei aus einem anderen Format oder Zeitraum
+    static bool hasMagic(const std::uint8_t *slotA, const std::uint8_t *slotB)
+    {
+        return std::memcmp(slotA, LOG_FILE_MAGIC, 4) == 0 || std::memcmp(slotB, LOG_FILE_MAGIC, 4) == 0;
+    }
+
+    // Datei um PREALLOC_SECTORS Nullsektoren verlängern
+    bool preallocate()
+    {
+        std::uint8_t zero[SECTOR_SIZE];
+        std::memset(zero, 0, sizeof(zero));
+        if (!file.seek(logBlockOffset(allocatedSectors))) {
+            return false;
+        }
+        for (std::uint32_t i = 0; i < PREALLOC_SECTORS; i++) {
+            if (file.write(zero, SECTOR_SIZE) != SECTOR_SIZE) {
+                return false;
+            }
+        }
+        allocatedSectors += PREALLOC_SECTORS;
+        file.flush();
+        return true;
+    }
+
+    // Fehlende Indexeinträge (z.B. nach Stromausfall) aus den ersten Datensätzen der Blöcke ergänzen
+    bool appendIndexEntries(std::uint32_t blockCount)
+    {
+        while (indexedBlocks < blockCount) {
+            std::uint8_t record[LOG_RECORD_SIZE];
+            const std::uint8_t *first = nullptr;
+            std::uint32_t block = indexedBlocks;
+            if (block >= committedRecords / LOG_RECORDS_PER_BLOCK && block * LOG_RECORDS_PER_BLOCK < appendedRecords) {
+                first = slot(block) + LOG_BLOCK_HEADER_SIZE; // Block liegt noch im RAM-Puffer
+            } else if (file.seek(logBlockOffset(block) + LOG_BLOCK_HEADER_SIZE)
+                       && file.read(record, LOG_RECORD_SIZE) == static_cast<int>(LOG_RECORD_SIZE)) {
+                first = record;
+            } else {
+                return false;
+            }
+
+            LogIndexEntry entry;
+            entry.firstEpoch = decodeLogRecord(first).epoch;
+            entry.offset = logBlockOffset(block);
+            std::uint8_t encoded[LOG_INDEX_ENTRY_SIZE];
+            encodeLogIndexEntry(entry, encoded);
+            if (!indexFile.seek(block * LOG_INDEX_ENTRY_SIZE) || indexFile.write(encoded, LOG_INDEX_ENTRY_SIZE) != LOG_INDEX_ENTRY_SIZE) {
+                return false;
+            }
+            indexedBlocks++;
+        }
+        indexFile.flush();
+        return true;
+    }
+
+    // Öffnet bzw. erstellt die Datei (samt Index) für den Zeitraum, zu dem epoch gehört
+    bool openPartition(std::uint32_t epoch)
+    {
+        partitionStart = logPartitionStart(epoch, partitionSpan);
+        formatLogPartitionName(partitionName, partitionStart, partitionSpan);
+        char path[40];
+        snprintf(path, sizeof(path), "%s/%s.DAT", directory, partitionName);
+        bool created = !SD.exists(path);
+        // Ohne O_APPEND öffnen, sonst landen alle Schreibzugriffe am Dateiende
+        file = SD.open(path, O_READ | O_WRITE | O_CREAT);
+        snprintf(path, sizeof(path), "%s/%s.IDX", directory, partitionName);
+        if (created) {
+            SD.remove(path); // Verwaister Index einer gelöschten Datendatei
+        }
+        indexFile = SD.open(path, O_READ | O_WRITE | O_CREAT);
+        if (!file || !indexFile) {
+            return false;
+        }
+
+        appendedRecords = 0;
+        committedRecords = 0;
+        commitSequence = 0;
+        pending = false;
+        std::memset(ring, 0, sizeof(ring));
+
+        std::uint8_t slotA[SECTOR_SIZE];
+        std::uint8_t slotB[SECTOR_SIZE];
+        LogFileHeader header;
+        std::uint32_t size = file.size();
+        allocatedSectors = size > logBlockOffset(0) ? size / SECTOR_SIZE - LOG_DATA_SECTOR : 0;
+        if (created || size < logBlockOffset(0)) {
+            // Neue oder beim Anlegen unterbrochene Datei (kleiner als Köpfe und Blockfächer, enthält also keine Daten)
+            if (!initialize()) {
+                return false;
+            }
+        } else if (!file.seek(0) || file.read(slotA, SECTOR_SIZE) != static_cast<int>(SECTOR_SIZE)
+                   || file.read(slotB, SECTOR_SIZE) != static_cast<int>(SECTOR_SIZE)) {
+            return false;
+        } else if (selectLogFileHeader(slotA, slotB, header)) {
+            if (header.partitionStart != partitionStart) {
+                return false; // Datei eines anderen Zeitraums, wird nicht angetastet
+            }
+            // Bestehende Datei fortsetzen: angefangenen Block aus seinem Blockfach in den Puffer laden
+            committedRecords = header.committedRecords;
+            commitSequence = header.commitSequence;
+            std::uint32_t block = committedRecords / LOG_RECORDS_PER_BLOCK;
+            std::uint16_t count = 0;
+            std::uint32_t used = committedRecords % LOG_RECORDS_PER_BLOCK;
+            if (used != 0 && (!loadTail(commitSequence, block, count) || count != used)) {
+                // Blockfach unlesbar: nur die vollen Blöcke bleiben, die verlorenen Datensätze werden gezählt
+                stats.recordsDropped += used;
+                committedRecords -= used;
+                std::memset(slot(block), 0, SECTOR_SIZE);
+            }
+            appendedRecords = committedRecords;
+        } else {
+            // Kein Dateikopf lesbar (z.B. beide Fächer beschädigt): nie neu anlegen, sondern den Stand aus den
+            // versiegelten Blöcken ermitteln. Findet sich dort nichts, obwohl ein Kopf mit unserer Kennung
+            // vorhanden ist (älteres Format), bleibt die Datei unangetastet.
+            if (!recover(size) && hasMagic(slotA, slotB)) {
+                return false;
+            }
+            if (!writeHeader(committedRecords, commitSequence)) {
+                return false;
+            }
+            file.flush();
+        }
+
+        // Index mit den bestätigten Blöcken abgleichen; Einträge für nicht bestätigte Blöcke werden überschrieben
+        std::uint32_t committedBlocks = (committedRecords + LOG_RECORDS_PER_BLOCK - 1) / LOG_RECORDS_PER_BLOCK;
+        indexedBlocks = indexFile.size() / LOG_INDEX_ENTRY_SIZE;
+        if (indexedBlocks > committedBlocks) {
+            indexedBlocks = committedBlocks;
+        }
+        if (!appendIndexEntries(committedBlocks)) {
+            return false;
+        }
+
+        if (allocatedSectors <= committedRecords / LOG_RECORDS_PER_BLOCK + RING_SECTORS && !preallocate()) {
+            return false;
+        }
+        isOpen = true;
+        return true;
+    }
+
+    // Aktuelle Datei abschließen und die Datei für den Zeitraum von epoch öffnen
+    bool rotate(std::uint32_t epoch)
+    {
+        if (isOpen) {
+            // Gepufferte Datensätze bleiben im Ring und in der bisherigen Datei, bis sie auf der Karte sind;
+            // bis dahin werden neue Datensätze verworfen und gezählt
+            if (!flush()) {
+                return false;
+            }
+            file.close();
+            indexFile.close();
+            isOpen = false;
+            stats.rotations++;
+        }
+        if (!openPartition(epoch)) {
+            file.close();
+            indexFile.close();
+            return false;
+        }
+        return true;
+    }
+
+public:
+    /**
+     * @param [in] flushBlocks Anzahl voller Blöcke, ab der geschrieben wird
+     * @param [in] maxAgeMs Maximale Verweildauer von Daten im RAM
+     */
+    SectorLogger(std::size_t flushBlocks, std::uint32_t maxAgeMs)
+        : flushBlocks(flushBlocks), maxAgeMs(maxAgeMs) { directory[0] = '\0'; }
+
+    /**
+     * @brief Legt das Logverzeichnis an. Die Datei für den aktuellen Zeitraum wird beim ersten Datensatz geöffnet.
+     * @param [in] path Verzeichnis (max. 15 Zeichen, z.B. "/logs")
+     * @param [in] span Zeitraum pro Datei in Sekunden, muss ein Teiler oder Vielfaches eines Tages in ganzen Stunden sein
+     * @return false bei Fehlern
+     */
+    bool begin(const char *path, std::uint32_t span)
+    {
+        snprintf(directory, sizeof(directory), "%s", path);
+        partitionSpan = span >= 3600 ? span - span % 3600 : 3600;
+        isOpen = false;
+        return SD.exists(directory) || SD.mkdir(directory);
+    }
+
+    /**
+     * @brief Hängt einen Datensatz an. Es wird nur in den RAM-Puffer kopiert.
+     * @return false, wenn der Puffer voll ist und der Datensatz verworfen wurde
+     */
+    bool append(const LogRecord &record, std::uint32_t now)
+    {
+        // Rotationsschritt: neuer Zeitraum (oder Uhr zurückgestellt) -> andere Datei
+        if (!isOpen || record.epoch < partitionStart || record.epoch - partitionStart >= partitionSpan) {
+            if (!rotate(record.epoch)) {
+                stats.recordsDropped++;
+                return false;
+            }
+        }
+
+        std::uint32_t block = appendedRecords / LOG_RECORDS_PER_BLOCK;
+        if (!isOpen || block - committedRecords / LOG_RECORDS_PER_BLOCK >= RING_SECTORS) {
+            stats.recordsDropped++;
+            return false;
+        }
+
+        std::size_t index = appendedRecords % LOG_RECORDS_PER_BLOCK;
+        if (index == 0) {
+            // Neuer Block im Ring: Reste eines früheren Umlaufs löschen
+            std::memset(slot(block), 0, SECTOR_SIZE);
+        }
+        encodeLogRecord(record, slot(block) + LOG_BLOCK_HEADER_SIZE + index * LOG_RECORD_SIZE);
+
+        if (!pending) {
+            oldestPendingTime = now;
+            pending = true;
+        }
+        appendedRecords++;
+        stats.recordsAppended++;
+        return true;
+    }
+
+    /**
+     * @brief Schreibt gemäß Größen- bzw. Zeitschwelle auf die Karte; regelmäßig aufrufen.
+     * @return true, wenn geschrieben wurde
+     */
+    bool service(std::uint32_t now)
+    {
+        if (!isOpen || !pending) {
+            return false;
+        }
+        std::uint32_t fullBlocks = appendedRecords / LOG_RECORDS_PER_BLOCK - committedRecords / LOG_RECORDS_PER_BLOCK;
+        bool timeout = now - oldestPendingTime >= maxAgeMs;
+        if (fullBlocks < flushBlocks && !timeout) {
+            return false;
+        }
+        return flush();
+    }
+
+    /**
+     * @brief Schreibt alle gepufferten Datensätze inklusive des angefangenen Blocks und aktualisiert die Commit-Marke.
+     */
+    bool flush()
+    {
+        if (!isOpen || appendedRecords == committedRecords) {
+            pending = false;
+            return true;
+        }
+
+        std::uint32_t start = micros();
+        std::uint32_t firstBlock = committedRecords / LOG_RECORDS_PER_BLOCK;
+        std::uint32_t fullBlocks = appendedRecords / LOG_RECORDS_PER_BLOCK;
+        std::uint32_t lastBlock = (appendedRecords - 1) / LOG_RECORDS_PER_BLOCK;
+        std::uint32_t sequence = commitSequence + 1;
+
+        if (fullBlocks > allocatedSectors && !preallocate()) {
+            return false;
+        }
+        // Volle Blöcke an ihre feste Position, die noch nie bestätigte Daten enthielt
+        for (std::uint32_t block = firstBlock; block < fullBlocks; block++) {
+            sealLogBlock(slot(block), block, static_cast<std::uint16_t>(LOG_RECORDS_PER_BLOCK));
+            if (!file.seek(logBlockOffset(block)) || file.write(slot(block), SECTOR_SIZE) != SECTOR_SIZE) {
+                return false;
+            }
+            stats.sectorsWritten++;
+        }
+        // Angefangenen Block in das Blockfach, auf das der bisherige Dateikopf nicht verweist
+        if (lastBlock >= fullBlocks) {
+            sealLogBlock(slot(lastBlock), lastBlock, static_cast<std::uint16_t>(appendedRecords % LOG_RECORDS_PER_BLOCK));
+            if (!file.seek(logTailOffset(sequence)) || file.write(slot(lastBlock), SECTOR_SIZE) != SECTOR_SIZE) {
+                return false;
+            }
+            stats.sectorsWritten++;
+        }
+        file.flush();
+
+        // Indexeinträge für neu begonnene Blöcke, noch vor der Commit-Marke
+        if (!appendIndexEntries(lastBlock + 1)) {
+            return false;
+        }
+
+        // Commit-Marke erst nach den Daten schreiben, ebenfalls in das nicht aktuelle Fach
+        if (!writeHeader(appendedRecords, sequence)) {
+            return false;
+        }
+        file.flush();
+        committedRecords = appendedRecords;
+        commitSequence = sequence;
+        pending = false;
+
+        std::uint32_t duration = micros() - start;
+        stats.flushes++;
+        stats.lastFlushMicros = duration;
+        if (duration > stats.maxFlushMicros) stats.maxFlushMicros = duration;
+        stats.totalFlushMicros += duration;
+        return true;
+    }
+
+    bool isReady() const { return isOpen; }
+    const char *getPartitionName() const { return partitionName; }
+    std::uint32_t getCommittedRecords() const { return committedRecords; }
+    std::uint32_t getPendingRecords() const { return appendedRecords - committedRecords; }
+    const SectorLogStats &getStats() const { return stats; }
+};
+#endif // ARDUINO
+
+#endif //SECTOR_LOGGER_HPP__
@@ -0,0 +1,103 @@
+// Gemeinsamer Zwischenspeicher für die zuletzt erfassten Sensorwerte
+/**
+ * @file sensor_snapshot.hpp
+*/
+
+#ifndef SENSOR_SNAPSHOT_HPP__
+#define SENSOR_SNAPSHOT_HPP__
+
+#include <cstdint>
+#include <cmath>
+
+/**
+ * @brief Ein Satz Sensorwerte mit Zeitstempeln (millis) der jeweiligen Erfassung
+ */
+struct SensorReading {
+    int moisture = 0;                 // Bodenfeuchtigkeit (Rohwert ADC)
+    std::uint16_t moistureNoise = 0;  // Geschätztes Rauschen der Bodenfeuchtigkeit in Zehnteln ADC-Schritten (0 = unbekannt)
+    float temperature = NAN;          // Temperatur in °C
+    float humidity = NAN;             // Luftfeuchtigkeit in %
+    std::uint32_t moistureTime = 0;   // Zeitpunkt der letzten Feuchtigkeitsmessung
+    std::uint32_t climateTime = 0;    // Zeitpunkt der letzten gültigen DHT-Messung
+    bool hasMoisture = false;         // Mindestens eine Feuchtigkeitsmessung vorhanden
+    bool hasClimate = false;          // Mindestens eine gültige DHT-Messung vorhanden
+    std::uint32_t sequence = 0;       // Wird bei jeder neuen Messung erhöht
+};
+
+/**
+ * @brief Nimmt pro Periode genau eine Messung je Sensor entgegen und stellt sie allen Verbrauchern bereit.
+ *
+ * Die Erfassung (Hardwarezugriff) passiert an genau einer Stelle; Relais, Anzeige, SD-Log und
+ * Telemetrie lesen nur noch aus diesem Zwischenspeicher und können über die Alters-Abfragen
+ * entscheiden, ob ein Wert noch brauchbar ist.
+ */
+class SensorSnapshot
+{
+public:
+    // Der DHT11 liefert frühestens alle 2 Sekunden einen neuen Messwert
+    static const std::uint32_t DHT_MIN_PERIOD = 2000;
+
+private:
+    SensorReading reading;
+    std::uint32_t maxAge;
+    std::uint32_t climateAttemptTime = 0;
+    bool climateAttempted = false;
+    std::uint32_t climateErrors = 0;
+
+public:
+    /**
+     * @param [in] maxAge Alter in ms, ab dem ein Wert als veraltet gilt
+     */
+    explicit SensorSnapshot(std::uint32_t maxAge) : maxAge(maxAge) {}
+
+    /**
+     * @brief Speichert eine neue Feuchtigkeitsmessung.
+     * @param [in] noiseTenths Rauschschätzung des Filters in Zehnteln ADC-Schritten, 0 bei einer Einzelmessung
+     */
+    void publishMoisture(int moisture, std::uint32_t now, std::uint16_t noiseTenths = 0)
+    {
+        reading.moisture = moisture;
+        reading.moistureNoise = noiseTenths;
+        reading.moistureTime = now;
+        reading.hasMoisture = true;
+        reading.sequence++;
+    }
+
+    /**
+     * @brief Speichert eine neue DHT-Messung. Ungültige Werte (NaN) werden gezählt, der letzte gültige Wert bleibt erhalten.
+     * @return true, wenn die Messung gültig war
+     */
+    bool publishClimate(float temperature, float humidity, std::uint32_t now)
+    {
+        climateAttemptTime = now;
+        climateAttempted = true;
+        if (std::isnan(temperature) || std::isnan(humidity)) {
+            climateErrors++;
+            return false;
+        }
+        reading.temperature = temperature;
+        reading.humidity = humidity;
+        reading.climateTime = now;
+        reading.hasClimate = true;
+        reading.sequence++;
+        return true;
+    }
+
+    /**
+     * @brief Gibt an, ob der DHT-Sensor wieder abgefragt werden darf (Mindestabstand 2 Sekunden).
+     */
+    bool isClimateDue(std::uint32_t now) const
+    {
+        return !climateAttempted || now - climateAttemptTime >= DHT_MIN_PERIOD;
+    }
+
+    const SensorReading &get() const { return reading; }
+
+    std::uint32_t getMoistureAge(std::uint32_t now) const { return reading.hasMoisture ? now - reading.moistureTime : UINT32_MAX; }
+    std::uint32_t getClimateAge(std::uint32_t now) const { return reading.hasClimate ? now - reading.climateTime : UINT32_MAX; }
+    bool isMoistureStale(std::uint32_t now) const { return getMoistureAge(now) > maxAge; }
+    bool isClimateStale(std::uint32_t now) const { return getClimateAge(now) > maxAge; }
+    std::uint32_t getClimateErrors() const { return climateErrors; }
+};
+
+#endif //SENSOR_SNAPSHOT_HPP__
@@ -0,0 +1,270 @@
+// Sonnenblumen-Sprites des Standby-Bildschirms, erzeugt von tools/sprite_gen.cpp (nicht von Hand bearbeiten)
+/**
+ * @file sunflower_sprites.h
+*/
+
+#ifndef SUNFLOWER_SPRITES_H__
+#define SUNFLOWER_SPRITES_H__
+
+#include "rle_sprite.hpp"
+
+// Palettenindizes: 0 Hintergrund (auch Augen und Mund), 1 Blütenblätter, 2 Gesicht, 3 Stiel und Blätter
+
+static const std::uint16_t SUNFLOWER_HAPPY_RUNS[1007] = {
+    0x004c, 0x4009, 0x0095, 0x400f, 0x0090, 0x4013, 0x008c, 0x4017, 0x0089, 0x4019, 0x0087, 0x401b,
+    0x0085, 0x401d, 0x0083, 0x401f, 0x0081, 0x4021, 0x006e, 0x4009, 0x0008, 0x4023, 0x0008, 0x4009,
+    0x0059, 0x400f, 0x0005, 0x4023, 0x0005, 0x400f, 0x0054, 0x4013, 0x0002, 0x4025, 0x0002, 0x4013,
+    0x0050, 0x4053, 0x004d, 0x4055, 0x004b, 0x4057, 0x0049, 0x4059, 0x0047, 0x405b, 0x0045, 0x405d,
+    0x0043, 0x405f, 0x0042, 0x405f, 0x0041, 0x4061, 0x0040, 0x4061, 0x003f, 0x4063, 0x003e, 0x4063,
+    0x003e, 0x4063, 0x003d, 0x4065, 0x003c, 0x4065, 0x003c, 0x4065, 0x003c, 0x4065, 0x003c, 0x4065,
+    0x0037, 0x4030, 0x800f, 0x4030, 0x002f, 0x402e, 0x8019, 0x402e, 0x002a, 0x402d, 0x801f, 0x402d,
+    0x0026, 0x402c, 0x8025, 0x402c, 0x0023, 0x402b, 0x8029, 0x402b, 0x0021, 0x402a, 0x802d, 0x402a,
+    0x001f, 0x4029, 0x8031, 0x4029, 0x001d, 0x4028, 0x8035, 0x4028, 0x001b, 0x4027, 0x8039, 0x4027,
+    0x0019, 0x4027, 0x803b, 0x4027, 0x0018, 0x4026, 0x803d, 0x4026, 0x0017, 0x4025, 0x8041, 0x4025,
+    0x0016, 0x4024, 0x8043, 0x4024, 0x0015, 0x4024, 0x8045, 0x4024, 0x0014, 0x4023, 0x8047, 0x4023,
+    0x0014, 0x4022, 0x8049, 0x4022, 0x0013, 0x4022, 0x804b, 0x4022, 0x0012, 0x4021, 0x804d, 0x4021,
+    0x0012, 0x4020, 0x804f, 0x4020, 0x0012, 0x4020, 0x804f, 0x4020, 0x0012, 0x401f, 0x8051, 0x401f,
+    0x0012, 0x401e, 0x8053, 0x401e, 0x0012, 0x401d, 0x8055, 0x401d, 0x0012, 0x401d, 0x8055, 0x401d,
+    0x0012, 0x401c, 0x8057, 0x401c, 0x0013, 0x401b, 0x8057, 0x401b, 0x0014, 0x401a, 0x8059, 0x401a,
+    0x0014, 0x401a, 0x8059, 0x401a, 0x0015, 0x4018, 0x805b, 0x4018, 0x0016, 0x4018, 0x805b, 0x4018,
+    0x0017, 0x4016, 0x805d, 0x4016, 0x0018, 0x4016, 0x805d, 0x4016, 0x0017, 0x4016, 0x8014, 0x0005,
+    0x802d, 0x0005, 0x8014, 0x4016, 0x0014, 0x4018, 0x8012, 0x0009, 0x8029, 0x0009, 0x8012, 0x4018,
+    0x0011, 0x4019, 0x8011, 0x000b, 0x8027, 0x000b, 0x8011, 0x4019, 0x000f, 0x4019, 0x8012, 0x000b,
+    0x8027, 0x000b, 0x8012, 0x4019, 0x000d, 0x401a, 0x8011, 0x000d, 0x8025, 0x000d, 0x8011, 0x401a,
+    0x000b, 0x401b, 0x8011, 0x000d, 0x8025, 0x000d, 0x8011, 0x401b, 0x0009, 0x401b, 0x8012, 0x000d,
+    0x8025, 0x000d, 0x8012, 0x401b, 0x0007, 0x401c, 0x8012, 0x000d, 0x8025, 0x000d, 0x8012, 0x401c,
+    0x0006, 0x401c, 0x8012, 0x000d, 0x8025, 0x000d, 0x8012, 0x401c, 0x0005, 0x401d, 0x8013, 0x000b,
+    0x8027, 0x000b, 0x8013, 0x401d, 0x0004, 0x401d, 0x8013, 0x000b, 0x8027, 0x000b, 0x8013, 0x401d,
+    0x0003, 0x401d, 0x8015, 0x0009, 0x8029, 0x0009, 0x8015, 0x401d, 0x0002, 0x401d, 0x8017, 0x0005,
+    0x802d, 0x0005, 0x8017, 0x401d, 0x0002, 0x401d, 0x8065, 0x401d, 0x0001, 0x401e, 0x8065, 0x403c,
+    0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c,
+    0x8065, 0x403c, 0x8065, 0x401e, 0x0001, 0x401d, 0x8065, 0x401d, 0x0002, 0x401d, 0x8065, 0x401d,
+    0x0002, 0x401d, 0x8065, 0x401d, 0x0003, 0x401d, 0x8063, 0x401d, 0x0004, 0x401d, 0x8063, 0x401d,
+    0x0005, 0x401c, 0x8063, 0x401c, 0x0006, 0x401c, 0x8063, 0x401c, 0x0007, 0x401b, 0x8063, 0x401b,
+    0x0009, 0x401b, 0x8061, 0x401b, 0x000b, 0x401a, 0x8061, 0x401a, 0x000d, 0x4019, 0x8061, 0x4019,
+    0x000f, 0x4019, 0x805f, 0x4019, 0x0011, 0x4018, 0x805f, 0x4018, 0x0014, 0x4016, 0x805f, 0x4016,
+    0x0017, 0x4016, 0x805d, 0x4016, 0x0018, 0x4016, 0x8014, 0x0004, 0x802d, 0x0004, 0x8014, 0x4016,
+    0x0017, 0x4018, 0x8013, 0x0004, 0x802d, 0x0004, 0x8013, 0x4018, 0x0016, 0x4018, 0x8013, 0x0004,
+    0x802d, 0x0004, 0x8013, 0x4018, 0x0015, 0x401a, 0x8012, 0x0004, 0x802d, 0x0004, 0x8012, 0x401a,
+    0x0014, 0x401a, 0x8012, 0x0004, 0x802d, 0x0004, 0x8012, 0x401a, 0x0014, 0x401b, 0x8011, 0x0004,
+    0x802d, 0x0004, 0x8011, 0x401b, 0x0013, 0x401c, 0x8012, 0x0003, 0x802d, 0x0003, 0x8012, 0x401c,
+    0x0012, 0x401d, 0x8011, 0x0004, 0x802b, 0x0004, 0x8011, 0x401d, 0x0012, 0x401d, 0x8011, 0x0004,
+    0x802b, 0x0004, 0x8011, 0x401d, 0x0012, 0x401e, 0x8011, 0x0003, 0x802b, 0x0003, 0x8011, 0x401e,
+    0x0012, 0x401f, 0x8010, 0x0004, 0x8029, 0x0004, 0x8010, 0x401f, 0x0012, 0x4020, 0x800f, 0x0004,
+    0x8029, 0x0004, 0x800f, 0x4020, 0x0012, 0x4020, 0x8010, 0x0004, 0x8027, 0x0004, 0x8010, 0x4020,
+    0x0012, 0x4021, 0x800f, 0x0005, 0x8025, 0x0005, 0x800f, 0x4021, 0x0012, 0x4022, 0x800f, 0x0004,
+    0x8025, 0x0004, 0x800f, 0x4022, 0x0013, 0x4022, 0x800f, 0x0004, 0x8023, 0x0004, 0x800f, 0x4022,
+    0x0014, 0x4023, 0x800e, 0x0005, 0x8021, 0x0005, 0x800e, 0x4023, 0x0014, 0x4024, 0x800e, 0x0005,
+    0x801f, 0x0005, 0x800e, 0x4024, 0x0015, 0x4024, 0x800e, 0x0005, 0x801d, 0x0005, 0x800e, 0x4024,
+    0x0016, 0x4025, 0x800e, 0x0006, 0x8019, 0x0006, 0x800e, 0x4025, 0x0017, 0x4026, 0x800d, 0x0006,
+    0x8017, 0x0006, 0x800d, 0x4026, 0x0018, 0x4027, 0x800d, 0x0007, 0x8013, 0x0007, 0x800d, 0x4027,
+    0x0019, 0x4027, 0x800e, 0x0008, 0x800d, 0x0008, 0x800e, 0x4027, 0x001b, 0x4028, 0x800d, 0x001b,
+    0x800d, 0x4028, 0x001d, 0x4029, 0x800d, 0x0017, 0x800d, 0x4029, 0x001f, 0x402a, 0x800e, 0x0011,
+    0x800e, 0x402a, 0x0021, 0x402b, 0x800f, 0x000b, 0x800f, 0x402b, 0x0023, 0x402c, 0x8025, 0x402c,
+    0x0026, 0x402d, 0x801f, 0x402d, 0x002a, 0x402e, 0x8019, 0x402e, 0x002f, 0x4030, 0x8001, 0xc00c,
+    0x8002, 0x4030, 0x0037, 0x402c, 0xc00c, 0x402d, 0x003c, 0x402c, 0xc00c, 0x402d, 0x003c, 0x402c,
+    0xc00c, 0x402d, 0x003c, 0x402c, 0xc00c, 0x402d, 0x003c, 0x402c, 0xc00c, 0x402d, 0x003d, 0x402b,
+    0xc00c, 0x402c, 0x003e, 0x402b, 0xc00c, 0x402c, 0x003e, 0x402b, 0xc00c, 0x402c, 0x003f, 0x402a,
+    0xc00c, 0x402b, 0x0040, 0x402a, 0xc00c, 0x402b, 0x0041, 0x4029, 0xc00c, 0x402a, 0x0042, 0x4029,
+    0xc00c, 0x402a, 0x0043, 0x4028, 0xc00c, 0x4029, 0x0045, 0x4027, 0xc00c, 0x4028, 0x0047, 0x4026,
+    0xc00c, 0x4027, 0x0049, 0x4025, 0xc00c, 0x4026, 0x004b, 0x4024, 0xc00c, 0x4025, 0x004d, 0x4023,
+    0xc00c, 0x4024, 0x0050, 0x4013, 0x0002, 0x400c, 0xc00c, 0x400d, 0x0002, 0x4013, 0x0054, 0x400f,
+    0x0005, 0x400b, 0xc00c, 0x400c, 0x0005, 0x400f, 0x0059, 0x4009, 0x0008, 0x400b, 0xc00c, 0x400c,
+    0x0008, 0x4009, 0x006e, 0x400a, 0xc00c, 0x400b, 0x0081, 0x4009, 0xc00c, 0x400a, 0x0083, 0x4008,
+    0xc00c, 0x4009, 0x0085, 0x4007, 0xc00c, 0x4008, 0x0087, 0x4006, 0xc00c, 0x4007, 0x0089, 0x4005,
+    0xc00c, 0x4006, 0x008c, 0x4003, 0xc00c, 0x4004, 0x0090, 0x4001, 0xc00c, 0x4002, 0x0093, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0073, 0xc001, 0x0021, 0xc00c, 0x0022, 0xc001, 0x0046, 0xc015,
+    0x0017, 0xc00c, 0x0018, 0xc015, 0x0038, 0xc01d, 0x0013, 0xc00c, 0x0014, 0xc01d, 0x0030, 0xc025,
+    0x000f, 0xc00c, 0x0010, 0xc025, 0x002a, 0xc029, 0x000d, 0xc00c, 0x000e, 0xc029, 0x0026, 0xc02d,
+    0x000b, 0xc00c, 0x000c, 0xc02d, 0x0022, 0xc031, 0x0009, 0xc00c, 0x000a, 0xc031, 0x001f, 0xc033,
+    0x0008, 0xc00c, 0x0009, 0xc033, 0x001d, 0xc035, 0x0007, 0xc00c, 0x0008, 0xc035, 0x001b, 0xc037,
+    0x0006, 0xc00c, 0x0007, 0xc037, 0x0019, 0xc039, 0x0005, 0xc00c, 0x0006, 0xc039, 0x0018, 0xc039,
+    0x0005, 0xc00c, 0x0006, 0xc039, 0x0017, 0xc03b, 0x0004, 0xc00c, 0x0005, 0xc03b, 0x0016, 0xc03b,
+    0x0004, 0xc00c, 0x0005, 0xc03b, 0x0016, 0xc03b, 0x0004, 0xc00c, 0x0005, 0xc03b, 0x0015, 0xc03d,
+    0x0003, 0xc00c, 0x0004, 0xc03d, 0x0015, 0xc03b, 0x0004, 0xc00c, 0x0005, 0xc03b, 0x0016, 0xc03b,
+    0x0004, 0xc00c, 0x0005, 0xc03b, 0x0016, 0xc03b, 0x0004, 0xc00c, 0x0005, 0xc03b, 0x0017, 0xc039,
+    0x0005, 0xc00c, 0x0006, 0xc039, 0x0018, 0xc039, 0x0005, 0xc00c, 0x0006, 0xc039, 0x0019, 0xc037,
+    0x0006, 0xc00c, 0x0007, 0xc037, 0x001b, 0xc035, 0x0007, 0xc00c, 0x0008, 0xc035, 0x001d, 0xc033,
+    0x0008, 0xc00c, 0x0009, 0xc033, 0x001f, 0xc031, 0x0009, 0xc00c, 0x000a, 0xc031, 0x0022, 0xc02d,
+    0x000b, 0xc00c, 0x000c, 0xc02d, 0x0026, 0xc029, 0x000d, 0xc00c, 0x000e, 0xc029, 0x002a, 0xc025,
+    0x000f, 0xc00c, 0x0010, 0xc025, 0x0030, 0xc01d, 0x0013, 0xc00c, 0x0014, 0xc01d, 0x0038, 0xc015,
+    0x0017, 0xc00c, 0x0018, 0xc015, 0x0046, 0xc001, 0x0021, 0xc00c, 0x0022, 0xc001, 0x0072, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x004b
+};
+static const RleSprite SUNFLOWER_HAPPY = {80, 10, 161, 230, SUNFLOWER_HAPPY_RUNS, 1007};
+
+static const std::uint16_t SUNFLOWER_NEUTRAL_RUNS[915] = {
+    0x004c, 0x4009, 0x0095, 0x400f, 0x0090, 0x4013, 0x008c, 0x4017, 0x0089, 0x4019, 0x0087, 0x401b,
+    0x0085, 0x401d, 0x0083, 0x401f, 0x0081, 0x4021, 0x006e, 0x4009, 0x0008, 0x4023, 0x0008, 0x4009,
+    0x0059, 0x400f, 0x0005, 0x4023, 0x0005, 0x400f, 0x0054, 0x4013, 0x0002, 0x4025, 0x0002, 0x4013,
+    0x0050, 0x4053, 0x004d, 0x4055, 0x004b, 0x4057, 0x0049, 0x4059, 0x0047, 0x405b, 0x0045, 0x405d,
+    0x0043, 0x405f, 0x0042, 0x405f, 0x0041, 0x4061, 0x0040, 0x4061, 0x003f, 0x4063, 0x003e, 0x4063,
+    0x003e, 0x4063, 0x003d, 0x4065, 0x003c, 0x4065, 0x003c, 0x4065, 0x003c, 0x4065, 0x003c, 0x4065,
+    0x0037, 0x4030, 0x800f, 0x4030, 0x002f, 0x402e, 0x8019, 0x402e, 0x002a, 0x402d, 0x801f, 0x402d,
+    0x0026, 0x402c, 0x8025, 0x402c, 0x0023, 0x402b, 0x8029, 0x402b, 0x0021, 0x402a, 0x802d, 0x402a,
+    0x001f, 0x4029, 0x8031, 0x4029, 0x001d, 0x4028, 0x8035, 0x4028, 0x001b, 0x4027, 0x8039, 0x4027,
+    0x0019, 0x4027, 0x803b, 0x4027, 0x0018, 0x4026, 0x803d, 0x4026, 0x0017, 0x4025, 0x8041, 0x4025,
+    0x0016, 0x4024, 0x8043, 0x4024, 0x0015, 0x4024, 0x8045, 0x4024, 0x0014, 0x4023, 0x8047, 0x4023,
+    0x0014, 0x4022, 0x8049, 0x4022, 0x0013, 0x4022, 0x804b, 0x4022, 0x0012, 0x4021, 0x804d, 0x4021,
+    0x0012, 0x4020, 0x804f, 0x4020, 0x0012, 0x4020, 0x804f, 0x4020, 0x0012, 0x401f, 0x8051, 0x401f,
+    0x0012, 0x401e, 0x8053, 0x401e, 0x0012, 0x401d, 0x8055, 0x401d, 0x0012, 0x401d, 0x8055, 0x401d,
+    0x0012, 0x401c, 0x8057, 0x401c, 0x0013, 0x401b, 0x8057, 0x401b, 0x0014, 0x401a, 0x8059, 0x401a,
+    0x0014, 0x401a, 0x8059, 0x401a, 0x0015, 0x4018, 0x805b, 0x4018, 0x0016, 0x4018, 0x805b, 0x4018,
+    0x0017, 0x4016, 0x805d, 0x4016, 0x0018, 0x4016, 0x805d, 0x4016, 0x0017, 0x4016, 0x8014, 0x0005,
+    0x802d, 0x0005, 0x8014, 0x4016, 0x0014, 0x4018, 0x8012, 0x0009, 0x8029, 0x0009, 0x8012, 0x4018,
+    0x0011, 0x4019, 0x8011, 0x000b, 0x8027, 0x000b, 0x8011, 0x4019, 0x000f, 0x4019, 0x8012, 0x000b,
+    0x8027, 0x000b, 0x8012, 0x4019, 0x000d, 0x401a, 0x8011, 0x000d, 0x8025, 0x000d, 0x8011, 0x401a,
+    0x000b, 0x401b, 0x8011, 0x000d, 0x8025, 0x000d, 0x8011, 0x401b, 0x0009, 0x401b, 0x8012, 0x000d,
+    0x8025, 0x000d, 0x8012, 0x401b, 0x0007, 0x401c, 0x8012, 0x000d, 0x8025, 0x000d, 0x8012, 0x401c,
+    0x0006, 0x401c, 0x8012, 0x000d, 0x8025, 0x000d, 0x8012, 0x401c, 0x0005, 0x401d, 0x8013, 0x000b,
+    0x8027, 0x000b, 0x8013, 0x401d, 0x0004, 0x401d, 0x8013, 0x000b, 0x8027, 0x000b, 0x8013, 0x401d,
+    0x0003, 0x401d, 0x8015, 0x0009, 0x8029, 0x0009, 0x8015, 0x401d, 0x0002, 0x401d, 0x8017, 0x0005,
+    0x802d, 0x0005, 0x8017, 0x401d, 0x0002, 0x401d, 0x8065, 0x401d, 0x0001, 0x401e, 0x8065, 0x403c,
+    0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c,
+    0x8065, 0x403c, 0x8065, 0x401e, 0x0001, 0x401d, 0x8065, 0x401d, 0x0002, 0x401d, 0x8065, 0x401d,
+    0x0002, 0x401d, 0x8065, 0x401d, 0x0003, 0x401d, 0x8063, 0x401d, 0x0004, 0x401d, 0x8063, 0x401d,
+    0x0005, 0x401c, 0x8063, 0x401c, 0x0006, 0x401c, 0x8063, 0x401c, 0x0007, 0x401b, 0x8063, 0x401b,
+    0x0009, 0x401b, 0x8061, 0x401b, 0x000b, 0x401a, 0x8061, 0x401a, 0x000d, 0x4019, 0x8061, 0x4019,
+    0x000f, 0x4019, 0x805f, 0x4019, 0x0011, 0x4018, 0x805f, 0x4018, 0x0014, 0x4016, 0x8016, 0x0032,
+    0x8017, 0x4016, 0x0017, 0x4016, 0x8015, 0x0032, 0x8016, 0x4016, 0x0018, 0x4016, 0x8015, 0x0032,
+    0x8016, 0x4016, 0x0017, 0x4018, 0x8014, 0x0032, 0x8015, 0x4018, 0x0016, 0x4018, 0x805b, 0x4018,
+    0x0015, 0x401a, 0x8059, 0x401a, 0x0014, 0x401a, 0x8059, 0x401a, 0x0014, 0x401b, 0x8057, 0x401b,
+    0x0013, 0x401c, 0x8057, 0x401c, 0x0012, 0x401d, 0x8055, 0x401d, 0x0012, 0x401d, 0x8055, 0x401d,
+    0x0012, 0x401e, 0x8053, 0x401e, 0x0012, 0x401f, 0x8051, 0x401f, 0x0012, 0x4020, 0x804f, 0x4020,
+    0x0012, 0x4020, 0x804f, 0x4020, 0x0012, 0x4021, 0x804d, 0x4021, 0x0012, 0x4022, 0x804b, 0x4022,
+    0x0013, 0x4022, 0x8049, 0x4022, 0x0014, 0x4023, 0x8047, 0x4023, 0x0014, 0x4024, 0x8045, 0x4024,
+    0x0015, 0x4024, 0x8043, 0x4024, 0x0016, 0x4025, 0x8041, 0x4025, 0x0017, 0x4026, 0x803d, 0x4026,
+    0x0018, 0x4027, 0x803b, 0x4027, 0x0019, 0x4027, 0x8039, 0x4027, 0x001b, 0x4028, 0x8035, 0x4028,
+    0x001d, 0x4029, 0x8031, 0x4029, 0x001f, 0x402a, 0x802d, 0x402a, 0x0021, 0x402b, 0x8029, 0x402b,
+    0x0023, 0x402c, 0x8025, 0x402c, 0x0026, 0x402d, 0x801f, 0x402d, 0x002a, 0x402e, 0x8019, 0x402e,
+    0x002f, 0x4030, 0x8001, 0xc00c, 0x8002, 0x4030, 0x0037, 0x402c, 0xc00c, 0x402d, 0x003c, 0x402c,
+    0xc00c, 0x402d, 0x003c, 0x402c, 0xc00c, 0x402d, 0x003c, 0x402c, 0xc00c, 0x402d, 0x003c, 0x402c,
+    0xc00c, 0x402d, 0x003d, 0x402b, 0xc00c, 0x402c, 0x003e, 0x402b, 0xc00c, 0x402c, 0x003e, 0x402b,
+    0xc00c, 0x402c, 0x003f, 0x402a, 0xc00c, 0x402b, 0x0040, 0x402a, 0xc00c, 0x402b, 0x0041, 0x4029,
+    0xc00c, 0x402a, 0x0042, 0x4029, 0xc00c, 0x402a, 0x0043, 0x4028, 0xc00c, 0x4029, 0x0045, 0x4027,
+    0xc00c, 0x4028, 0x0047, 0x4026, 0xc00c, 0x4027, 0x0049, 0x4025, 0xc00c, 0x4026, 0x004b, 0x4024,
+    0xc00c, 0x4025, 0x004d, 0x4023, 0xc00c, 0x4024, 0x0050, 0x4013, 0x0002, 0x400c, 0xc00c, 0x400d,
+    0x0002, 0x4013, 0x0054, 0x400f, 0x0005, 0x400b, 0xc00c, 0x400c, 0x0005, 0x400f, 0x0059, 0x4009,
+    0x0008, 0x400b, 0xc00c, 0x400c, 0x0008, 0x4009, 0x006e, 0x400a, 0xc00c, 0x400b, 0x0081, 0x4009,
+    0xc00c, 0x400a, 0x0083, 0x4008, 0xc00c, 0x4009, 0x0085, 0x4007, 0xc00c, 0x4008, 0x0087, 0x4006,
+    0xc00c, 0x4007, 0x0089, 0x4005, 0xc00c, 0x4006, 0x008c, 0x4003, 0xc00c, 0x4004, 0x0090, 0x4001,
+    0xc00c, 0x4002, 0x0093, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0073, 0xc001, 0x0021, 0xc00c,
+    0x0022, 0xc001, 0x0046, 0xc015, 0x0017, 0xc00c, 0x0018, 0xc015, 0x0038, 0xc01d, 0x0013, 0xc00c,
+    0x0014, 0xc01d, 0x0030, 0xc025, 0x000f, 0xc00c, 0x0010, 0xc025, 0x002a, 0xc029, 0x000d, 0xc00c,
+    0x000e, 0xc029, 0x0026, 0xc02d, 0x000b, 0xc00c, 0x000c, 0xc02d, 0x0022, 0xc031, 0x0009, 0xc00c,
+    0x000a, 0xc031, 0x001f, 0xc033, 0x0008, 0xc00c, 0x0009, 0xc033, 0x001d, 0xc035, 0x0007, 0xc00c,
+    0x0008, 0xc035, 0x001b, 0xc037, 0x0006, 0xc00c, 0x0007, 0xc037, 0x0019, 0xc039, 0x0005, 0xc00c,
+    0x0006, 0xc039, 0x0018, 0xc039, 0x0005, 0xc00c, 0x0006, 0xc039, 0x0017, 0xc03b, 0x0004, 0xc00c,
+    0x0005, 0xc03b, 0x0016, 0xc03b, 0x0004, 0xc00c, 0x0005, 0xc03b, 0x0016, 0xc03b, 0x0004, 0xc00c,
+    0x0005, 0xc03b, 0x0015, 0xc03d, 0x0003, 0xc00c, 0x0004, 0xc03d, 0x0015, 0xc03b, 0x0004, 0xc00c,
+    0x0005, 0xc03b, 0x0016, 0xc03b, 0x0004, 0xc00c, 0x0005, 0xc03b, 0x0016, 0xc03b, 0x0004, 0xc00c,
+    0x0005, 0xc03b, 0x0017, 0xc039, 0x0005, 0xc00c, 0x0006, 0xc039, 0x0018, 0xc039, 0x0005, 0xc00c,
+    0x0006, 0xc039, 0x0019, 0xc037, 0x0006, 0xc00c, 0x0007, 0xc037, 0x001b, 0xc035, 0x0007, 0xc00c,
+    0x0008, 0xc035, 0x001d, 0xc033, 0x0008, 0xc00c, 0x0009, 0xc033, 0x001f, 0xc031, 0x0009, 0xc00c,
+    0x000a, 0xc031, 0x0022, 0xc02d, 0x000b, 0xc00c, 0x000c, 0xc02d, 0x0026, 0xc029, 0x000d, 0xc00c,
+    0x000e, 0xc029, 0x002a, 0xc025, 0x000f, 0xc00c, 0x0010, 0xc025, 0x0030, 0xc01d, 0x0013, 0xc00c,
+    0x0014, 0xc01d, 0x0038, 0xc015, 0x0017, 0xc00c, 0x0018, 0xc015, 0x0046, 0xc001, 0x0021, 0xc00c,
+    0x0022, 0xc001, 0x0072, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x004b
+};
+static const RleSprite SUNFLOWER_NEUTRAL = {80, 10, 161, 230, SUNFLOWER_NEUTRAL_RUNS, 915};
+
+static const std::uint16_t SUNFLOWER_SAD_RUNS[1007] = {
+    0x004c, 0x4009, 0x0095, 0x400f, 0x0090, 0x4013, 0x008c, 0x4017, 0x0089, 0x4019, 0x0087, 0x401b,
+    0x0085, 0x401d, 0x0083, 0x401f, 0x0081, 0x4021, 0x006e, 0x4009, 0x0008, 0x4023, 0x0008, 0x4009,
+    0x0059, 0x400f, 0x0005, 0x4023, 0x0005, 0x400f, 0x0054, 0x4013, 0x0002, 0x4025, 0x0002, 0x4013,
+    0x0050, 0x4053, 0x004d, 0x4055, 0x004b, 0x4057, 0x0049, 0x4059, 0x0047, 0x405b, 0x0045, 0x405d,
+    0x0043, 0x405f, 0x0042, 0x405f, 0x0041, 0x4061, 0x0040, 0x4061, 0x003f, 0x4063, 0x003e, 0x4063,
+    0x003e, 0x4063, 0x003d, 0x4065, 0x003c, 0x4065, 0x003c, 0x4065, 0x003c, 0x4065, 0x003c, 0x4065,
+    0x0037, 0x4030, 0x800f, 0x4030, 0x002f, 0x402e, 0x8019, 0x402e, 0x002a, 0x402d, 0x801f, 0x402d,
+    0x0026, 0x402c, 0x8025, 0x402c, 0x0023, 0x402b, 0x8029, 0x402b, 0x0021, 0x402a, 0x802d, 0x402a,
+    0x001f, 0x4029, 0x8031, 0x4029, 0x001d, 0x4028, 0x8035, 0x4028, 0x001b, 0x4027, 0x8039, 0x4027,
+    0x0019, 0x4027, 0x803b, 0x4027, 0x0018, 0x4026, 0x803d, 0x4026, 0x0017, 0x4025, 0x8041, 0x4025,
+    0x0016, 0x4024, 0x8043, 0x4024, 0x0015, 0x4024, 0x8045, 0x4024, 0x0014, 0x4023, 0x8047, 0x4023,
+    0x0014, 0x4022, 0x8049, 0x4022, 0x0013, 0x4022, 0x804b, 0x4022, 0x0012, 0x4021, 0x804d, 0x4021,
+    0x0012, 0x4020, 0x804f, 0x4020, 0x0012, 0x4020, 0x804f, 0x4020, 0x0012, 0x401f, 0x8051, 0x401f,
+    0x0012, 0x401e, 0x8053, 0x401e, 0x0012, 0x401d, 0x8055, 0x401d, 0x0012, 0x401d, 0x8055, 0x401d,
+    0x0012, 0x401c, 0x8057, 0x401c, 0x0013, 0x401b, 0x8057, 0x401b, 0x0014, 0x401a, 0x8059, 0x401a,
+    0x0014, 0x401a, 0x8059, 0x401a, 0x0015, 0x4018, 0x805b, 0x4018, 0x0016, 0x4018, 0x805b, 0x4018,
+    0x0017, 0x4016, 0x805d, 0x4016, 0x0018, 0x4016, 0x805d, 0x4016, 0x0017, 0x4016, 0x8014, 0x0005,
+    0x802d, 0x0005, 0x8014, 0x4016, 0x0014, 0x4018, 0x8012, 0x0009, 0x8029, 0x0009, 0x8012, 0x4018,
+    0x0011, 0x4019, 0x8011, 0x000b, 0x8027, 0x000b, 0x8011, 0x4019, 0x000f, 0x4019, 0x8012, 0x000b,
+    0x8027, 0x000b, 0x8012, 0x4019, 0x000d, 0x401a, 0x8011, 0x000d, 0x8025, 0x000d, 0x8011, 0x401a,
+    0x000b, 0x401b, 0x8011, 0x000d, 0x8025, 0x000d, 0x8011, 0x401b, 0x0009, 0x401b, 0x8012, 0x000d,
+    0x8025, 0x000d, 0x8012, 0x401b, 0x0007, 0x401c, 0x8012, 0x000d, 0x8025, 0x000d, 0x8012, 0x401c,
+    0x0006, 0x401c, 0x8012, 0x000d, 0x8025, 0x000d, 0x8012, 0x401c, 0x0005, 0x401d, 0x8013, 0x000b,
+    0x8027, 0x000b, 0x8013, 0x401d, 0x0004, 0x401d, 0x8013, 0x000b, 0x8027, 0x000b, 0x8013, 0x401d,
+    0x0003, 0x401d, 0x8015, 0x0009, 0x8029, 0x0009, 0x8015, 0x401d, 0x0002, 0x401d, 0x8017, 0x0005,
+    0x802d, 0x0005, 0x8017, 0x401d, 0x0002, 0x401d, 0x8065, 0x401d, 0x0001, 0x401e, 0x8065, 0x403c,
+    0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c, 0x8065, 0x403c,
+    0x8065, 0x403c, 0x802d, 0x000b, 0x802d, 0x401e, 0x0001, 0x401d, 0x802a, 0x0011, 0x802a, 0x401d,
+    0x0002, 0x401d, 0x8027, 0x0017, 0x8027, 0x401d, 0x0002, 0x401d, 0x8025, 0x001b, 0x8025, 0x401d,
+    0x0003, 0x401d, 0x8023, 0x0008, 0x800d, 0x0008, 0x8023, 0x401d, 0x0004, 0x401d, 0x8021, 0x0007,
+    0x8013, 0x0007, 0x8021, 0x401d, 0x0005, 0x401c, 0x8020, 0x0006, 0x8017, 0x0006, 0x8020, 0x401c,
+    0x0006, 0x401c, 0x801f, 0x0006, 0x8019, 0x0006, 0x801f, 0x401c, 0x0007, 0x401b, 0x801e, 0x0005,
+    0x801d, 0x0005, 0x801e, 0x401b, 0x0009, 0x401b, 0x801c, 0x0005, 0x801f, 0x0005, 0x801c, 0x401b,
+    0x000b, 0x401a, 0x801b, 0x0005, 0x8021, 0x0005, 0x801b, 0x401a, 0x000d, 0x4019, 0x801b, 0x0004,
+    0x8023, 0x0004, 0x801b, 0x4019, 0x000f, 0x4019, 0x8019, 0x0004, 0x8025, 0x0004, 0x8019, 0x4019,
+    0x0011, 0x4018, 0x8018, 0x0005, 0x8025, 0x0005, 0x8018, 0x4018, 0x0014, 0x4016, 0x8018, 0x0004,
+    0x8027, 0x0004, 0x8018, 0x4016, 0x0017, 0x4016, 0x8016, 0x0004, 0x8029, 0x0004, 0x8016, 0x4016,
+    0x0018, 0x4016, 0x8016, 0x0004, 0x8029, 0x0004, 0x8016, 0x4016, 0x0017, 0x4018, 0x8015, 0x0003,
+    0x802b, 0x0003, 0x8015, 0x4018, 0x0016, 0x4018, 0x8014, 0x0004, 0x802b, 0x0004, 0x8014, 0x4018,
+    0x0015, 0x401a, 0x8013, 0x0004, 0x802b, 0x0004, 0x8013, 0x401a, 0x0014, 0x401a, 0x8013, 0x0003,
+    0x802d, 0x0003, 0x8013, 0x401a, 0x0014, 0x401b, 0x8011, 0x0004, 0x802d, 0x0004, 0x8011, 0x401b,
+    0x0013, 0x401c, 0x8011, 0x0004, 0x802d, 0x0004, 0x8011, 0x401c, 0x0012, 0x401d, 0x8010, 0x0004,
+    0x802d, 0x0004, 0x8010, 0x401d, 0x0012, 0x401d, 0x8010, 0x0004, 0x802d, 0x0004, 0x8010, 0x401d,
+    0x0012, 0x401e, 0x800f, 0x0004, 0x802d, 0x0004, 0x800f, 0x401e, 0x0012, 0x401f, 0x800e, 0x0004,
+    0x802d, 0x0004, 0x800e, 0x401f, 0x0012, 0x4020, 0x804f, 0x4020, 0x0012, 0x4020, 0x804f, 0x4020,
+    0x0012, 0x4021, 0x804d, 0x4021, 0x0012, 0x4022, 0x804b, 0x4022, 0x0013, 0x4022, 0x8049, 0x4022,
+    0x0014, 0x4023, 0x8047, 0x4023, 0x0014, 0x4024, 0x8045, 0x4024, 0x0015, 0x4024, 0x8043, 0x4024,
+    0x0016, 0x4025, 0x8041, 0x4025, 0x0017, 0x4026, 0x803d, 0x4026, 0x0018, 0x4027, 0x803b, 0x4027,
+    0x0019, 0x4027, 0x8039, 0x4027, 0x001b, 0x4028, 0x8035, 0x4028, 0x001d, 0x4029, 0x8031, 0x4029,
+    0x001f, 0x402a, 0x802d, 0x402a, 0x0021, 0x402b, 0x8029, 0x402b, 0x0023, 0x402c, 0x8025, 0x402c,
+    0x0026, 0x402d, 0x801f, 0x402d, 0x002a, 0x402e, 0x8019, 0x402e, 0x002f, 0x4030, 0x8001, 0xc00c,
+    0x8002, 0x4030, 0x0037, 0x402c, 0xc00c, 0x402d, 0x003c, 0x402c, 0xc00c, 0x402d, 0x003c, 0x402c,
+    0xc00c, 0x402d, 0x003c, 0x402c, 0xc00c, 0x402d, 0x003c, 0x402c, 0xc00c, 0x402d, 0x003d, 0x402b,
+    0xc00c, 0x402c, 0x003e, 0x402b, 0xc00c, 0x402c, 0x003e, 0x402b, 0xc00c, 0x402c, 0x003f, 0x402a,
+    0xc00c, 0x402b, 0x0040, 0x402a, 0xc00c, 0x402b, 0x0041, 0x4029, 0xc00c, 0x402a, 0x0042, 0x4029,
+    0xc00c, 0x402a, 0x0043, 0x4028, 0xc00c, 0x4029, 0x0045, 0x4027, 0xc00c, 0x4028, 0x0047, 0x4026,
+    0xc00c, 0x4027, 0x0049, 0x4025, 0xc00c, 0x4026, 0x004b, 0x4024, 0xc00c, 0x4025, 0x004d, 0x4023,
+    0xc00c, 0x4024, 0x0050, 0x4013, 0x0002, 0x400c, 0xc00c, 0x400d, 0x0002, 0x4013, 0x0054, 0x400f,
+    0x0005, 0x400b, 0xc00c, 0x400c, 0x0005, 0x400f, 0x0059, 0x4009, 0x0008, 0x400b, 0xc00c, 0x400c,
+    0x0008, 0x4009, 0x006e, 0x400a, 0xc00c, 0x400b, 0x0081, 0x4009, 0xc00c, 0x400a, 0x0083, 0x4008,
+    0xc00c, 0x4009, 0x0085, 0x4007, 0xc00c, 0x4008, 0x0087, 0x4006, 0xc00c, 0x4007, 0x0089, 0x4005,
+    0xc00c, 0x4006, 0x008c, 0x4003, 0xc00c, 0x4004, 0x0090, 0x4001, 0xc00c, 0x4002, 0x0093, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0073, 0xc001, 0x0021, 0xc00c, 0x0022, 0xc001, 0x0046, 0xc015,
+    0x0017, 0xc00c, 0x0018, 0xc015, 0x0038, 0xc01d, 0x0013, 0xc00c, 0x0014, 0xc01d, 0x0030, 0xc025,
+    0x000f, 0xc00c, 0x0010, 0xc025, 0x002a, 0xc029, 0x000d, 0xc00c, 0x000e, 0xc029, 0x0026, 0xc02d,
+    0x000b, 0xc00c, 0x000c, 0xc02d, 0x0022, 0xc031, 0x0009, 0xc00c, 0x000a, 0xc031, 0x001f, 0xc033,
+    0x0008, 0xc00c, 0x0009, 0xc033, 0x001d, 0xc035, 0x0007, 0xc00c, 0x0008, 0xc035, 0x001b, 0xc037,
+    0x0006, 0xc00c, 0x0007, 0xc037, 0x0019, 0xc039, 0x0005, 0xc00c, 0x0006, 0xc039, 0x0018, 0xc039,
+    0x0005, 0xc00c, 0x0006, 0xc039, 0x0017, 0xc03b, 0x0004, 0xc00c, 0x0005, 0xc03b, 0x0016, 0xc03b,
+    0x0004, 0xc00c, 0x0005, 0xc03b, 0x0016, 0xc03b, 0x0004, 0xc00c, 0x0005, 0xc03b, 0x0015, 0xc03d,
+    0x0003, 0xc00c, 0x0004, 0xc03d, 0x0015, 0xc03b, 0x0004, 0xc00c, 0x0005, 0xc03b, 0x0016, 0xc03b,
+    0x0004, 0xc00c, 0x0005, 0xc03b, 0x0016, 0xc03b, 0x0004, 0xc00c, 0x0005, 0xc03b, 0x0017, 0xc039,
+    0x0005, 0xc00c, 0x0006, 0xc039, 0x0018, 0xc039, 0x0005, 0xc00c, 0x0006, 0xc039, 0x0019, 0xc037,
+    0x0006, 0xc00c, 0x0007, 0xc037, 0x001b, 0xc035, 0x0007, 0xc00c, 0x0008, 0xc035, 0x001d, 0xc033,
+    0x0008, 0xc00c, 0x0009, 0xc033, 0x001f, 0xc031, 0x0009, 0xc00c, 0x000a, 0xc031, 0x0022, 0xc02d,
+    0x000b, 0xc00c, 0x000c, 0xc02d, 0x0026, 0xc029, 0x000d, 0xc00c, 0x000e, 0xc029, 0x002a, 0xc025,
+    0x000f, 0xc00c, 0x0010, 0xc025, 0x0030, 0xc01d, 0x0013, 0xc00c, 0x0014, 0xc01d, 0x0038, 0xc015,
+    0x0017, 0xc00c, 0x0018, 0xc015, 0x0046, 0xc001, 0x0021, 0xc00c, 0x0022, 0xc001, 0x0072, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c,
+    0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x0095, 0xc00c, 0x004b
+};
+static const RleSprite SUNFLOWER_SAD = {80, 10, 161, 230, SUNFLOWER_SAD_RUNS, 1007};
+
+#endif //SUNFLOWER_SPRITES_H__
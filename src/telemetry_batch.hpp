@@ -0,0 +1,84 @@
+// Sammelt Messwerte für gebündelte Telemetrie-Nachrichten an den IoT Hub
+/**
+ * @file telemetry_batch.hpp
+*/
+
+#ifndef TELEMETRY_BATCH_HPP__
+#define TELEMETRY_BATCH_HPP__
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Ein Messwert für die Telemetrie
+ */
+struct TelemetrySample {
+    std::uint32_t epoch = 0; // Zeitpunkt der Messung (Epoch-Sekunden)
+    int moisture = 0;
+    float temperature = 0;
+    float humidity = 0;
+};
+
+/**
+ * @brief Fester Puffer für bis zu MAX_SAMPLES Messwerte
+ *
+ * Eine Nachricht wird fällig, sobald targetCount Messwerte gesammelt sind oder der älteste
+ * Messwert maxAgeMs alt ist. So gehen keine Messungen verloren und die Anzahl der Nachrichten
+ * (MQTT-Overhead, Hub-Kontingent) bleibt trotzdem gering.
+ */
+class TelemetryBatch
+{
+public:
+    static const std::size_t MAX_SAMPLES = 30;
+
+private:
+    TelemetrySample samples[MAX_SAMPLES];
+    std::size_t count = 0;
+    std::size_t targetCount;
+    std::uint32_t maxAgeMs;
+    std::uint32_t firstSampleTime = 0;
+    std::uint32_t overwritten = 0;
+
+public:
+    /**
+     * @param [in] targetCount Anzahl Messwerte pro Nachricht (höchstens MAX_SAMPLES)
+     * @param [in] maxAgeMs Maximales Alter des ältesten Messwerts, bevor gesendet wird
+     */
+    TelemetryBatch(std::size_t targetCount, std::uint32_t maxAgeMs)
+        : targetCount(targetCount == 0 ? 1 : (targetCount > MAX_SAMPLES ? MAX_SAMPLES : targetCount)), maxAgeMs(maxAgeMs) {}
+
+    /**
+     * @brief Fügt einen Messwert hinzu. Ist der Puffer voll, wird der älteste Wert überschrieben.
+     */
+    void add(const TelemetrySample &sample, std::uint32_t now)
+    {
+        if (count == 0) {
+            firstSampleTime = now;
+        }
+        if (count == MAX_SAMPLES) {
+            for (std::size_t i = 1; i < MAX_SAMPLES; i++) {
+                samples[i - 1] = samples[i];
+            }
+            count--;
+            overwritten++;
+        }
+        samples[count++] = sample;
+    }
+
+    /**
+     * @brief Gibt an, ob eine Nachricht gesendet werden soll.
+     */
+    bool isReady(std::uint32_t now) const
+    {
+        return count >= targetCount || (count > 0 && now - firstSampleTime >= maxAgeMs);
+    }
+
+    void clear() { count = 0; }
+
+    std::size_t size() const { return count; }
+    const TelemetrySample *data() const { return samples; }
+    const TelemetrySample &operator[](std::size_t index) const { return samples[index]; }
+    std::uint32_t getOverwritten() const { return overwritten; }
+};
+
+#endif //TELEMETRY_BATCH_HPP__
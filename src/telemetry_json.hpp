@@ -0,0 +1,112 @@
+// Serialisierung der Telemetrie-Nachrichten ohne Heap-Speicher (az_json_writer aus azure-sdk-for-c)
+/**
+ * @file telemetry_json.hpp
+*/
+
+#ifndef TELEMETRY_JSON_HPP__
+#define TELEMETRY_JSON_HPP__
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+#include <azure/core/az_json.h>
+#include <azure/core/az_span.h>
+
+#include "telemetry_batch.hpp"
+
+/**
+ * @brief Gemeinsame Gerätedaten einer Telemetrie-Nachricht
+ */
+struct TelemetryHeader {
+    const char *deviceId = "Wio";
+    double latitude = 0;
+    double longitude = 0;
+    bool queued = false;              // Nachgesendete Messwerte aus der Warteschlange
+    std::uint32_t firstSequence = 0;  // Nummer des ersten Messwerts, nur bei queued
+};
+
+// Zahl mit digits Nachkommastellen anhängen; az_json_writer schneidet ab, daher vorher runden (48.1f wäre sonst 48.09)
+inline az_result telemetryJsonAppendRounded(az_json_writer *writer, double value, int digits)
+{
+    double scale = std::pow(10.0, digits);
+    return az_json_writer_append_double(writer, std::round(value * scale) / scale, digits);
+}
+
+// Messwert als Zahl anhängen; ungültige Werte (NaN) werden wie bei ArduinoJson als null geschrieben
+inline az_result telemetryJsonAppendValue(az_json_writer *writer, float value)
+{
+    if (std::isnan(value) || std::isinf(value)) {
+        return az_json_writer_append_null(writer);
+    }
+    return telemetryJsonAppendRounded(writer, value, 2);
+}
+
+/**
+ * @brief Schreibt eine Telemetrie-Nachricht direkt in einen Puffer fester Größe.
+ *
+ * Aufbau wie bisher mit ArduinoJson: {"deviceId","latitude","longitude",["queued"],"samples":[{["seq"],"ts",
+ * "temperature","humidity","moisture"},...]}. Es wird kein Heap-Speicher verwendet, der Puffer kann statisch sein.
+ *
+ * @param [out] buffer Zielpuffer, wird mit '\0' abgeschlossen
+ * @param [in] size Größe des Puffers inklusive '\0'
+ * @return Länge der Nachricht ohne '\0' bzw. 0, wenn der Puffer nicht ausreicht
+ */
+inline std::size_t encodeTelemetryJson(const TelemetryHeader &header, const TelemetrySample *samples, std::size_t count,
+                                       char *buffer, std::size_t size)
+{
+    if (size < 2) {
+        return 0;
+    }
+    az_json_writer writer;
+    if (az_result_failed(az_json_writer_init(&writer, az_span_create(reinterpret_cast<std::uint8_t *>(buffer), static_cast<std::int32_t>(size - 1)), NULL))) {
+        return 0;
+    }
+
+    az_result result = az_json_writer_append_begin_object(&writer);
+    if (az_result_succeeded(result)) result = az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("deviceId"));
+    if (az_result_succeeded(result)) result = az_json_writer_append_string(&writer, az_span_create_from_str(const_cast<char *>(header.deviceId)));
+    if (az_result_succeeded(result)) result = az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("latitude"));
+    if (az_result_succeeded(result)) result = telemetryJsonAppendRounded(&writer, header.latitude, 5);
+    if (az_result_succeeded(result)) result = az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("longitude"));
+    if (az_result_succeeded(result)) result = telemetryJsonAppendRounded(&writer, header.longitude, 5);
+    if (az_result_succeeded(result) && header.queued) {
+        result = az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("queued"));
+        if (az_result_succeeded(result)) result = az_json_writer_append_bool(&writer, true);
+    }
+    if (az_result_succeeded(result)) result = az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("samples"));
+    if (az_result_succeeded(result)) result = az_json_writer_append_begin_array(&writer);
+
+    for (std::size_t i = 0; i < count && az_result_succeeded(result); i++) {
+        const TelemetrySample &sample = samples[i];
+        result = az_json_writer_append_begin_object(&writer);
+        // Sequenznummern und Epoch-Sekunden sind uint32 und können über INT32_MAX liegen (Epoch ab 2038),
+        // deshalb als ganzzahlige double-Werte; bis 2^53 sind diese exakt
+        if (az_result_succeeded(result) && header.queued) {
+            result = az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("seq"));
+            if (az_result_succeeded(result)) result = az_json_writer_append_double(&writer, header.firstSequence + static_cast<std::uint32_t>(i), 0);
+        }
+        if (az_result_succeeded(result)) result = az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("ts"));
+        if (az_result_succeeded(result)) result = az_json_writer_append_double(&writer, sample.epoch, 0);
+        if (az_result_succeeded(result)) result = az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("temperature"));
+        if (az_result_succeeded(result)) result = telemetryJsonAppendValue(&writer, sample.temperature);
+        if (az_result_succeeded(result)) result = az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("humidity"));
+        if (az_result_succeeded(result)) result = telemetryJsonAppendValue(&writer, sample.humidity);
+        if (az_result_succeeded(result)) result = az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("moisture"));
+        if (az_result_succeeded(result)) result = az_json_writer_append_int32(&writer, sample.moisture);
+        if (az_result_succeeded(result)) result = az_json_writer_append_end_object(&writer);
+    }
+
+    if (az_result_succeeded(result)) result = az_json_writer_append_end_array(&writer);
+    if (az_result_succeeded(result)) result = az_json_writer_append_end_object(&writer);
+    if (az_result_failed(result)) {
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    std::size_t length = static_cast<std::size_t>(az_span_size(az_json_writer_get_bytes_used_in_destination(&writer)));
+    buffer[length] = '\0';
+    return length;
+}
+
+#endif //TELEMETRY_JSON_HPP__
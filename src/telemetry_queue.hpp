@@ -0,0 +1,471 @@
+// Persistente Warteschlange für nicht gesendete Telemetrie (Store-and-Forward auf der SD-Karte)
+/**
+ * @file telemetry_queue.hpp
+*/
+
+#ifndef TELEMETRY_QUEUE_HPP__
+#define TELEMETRY_QUEUE_HPP__
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+
+#include "log_format.hpp"
+#include "telemetry_batch.hpp"
+
+/*
+ * Aufbau der Warteschlangendatei (alle Werte little-endian, Hilfsfunktionen aus log_format.hpp):
+ *
+ *   Sektor 0, 1   Kopffächer A und B: "AQTQ", uint16 version, uint16 entrySize, uint32 capacity,
+ *                 uint32 headSequence (ältester Eintrag), uint32 tailSequence (nächste Nummer),
+ *                 uint32 dropped, uint32 generation, uint32 crc32 über die ersten 28 Byte
+ *   ab Byte 1024  capacity Einträge zu je 16 Byte, Eintrag mit Nummer seq liegt in Platz seq % capacity:
+ *                   uint32 sequence, uint32 epoch, uint16 moisture, int16 Temperatur in 0,01 °C,
+ *                   int16 Luftfeuchtigkeit in 0,01 %, uint16 untere Hälfte der CRC32 über die ersten 14 Byte
+ *
+ * Gültig sind die Einträge headSequence .. tailSequence-1. Der Kopf wird erst nach den Einträgen
+ * geschrieben und ist damit die Commit-Marke, wie beim SD-Logger. Jeder Kopf geht abwechselnd in das
+ * Fach generation % 2; ein abgerissener Schreibvorgang trifft so nur ein Fach, das andere enthält den
+ * vorigen Stand. Beim Öffnen gilt der neuere gültige Kopf, danach gespeicherte Einträge werden anhand
+ * ihrer eigenen Nummer wieder angehängt. Sind beide Fächer unlesbar, wird aus den Einträgen neu aufgebaut.
+ */
+
+static const std::size_t TELEMETRY_QUEUE_ENTRY_SIZE = 16;
+static const std::uint16_t TELEMETRY_QUEUE_VERSION = 2;
+static const std::uint32_t TELEMETRY_QUEUE_HEADER_SLOTS = 2;
+static const std::uint32_t TELEMETRY_QUEUE_DATA_OFFSET = TELEMETRY_QUEUE_HEADER_SLOTS * LOG_SECTOR_SIZE;
+static const char TELEMETRY_QUEUE_MAGIC[4] = {'A', 'Q', 'T', 'Q'};
+
+/**
+ * @brief Kopf der Warteschlangendatei
+ */
+struct TelemetryQueueHeader {
+    std::uint32_t capacity = 0;     // Anzahl Plätze
+    std::uint32_t headSequence = 0; // Nummer des ältesten nicht gesendeten Eintrags
+    std::uint32_t tailSequence = 0; // Nummer des nächsten Eintrags
+    std::uint32_t dropped = 0;      // Wegen voller Warteschlange verworfene Einträge (gesamt)
+    std::uint32_t generation = 0;   // Zählt jeden geschriebenen Kopf, bestimmt das Fach
+};
+
+inline void encodeTelemetryQueueHeader(const TelemetryQueueHeader &header, std::uint8_t *sector)
+{
+    std::memset(sector, 0, LOG_SECTOR_SIZE);
+    std::memcpy(sector, TELEMETRY_QUEUE_MAGIC, 4);
+    logPutU16(sector + 4, TELEMETRY_QUEUE_VERSION);
+    logPutU16(sector + 6, TELEMETRY_QUEUE_ENTRY_SIZE);
+    logPutU32(sector + 8, header.capacity);
+    logPutU32(sector + 12, header.headSequence);
+    logPutU32(sector + 16, header.tailSequence);
+    logPutU32(sector + 20, header.dropped);
+    logPutU32(sector + 24, header.generation);
+    logPutU32(sector + 28, logCrc32(sector, 28));
+}
+
+/**
+ * @return false bei falscher Kennung, Version, Eintragsgröße oder CRC
+ */
+inline bool decodeTelemetryQueueHeader(const std::uint8_t *sector, TelemetryQueueHeader &header)
+{
+    if (std::memcmp(sector, TELEMETRY_QUEUE_MAGIC, 4) != 0 || logGetU32(sector + 28) != logCrc32(sector, 28)
+        || logGetU16(sector + 4) != TELEMETRY_QUEUE_VERSION || logGetU16(sector + 6) != TELEMETRY_QUEUE_ENTRY_SIZE) {
+        return false;
+    }
+    header.capacity = logGetU32(sector + 8);
+    header.headSequence = logGetU32(sector + 12);
+    header.tailSequence = logGetU32(sector + 16);
+    header.dropped = logGetU32(sector + 20);
+    header.generation = logGetU32(sector + 24);
+    return header.capacity > 0 && header.tailSequence - header.headSequence <= header.capacity;
+}
+
+/**
+ * @brief Nächste freie Nummer aus einem Kopf der Version 1 (ein Kopf in Sektor 0, CRC über 24 Byte).
+ * @return false, wenn der Sektor keinen gültigen Kopf der Version 1 enthält
+ */
+inline bool decodeTelemetryQueueHeaderV1Tail(const std::uint8_t *sector, std::uint32_t &tailSequence)
+{
+    if (std::memcmp(sector, TELEMETRY_QUEUE_MAGIC, 4) != 0 || logGetU16(sector + 4) != 1 || logGetU32(sector + 24) != logCrc32(sector, 24)) {
+        return false;
+    }
+    tailSequence = logGetU32(sector + 16);
+    return true;
+}
+
+/**
+ * @brief Wählt aus den beiden Fächern den neueren gültigen Kopf.
+ * @return false, wenn keines der Fächer einen gültigen Kopf enthält
+ */
+inline bool selectTelemetryQueueHeader(const std::uint8_t *slotA, const std::uint8_t *slotB, TelemetryQueueHeader &header)
+{
+    TelemetryQueueHeader a;
+    TelemetryQueueHeader b;
+    bool validA = decodeTelemetryQueueHeader(slotA, a);
+    bool validB = decodeTelemetryQueueHeader(slotB, b);
+    if (validA && validB) {
+        // Vergleich, der den Überlauf der Generation übersteht
+        header = static_cast<std::int32_t>(b.generation - a.generation) > 0 ? b : a;
+    } else if (validA || validB) {
+        header = validA ? a : b;
+    }
+    return validA || validB;
+}
+
+/**
+ * @brief Erste Nummer einer neu angelegten Warteschlange: nach lastTail fortlaufend, damit ein Empfänger, der
+ *        Doppelte an der Nummer erkennt, keine neuen Messwerte verwirft, und ein Vielfaches der Kapazität, damit
+ *        die Datei beim ersten Umlauf nur am Ende wächst.
+ */
+inline std::uint32_t telemetryQueueFirstSequence(std::uint32_t lastTail, std::uint32_t capacity)
+{
+    std::uint32_t rest = lastTail % capacity;
+    return rest == 0 ? lastTail : lastTail + (capacity - rest);
+}
+
+inline void encodeTelemetryQueueEntry(std::uint32_t sequence, const TelemetrySample &sample, std::uint8_t *p)
+{
+    logPutU32(p, sequence);
+    logPutU32(p + 4, sample.epoch);
+    logPutU16(p + 8, static_cast<std::uint16_t>(sample.moisture));
+    logPutU16(p + 10, static_cast<std::uint16_t>(logToCentis(sample.temperature)));
+    logPutU16(p + 12, static_cast<std::uint16_t>(logToCentis(sample.humidity)));
+    logPutU16(p + 14, static_cast<std::uint16_t>(logCrc32(p, 14)));
+}
+
+/**
+ * @brief Liest nur die Nummer eines Eintrags (zum Wiederaufbau ohne Kopf).
+ * @return false, wenn die Prüfsumme nicht passt
+ */
+inline bool telemetryQueueEntrySequence(const std::uint8_t *p, std::uint32_t &sequence)
+{
+    if (logGetU16(p + 14) != static_cast<std::uint16_t>(logCrc32(p, 14))) {
+        return false;
+    }
+    sequence = logGetU32(p);
+    return true;
+}
+
+/**
+ * @return false, wenn die Prüfsumme oder die erwartete Nummer nicht passt (z.B. nach Stromausfall)
+ */
+inline bool decodeTelemetryQueueEntry(const std::uint8_t *p, std::uint32_t expectedSequence, TelemetrySample &sample)
+{
+    if (logGetU16(p + 14) != static_cast<std::uint16_t>(logCrc32(p, 14)) || logGetU32(p) != expectedSequence) {
+        return false;
+    }
+    sample.epoch = logGetU32(p + 4);
+    sample.moisture = logGetU16(p + 8);
+    sample.temperature = static_cast<std::int16_t>(logGetU16(p + 10)) / 100.0f;
+    sample.humidity = static_cast<std::int16_t>(logGetU16(p + 12)) / 100.0f;
+    return true;
+}
+
+/**
+ * @brief Statistik der Warteschlange
+ */
+struct TelemetryQueueStats {
+    std::uint32_t pushed = 0;   // Gespeicherte Einträge
+    std::uint32_t released = 0; // Nach Bestätigung durch den Hub entfernte Einträge
+    std::uint32_t dropped = 0;  // Wegen voller Warteschlange verworfene Einträge (gesamt, bleibt über Neustarts erhalten)
+    std::uint32_t corrupt = 0;  // Übersprungene beschädigte Einträge
+    std::uint32_t recoveries = 0; // Öffnen mit veraltetem oder unlesbarem Kopf, Einträge wurden aus der Datei übernommen
+    std::uint32_t errors = 0;   // Fehlgeschlagene Schreib- oder Lesezugriffe
+};
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <SD.h>
+
+/**
+ * @brief FIFO mit fester Kapazität in einer Datei auf der SD-Karte
+ *
+ * Nicht gesendete Messwerte bekommen fortlaufende Nummern und werden als Ring gespeichert. Ist die
+ * Warteschlange voll, wird der älteste Eintrag überschrieben. Das Abarbeiten erfolgt in zwei
+ * Schritten: peek() liest die ältesten Einträge, release() entfernt sie erst, wenn der Hub den
+ * Empfang bestätigt hat. Nach einem Neustart wird an der im Kopf gespeicherten Stelle fortgesetzt.
+ * Die Datei wird nur neu angelegt, wenn sich die Kapazität oder das Format geändert hat; die Nummern
+ * laufen dabei weiter.
+ */
+class TelemetryQueue
+{
+private:
+    File file;
+    TelemetryQueueHeader header;
+    std::uint32_t capacity;
+    bool isOpen = false;
+    TelemetryQueueStats stats;
+
+    std::uint32_t position(std::uint32_t sequence) const
+    {
+        return TELEMETRY_QUEUE_DATA_OFFSET + (sequence % header.capacity) * TELEMETRY_QUEUE_ENTRY_SIZE;
+    }
+
+    bool writeHeaderSlot(std::uint32_t slot)
+    {
+        std::uint8_t sector[LOG_SECTOR_SIZE];
+        encodeTelemetryQueueHeader(header, sector);
+        if (!file.seek(slot * LOG_SECTOR_SIZE) || file.write(sector, LOG_SECTOR_SIZE) != LOG_SECTOR_SIZE) {
+            stats.errors++;
+            return false;
+        }
+        file.flush();
+        return true;
+    }
+
+    // Neuer Kopf in das Fach, das nicht den letzten gültigen Stand enthält
+    bool writeHeader()
+    {
+        header.generation++;
+        return writeHeaderSlot(header.generation % TELEMETRY_QUEUE_HEADER_SLOTS);
+    }
+
+    // Leere Warteschlange ab firstSequence; beide Fächer der Reihe nach, damit die Datei nur am Ende wächst
+    bool initialize(std::uint32_t firstSequence)
+    {
+        header = TelemetryQueueHeader();
+        header.capacity = capacity;
+        header.headSequence = firstSequence;
+        header.tailSequence = firstSequence;
+        return writeHeaderSlot(0) && writeHeader();
+    }
+
+    // Datei für eine andere Kapazität bzw. ein anderes Format neu anlegen, die Nummern laufen weiter
+    bool recreate(const char *path, std::uint32_t lastTail)
+    {
+        file.close();
+        SD.remove(path);
+        file = SD.open(path, O_READ | O_WRITE | O_CREAT);
+        return file && initialize(telemetryQueueFirstSequence(lastTail, capacity));
+    }
+
+    bool readEntry(std::uint32_t sequence, std::uint8_t *entry)
+    {
+        if (!file.seek(position(sequence)) || file.read(entry, TELEMETRY_QUEUE_ENTRY_SIZE) != static_cast<int>(TELEMETRY_QUEUE_ENTRY_SIZE)) {
+            return false;
+        }
+        return true;
+    }
+
+    // Einträge, die nach dem letzten gültigen Kopf geschrieben wurden, wieder anhängen; wie bei push()
+    // hat ein solcher Eintrag bei voller Warteschlange den ältesten bereits überschrieben
+    std::uint32_t appendStoredEntries()
+    {
+        std::uint32_t appended = 0;
+        std::uint32_t sequence = 0;
+        std::uint8_t entry[TELEMETRY_QUEUE_ENTRY_SIZE];
+        while (appended < header.capacity && file.size() >= position(header.tailSequence) + TELEMETRY_QUEUE_ENTRY_SIZE
+               && readEntry(header.tailSequence, entry) && telemetryQueueEntrySequence(entry, sequence) && sequence == header.tailSequence) {
+            if (getDepth() >= header.capacity) {
+                header.headSequence++;
+                header.dropped++;
+            }
+            header.tailSequence++;
+            appended++;
+        }
+        return appended;
+    }
+
+    /*
+     * Beide Kopffächer unlesbar: die Einträge tragen ihre Nummer selbst. Die höchste Nummer ergibt das Ende,
+     * die älteste innerhalb einer Kapazität davor den Anfang; bereits bestätigte Einträge können dabei erneut
+     * gesendet werden, der Empfänger erkennt sie an der Nummer.
+     */
+    void rebuild()
+    {
+        header = TelemetryQueueHeader();
+        header.capacity = capacity;
+        std::uint32_t size = file.size();
+        std::uint32_t slots = size > TELEMETRY_QUEUE_DATA_OFFSET ? (size - TELEMETRY_QUEUE_DATA_OFFSET) / TELEMETRY_QUEUE_ENTRY_SIZE : 0;
+        if (slots > capacity) slots = capacity;
+
+        const std::uint32_t perSector = LOG_SECTOR_SIZE / TELEMETRY_QUEUE_ENTRY_SIZE;
+        bool found = false;
+        std::uint32_t newest = 0;
+        std::uint32_t oldest = 0;
+        // Erster Durchgang: höchste Nummer, zweiter: älteste Nummer innerhalb einer Kapazität davor
+        for (int pass = 0; pass < 2; pass++) {
+            std::uint8_t sector[LOG_SECTOR_SIZE];
+            for (std::uint32_t first = 0; first < slots; first += perSector) {
+                std::uint32_t count = slots - first < perSector ? slots - first : perSector;
+                std::uint32_t bytes = count * TELEMETRY_QUEUE_ENTRY_SIZE;
+                if (!file.seek(TELEMETRY_QUEUE_DATA_OFFSET + first * TELEMETRY_QUEUE_ENTRY_SIZE) || file.read(sector, bytes) != static_cast<int>(bytes)) {
+                    stats.errors++;
+                    break;
+                }
+                for (std::uint32_t i = 0; i < count; i++) {
+                    std::uint32_t sequence = 0;
+                    if (!telemetryQueueEntrySequence(sector + i * TELEMETRY_QUEUE_ENTRY_SIZE, sequence) || sequence % capacity != first + i) {
+                        continue;
+                    }
+                    if (pass == 0) {
+                        if (!found || static_cast<std::int32_t>(sequence - newest) > 0) newest = sequence;
+                        found = true;
+                    } else if (newest - sequence < capacity && newest - sequence > newest - oldest) {
+                        oldest = sequence;
+                    }
+                }
+            }
+            if (!found) {
+                return;
+            }
+            if (pass == 0) {
+                oldest = newest;
+            }
+        }
+        header.headSequence = oldest;
+        header.tailSequence = newest + 1;
+    }
+
+public:
+    /**
+     * @param [in] capacity Maximale Anzahl gespeicherter Messwerte
+     */
+    explicit TelemetryQueue(std::uint32_t capacity) : capacity(capacity > 0 ? capacity : 1) {}
+
+    /**
+     * @brief Öffnet die Warteschlange bzw. legt sie an.
+     *
+     * Gilt der neuere gültige Kopf, werden danach gespeicherte Einträge übernommen. Ohne gültigen Kopf wird
+     * aus den Einträgen neu aufgebaut, die Datei bleibt dabei erhalten. Neu angelegt wird sie nur bei einer
+     * anderen Kapazität oder einer Datei der Version 1.
+     * @return false bei Fehlern
+     */
+    bool begin(const char *path)
+    {
+        file = SD.open(path, O_READ | O_WRITE | O_CREAT);
+        if (!file) {
+            return false;
+        }
+
+        std::uint8_t slots[TELEMETRY_QUEUE_HEADER_SLOTS * LOG_SECTOR_SIZE];
+        std::memset(slots, 0, sizeof(slots));
+        std::uint32_t size = file.size();
+        std::uint32_t available = size < sizeof(slots) ? size : sizeof(slots);
+        if (available > 0 && (!file.seek(0) || file.read(slots, available) != static_cast<int>(available))) {
+            // Lesefehler: die Datei nicht anfassen, beim nächsten Start erneut versuchen
+            stats.errors++;
+            file.close();
+            return false;
+        }
+
+        TelemetryQueueHeader stored;
+        std::uint32_t lastTail = 0;
+        bool ok = true;
+        if (selectTelemetryQueueHeader(slots, slots + LOG_SECTOR_SIZE, stored)) {
+            if (stored.capacity != capacity) {
+                ok = recreate(path, stored.tailSequence);
+            } else {
+                header = stored;
+                if (appendStoredEntries() > 0) {
+                    stats.recoveries++;
+                    ok = writeHeader();
+                }
+            }
+        } else if (decodeTelemetryQueueHeaderV1Tail(slots, lastTail)) {
+            // Version 1: ein Kopffach, Einträge ab Byte 512; nicht übertragbar, nur die Nummern laufen weiter
+            ok = recreate(path, lastTail);
+        } else {
+            rebuild();
+            if (size > 0) {
+                stats.recoveries++;
+            }
+            ok = writeHeaderSlot(0) && writeHeader();
+        }
+        if (!ok) {
+            return false;
+        }
+        stats.dropped = header.dropped;
+        isOpen = true;
+        return true;
+    }
+
+    /**
+     * @brief Speichert Messwerte am Ende der Warteschlange; bei voller Warteschlange werden die ältesten verworfen.
+     * @return Anzahl gespeicherter Messwerte
+     */
+    std::size_t push(const TelemetrySample *samples, std::size_t count)
+    {
+        if (!isOpen) {
+            return 0;
+        }
+        std::size_t written = 0;
+        for (; written < count; written++) {
+            if (header.tailSequence - header.headSequence >= header.capacity) {
+                header.headSequence++;
+                header.dropped++;
+                stats.dropped++;
+            }
+            std::uint8_t entry[TELEMETRY_QUEUE_ENTRY_SIZE];
+            encodeTelemetryQueueEntry(header.tailSequence, samples[written], entry);
+            if (!file.seek(position(header.tailSequence)) || file.write(entry, TELEMETRY_QUEUE_ENTRY_SIZE) != TELEMETRY_QUEUE_ENTRY_SIZE) {
+                stats.errors++;
+                break;
+            }
+            header.tailSequence++;
+            stats.pushed++;
+        }
+        // Kopf erst nach den Einträgen schreiben
+        file.flush();
+        writeHeader();
+        return written;
+    }
+
+    /**
+     * @brief Liest die ältesten Einträge, ohne sie zu entfernen. Beschädigte Einträge am Anfang werden übersprungen.
+     * @param [out] samples Puffer für höchstens maxCount Messwerte
+     * @param [out] firstSequence Nummer des ersten gelesenen Eintrags; die weiteren sind fortlaufend
+     * @return Anzahl gelesener Messwerte
+     */
+    std::size_t peek(TelemetrySample *samples, std::size_t maxCount, std::uint32_t &firstSequence)
+    {
+        std::size_t count = 0;
+        bool skipped = false;
+        while (isOpen && count < maxCount && header.headSequence + count != header.tailSequence) {
+            std::uint32_t sequence = header.headSequence + static_cast<std::uint32_t>(count);
+            std::uint8_t entry[TELEMETRY_QUEUE_ENTRY_SIZE];
+            if (!readEntry(sequence, entry)) {
+                stats.errors++;
+                break;
+            }
+            if (!decodeTelemetryQueueEntry(entry, sequence, samples[count])) {
+                if (count > 0) {
+                    break; // Wird beim nächsten Aufruf als erster Eintrag übersprungen
+                }
+                header.headSequence++;
+                stats.corrupt++;
+                skipped = true;
+                continue;
+            }
+            count++;
+        }
+        if (skipped) {
+            writeHeader();
+        }
+        firstSequence = header.headSequence;
+        return count;
+    }
+
+    /**
+     * @brief Entfernt die Einträge bis einschließlich lastSequence (nach Bestätigung durch den Hub).
+     *
+     * Einträge, die inzwischen wegen voller Warteschlange verworfen wurden, werden nicht doppelt gezählt.
+     */
+    void release(std::uint32_t lastSequence)
+    {
+        std::uint32_t end = lastSequence + 1;
+        if (!isOpen || static_cast<std::int32_t>(end - header.headSequence) <= 0 || end - header.headSequence > header.tailSequence - header.headSequence) {
+            return;
+        }
+        stats.released += end - header.headSequence;
+        header.headSequence = end;
+        writeHeader();
+    }
+
+    bool isReady() const { return isOpen; }
+    bool isEmpty() const { return header.headSequence == header.tailSequence; }
+    std::uint32_t getDepth() const { return header.tailSequence - header.headSequence; }
+    std::uint32_t getCapacity() const { return header.capacity; }
+    const TelemetryQueueStats &getStats() const { return stats; }
+};
+#endif // ARDUINO
+
+#endif //TELEMETRY_QUEUE_HPP__
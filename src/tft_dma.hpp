@@ -0,0 +1,249 @@
+// Überträgt Bildbereiche per DMA an das Display: zwei Kachelpuffer, während einer gesendet wird, wird der andere befüllt
+/**
+ * @file tft_dma.hpp
+*/
+
+#ifndef TFT_DMA_HPP__
+#define TFT_DMA_HPP__
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Übertragungsstatistik
+ */
+struct TftDmaStats {
+    std::uint32_t regions = 0;          // Übertragene Bereiche
+    std::uint32_t tiles = 0;            // Übertragene Kacheln
+    std::uint32_t lastRegionMicros = 0; // Dauer des letzten Bereichs vom Start bis zum letzten Byte
+    std::uint32_t maxRegionMicros = 0;  // Längster Bereich
+    std::uint32_t composeMicros = 0;    // Summe der CPU-Zeit zum Befüllen der Kacheln
+    std::uint32_t finishWaits = 0;      // Aufrufe von finish(), die auf eine laufende Übertragung warten mussten
+};
+
+/**
+ * @brief Wandelt eine RGB565-Farbe in die Byte-Reihenfolge auf der SPI-Leitung (höherwertiges Byte zuerst).
+ */
+inline std::uint16_t tftDmaColor(std::uint16_t color) { return static_cast<std::uint16_t>((color << 8) | (color >> 8)); }
+
+/**
+ * @brief Pixel pro Kachel: ganze Zeilen eines Bereichs der Breite width, höchstens maxPixels
+ */
+inline std::size_t tftDmaTilePixels(std::int16_t width, std::size_t maxPixels)
+{
+    if (width <= 0) return 0;
+    std::size_t rows = maxPixels / static_cast<std::size_t>(width);
+    return (rows > 0 ? rows : 1) * static_cast<std::size_t>(width);
+}
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <TFT_eSPI.h>
+#include <Adafruit_ZeroDMA.h>
+
+// SPI des LCD beim Wio Terminal (LCD_SPI liegt auf SERCOM7)
+#ifndef TFT_DMA_SERCOM
+#define TFT_DMA_SERCOM SERCOM7
+#define TFT_DMA_TRIGGER SERCOM7_DMAC_ID_TX
+#endif
+
+/**
+ * @brief Nicht blockierende Übertragung eines Rechtecks an das Display
+ *
+ * start() setzt das Adressfenster und sendet die erste Kachel per DMA direkt in das SPI-Datenregister.
+ * Während eine Kachel läuft, befüllt die Compose-Funktion den zweiten Puffer. Am Ende einer Kachel
+ * startet der DMA-Interrupt sofort den bereits befüllten Puffer; poll() aus loop() befüllt nur den frei
+ * gewordenen Puffer und schließt den Bereich ab. Der Bus steht so nur still, wenn loop() einen Puffer
+ * nicht befüllt hat, bevor der andere übertragen ist; dann startet poll() die Kachel nach dem Befüllen.
+ *
+ * Solange isBusy() gilt, gehört der Bus der DMA: vor blockierenden TFT_eSPI-Aufrufen finish() aufrufen.
+ */
+class TftDmaRenderer
+{
+public:
+    /**
+     * @brief Befüllt die nächsten count Pixel (zeilenweise, Byte-Reihenfolge wie tftDmaColor()).
+     */
+    typedef void (*ComposeFunction)(std::uint16_t *pixels, std::size_t count, void *context);
+    /**
+     * @brief Wird aus poll() bzw. finish() aufgerufen, wenn das letzte Pixel übertragen ist.
+     */
+    typedef void (*DoneFunction)(void *context);
+
+    static const std::size_t TILE_PIXELS = 2560; // 8 Zeilen zu 320 Pixel, 5 KB pro Puffer
+
+private:
+    TFT_eSPI *tft = nullptr;
+    Adafruit_ZeroDMA dma;
+    DmacDescriptor *descriptor = nullptr;
+    std::uint16_t buffers[2][TILE_PIXELS];
+    volatile std::size_t bufferPixels[2] = {0, 0}; // Befüllte Pixel, 0 = Puffer frei
+    volatile std::uint8_t sending = 0;  // Puffer, der gerade bzw. zuletzt übertragen wird
+    volatile bool idle = true;          // Keine Kachel unterwegs, der nächste Puffer war beim Ende noch nicht befüllt
+    std::uint32_t remainingPixels = 0;  // Noch nicht befüllte Pixel des Bereichs
+    std::size_t tilePixels = 0;
+    ComposeFunction compose = nullptr;
+    DoneFunction done = nullptr;
+    void *context = nullptr;
+    std::uint32_t startMicros = 0;
+    bool ready = false;
+    bool active = false;
+    TftDmaStats stats;
+
+    // Aktive Instanz für den DMA-Interrupt; es gibt nur ein Display und damit nur einen Kanal
+    static TftDmaRenderer *&instance()
+    {
+        static TftDmaRenderer *active = nullptr;
+        return active;
+    }
+
+    // DMA-Interrupt: gesendeten Puffer freigeben und den anderen sofort starten, wenn er befüllt ist
+    static void onTransferComplete(Adafruit_ZeroDMA *)
+    {
+        TftDmaRenderer *self = instance();
+        if (self == nullptr) return;
+        std::uint8_t next = self->sending ^ 1;
+        self->bufferPixels[self->sending] = 0;
+        if (self->bufferPixels[next] > 0) {
+            self->send(next);
+        } else {
+            self->idle = true;
+        }
+    }
+
+    void send(std::uint8_t index)
+    {
+        sending = index;
+        idle = false;
+        dma.changeDescriptor(descriptor, buffers[index], nullptr, bufferPixels[index] * sizeof(std::uint16_t));
+        dma.startJob();
+        stats.tiles++;
+    }
+
+    // Befüllt einen freien Puffer; läuft keine Kachel mehr, wird er gleich gesendet
+    void fill(std::uint8_t index)
+    {
+        std::size_t count = remainingPixels < tilePixels ? remainingPixels : tilePixels;
+        std::uint32_t start = micros();
+        compose(buffers[index], count, context);
+        stats.composeMicros += micros() - start;
+        remainingPixels -= count;
+        // Erst nach dem Befüllen freigeben: ab hier darf der Interrupt den Puffer starten
+        bufferPixels[index] = count;
+        if (idle) {
+            send(index);
+        }
+    }
+
+    void complete()
+    {
+        // Das letzte Byte ist erst mit TXC vollständig gesendet
+        while (!TFT_DMA_SERCOM->SPI.INTFLAG.bit.TXC);
+        // Während der DMA empfangene Bytes verwerfen, sonst sieht der nächste blockierende Aufruf alte Daten
+        while (TFT_DMA_SERCOM->SPI.INTFLAG.bit.RXC) {
+            (void)TFT_DMA_SERCOM->SPI.DATA.reg;
+        }
+        TFT_DMA_SERCOM->SPI.STATUS.bit.BUFOVF = 1;
+        tft->endWrite();
+        active = false;
+
+        std::uint32_t duration = micros() - startMicros;
+        stats.regions++;
+        stats.lastRegionMicros = duration;
+        if (duration > stats.maxRegionMicros) stats.maxRegionMicros = duration;
+        if (done != nullptr) {
+            done(context);
+        }
+    }
+
+public:
+    /**
+     * @brief Reserviert den DMA-Kanal; nach tft.begin() aufrufen.
+     * @return false, wenn kein Kanal frei ist (dann liefert start() immer false)
+     */
+    bool begin(TFT_eSPI &display)
+    {
+        tft = &display;
+        if (dma.allocate() != DMA_STATUS_OK) {
+            return false;
+        }
+        dma.setTrigger(TFT_DMA_TRIGGER);
+        dma.setAction(DMA_TRIGGER_ACTON_BEAT);
+        descriptor = dma.addDescriptor(buffers[0], (void *)&TFT_DMA_SERCOM->SPI.DATA.reg, 0, DMA_BEAT_SIZE_BYTE, true, false);
+        if (descriptor == nullptr) {
+            return false;
+        }
+        dma.setCallback(onTransferComplete);
+        instance() = this;
+        ready = true;
+        return true;
+    }
+
+    /**
+     * @brief Startet die Übertragung des Rechtecks; kehrt nach dem Befüllen der ersten beiden Kacheln zurück.
+     * @param [in] compose Liefert die Pixel des Bereichs zeilenweise von oben links
+     * @param [in] done Optional, meldet das Ende der Übertragung
+     * @return false, wenn noch übertragen wird oder kein DMA-Kanal reserviert ist
+     */
+    bool start(std::int16_t x, std::int16_t y, std::int16_t w, std::int16_t h, ComposeFunction compose, DoneFunction done, void *context)
+    {
+        if (!ready || active || w <= 0 || h <= 0) {
+            return false;
+        }
+        this->compose = compose;
+        this->done = done;
+        this->context = context;
+        tilePixels = tftDmaTilePixels(w, TILE_PIXELS);
+        remainingPixels = static_cast<std::uint32_t>(w) * static_cast<std::uint32_t>(h);
+        startMicros = micros();
+
+        tft->startWrite();
+        tft->setWindow(x, y, x + w - 1, y + h - 1);
+        active = true;
+        sending = 1; // Der erste befüllte Puffer ist 0
+        fill(0);
+        if (remainingPixels > 0) {
+            fill(1);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Befüllt den frei gewordenen Puffer bzw. schließt den Bereich nach der letzten Kachel ab; aus loop() aufrufen.
+     */
+    void poll()
+    {
+        if (!active) {
+            return;
+        }
+        std::uint8_t empty = sending ^ 1;
+        if (remainingPixels > 0) {
+            if (bufferPixels[empty] == 0) {
+                fill(empty);
+            }
+            return;
+        }
+        if (idle) {
+            complete();
+        }
+    }
+
+    /**
+     * @brief Wartet, bis eine laufende Übertragung beendet ist (vor blockierenden Zeichenaufrufen).
+     */
+    void finish()
+    {
+        if (active) {
+            stats.finishWaits++;
+        }
+        while (active) {
+            poll();
+        }
+    }
+
+    bool isBusy() const { return active; }
+    const TftDmaStats &getStats() const { return stats; }
+};
+#endif // ARDUINO
+
+#endif //TFT_DMA_HPP__
@@ -0,0 +1,69 @@
+// Zeitlich begrenzte Anzeigen (Meldungen) als Zustand statt delay(), vom Scheduler weitergeschaltet
+/**
+ * @file timed_screen.hpp
+*/
+
+#ifndef TIMED_SCREEN_HPP__
+#define TIMED_SCREEN_HPP__
+
+#include <cstdint>
+
+/**
+ * @brief Merkt sich, welche Meldung seit wann und wie lange sichtbar ist
+ *
+ * show() zeichnet nichts, sondern startet nur die Zeit; gezeichnet wird vom Aufrufer. poll() aus einer
+ * Aufgabe des Schedulers meldet genau einmal, dass die Zeit abgelaufen ist; dann baut der Aufrufer die
+ * nächste Anzeige auf. Eine neue Meldung ersetzt eine noch sichtbare und startet die Zeit neu.
+ */
+class TimedScreen
+{
+public:
+    static const int NONE = 0;
+
+private:
+    int screen = NONE;
+    std::uint32_t since = 0;
+    std::uint32_t duration = 0;
+    std::uint32_t shown = 0; // Angezeigte Meldungen seit dem Start
+
+public:
+    /**
+     * @brief Macht screen für duration ms zur aktuellen Meldung.
+     */
+    void show(int screen, std::uint32_t now, std::uint32_t duration)
+    {
+        this->screen = screen;
+        this->since = now;
+        this->duration = duration;
+        shown++;
+    }
+
+    /**
+     * @brief Schaltet weiter; regelmäßig aufrufen.
+     * @return Die Meldung, deren Zeit mit diesem Aufruf abgelaufen ist, sonst NONE
+     */
+    int poll(std::uint32_t now)
+    {
+        if (screen == NONE || now - since < duration) {
+            return NONE;
+        }
+        int expired = screen;
+        screen = NONE;
+        return expired;
+    }
+
+    /**
+     * @brief Beendet die Meldung ohne Ablaufmeldung (z.B. wenn eine andere Anzeige sie ersetzt).
+     */
+    void cancel() { screen = NONE; }
+
+    bool isActive() const { return screen != NONE; }
+    int getScreen() const { return screen; }
+    std::uint32_t getRemaining(std::uint32_t now) const
+    {
+        return screen == NONE || now - since >= duration ? 0 : duration - (now - since);
+    }
+    std::uint32_t getShown() const { return shown; }
+};
+
+#endif //TIMED_SCREEN_HPP__
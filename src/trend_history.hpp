@@ -0,0 +1,345 @@
+// Verlauf der Messwerte im RAM: min/mittel/max je Minute, Viertelstunde und Stunde in festen Ringpuffern
+/**
+ * @file trend_history.hpp
+*/
+
+#ifndef TREND_HISTORY_HPP__
+#define TREND_HISTORY_HPP__
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+
+#include "log_format.hpp"
+
+/*
+ * Speicherbudget: Jeder abgeschlossene Zeitraum belegt pro Kanal 6 Byte (min, max, mittel als int16).
+ * 60 Minuten + 96 Viertelstunden + 168 Stunden = 324 Zeiträume x 3 Kanäle x 6 Byte = 5832 Byte,
+ * dazu die offenen Summen der drei Stufen. TrendHistory bleibt damit unter TREND_MEMORY_BUDGET,
+ * das wird unten per static_assert geprüft. Beim Zeichnen wird nichts von der SD-Karte gelesen.
+ */
+static const std::size_t TREND_MEMORY_BUDGET = 6144;
+
+static const std::size_t TREND_CHANNELS = 3; // Bodenfeuchte (Rohwert), Temperatur und Luftfeuchte (jeweils Hundertstel)
+
+/**
+ * @brief Zusammenfassung eines Zeitraums für einen Kanal; leer, wenn keine Messung vorlag
+ */
+struct TrendPoint {
+    std::int16_t min = 32767;
+    std::int16_t max = -32768;
+    std::int16_t avg = 0;
+
+    bool isEmpty() const { return min > max; }
+};
+
+/**
+ * @brief Laufende Summen des offenen Zeitraums
+ */
+struct TrendAccumulator {
+    std::int32_t sum[TREND_CHANNELS];
+    std::int16_t min[TREND_CHANNELS];
+    std::int16_t max[TREND_CHANNELS];
+    std::uint16_t count[TREND_CHANNELS];
+
+    TrendAccumulator() { clear(); }
+
+    void clear()
+    {
+        for (std::size_t c = 0; c < TREND_CHANNELS; c++) {
+            sum[c] = 0;
+            min[c] = 32767;
+            max[c] = -32768;
+            count[c] = 0;
+        }
+    }
+
+    void add(std::size_t channel, std::int16_t value)
+    {
+        sum[channel] += value;
+        if (value < min[channel]) min[channel] = value;
+        if (value > max[channel]) max[channel] = value;
+        count[channel]++;
+    }
+
+    TrendPoint result(std::size_t channel) const
+    {
+        TrendPoint point;
+        if (count[channel] > 0) {
+            point.min = min[channel];
+            point.max = max[channel];
+            point.avg = static_cast<std::int16_t>(sum[channel] / count[channel]);
+        }
+        return point;
+    }
+};
+
+/**
+ * @brief Eine Auflösungsstufe: offener Zeitraum plus Ring der letzten N abgeschlossenen
+ */
+template <std::size_t N>
+class TrendLevel
+{
+private:
+    TrendPoint points[N][TREND_CHANNELS];
+    std::size_t head = 0;  // Nächster Schreibplatz
+    std::size_t count = 0; // Belegte Plätze
+    std::uint32_t period;
+    std::uint32_t slot = 0; // Nummer des offenen Zeitraums (epoch / period)
+    bool started = false;
+    TrendAccumulator open;
+
+    void push(const TrendAccumulator &source)
+    {
+        for (std::size_t c = 0; c < TREND_CHANNELS; c++) {
+            points[head][c] = source.result(c);
+        }
+        head = (head + 1) % N;
+        if (count < N) count++;
+    }
+
+public:
+    explicit TrendLevel(std::uint32_t period) : period(period) {}
+
+    /**
+     * @brief Schließt bei Bedarf den offenen Zeitraum (Lücken werden als leere Zeiträume eingetragen).
+     * @return true, wenn mindestens ein Zeitraum abgeschlossen wurde
+     */
+    bool advance(std::uint32_t epoch)
+    {
+        std::uint32_t target = epoch / period;
+        if (!started) {
+            slot = target;
+            started = true;
+            return false;
+        }
+        // Zeit läuft rückwärts (z.B. nach einem NTP-Abgleich): im offenen Zeitraum weiterzählen
+        if (target <= slot) {
+            return false;
+        }
+        push(open);
+        open.clear();
+        TrendAccumulator empty;
+        std::uint32_t gaps = target - slot - 1;
+        for (std::uint32_t i = 0; i < gaps && i < N; i++) {
+            push(empty);
+        }
+        slot = target;
+        return true;
+    }
+
+    void add(std::size_t channel, std::int16_t value) { open.add(channel, value); }
+
+    /**
+     * @brief Die letzten maxPoints Zeiträume vom ältesten zum neuesten, der offene zuletzt.
+     * @return Anzahl der geschriebenen Punkte
+     */
+    std::size_t snapshot(std::size_t channel, TrendPoint *out, std::size_t maxPoints) const
+    {
+        if (maxPoints == 0) return 0;
+        std::size_t closed = count < maxPoints - 1 ? count : maxPoints - 1;
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < closed; i++) {
+            out[n++] = points[(head + N - closed + i) % N][channel];
+        }
+        out[n++] = open.result(channel);
+        return n;
+    }
+
+    static std::size_t capacity() { return N; }
+};
+
+/**
+ * @brief Verlauf der drei Messwerte in drei Auflösungen (1 h, 24 h, 7 d)
+ */
+class TrendHistory
+{
+public:
+    enum Range {
+        RANGE_HOUR,   // 60 x 1 Minute
+        RANGE_DAY,    // 96 x 15 Minuten
+        RANGE_WEEK    // 168 x 1 Stunde
+    };
+    static const std::size_t MAX_POINTS = 168;
+
+private:
+    TrendLevel<60> minutes;
+    TrendLevel<96> quarters;
+    TrendLevel<168> hours;
+    std::uint32_t revision = 0;
+
+public:
+    TrendHistory() : minutes(60), quarters(900), hours(3600) {}
+
+    /**
+     * @brief Übernimmt eine Messung; ungültige Werte (NaN) werden für den jeweiligen Kanal übersprungen.
+     */
+    void add(std::uint32_t epoch, int moisture, float temperature, float humidity)
+    {
+        bool closed = minutes.advance(epoch);
+        closed = quarters.advance(epoch) || closed;
+        closed = hours.advance(epoch) || closed;
+        if (closed) revision++;
+
+        std::int16_t values[TREND_CHANNELS] = {static_cast<std::int16_t>(moisture), logToCentis(temperature), logToCentis(humidity)};
+        bool valid[TREND_CHANNELS] = {true, !std::isnan(temperature), !std::isnan(humidity)};
+        for (std::size_t c = 0; c < TREND_CHANNELS; c++) {
+            if (!valid[c]) continue;
+            minutes.add(c, values[c]);
+            quarters.add(c, values[c]);
+            hours.add(c, values[c]);
+        }
+    }
+
+    /**
+     * @param [out] out Platz für MAX_POINTS Punkte
+     * @return Anzahl der Punkte, vom ältesten zum neuesten (der letzte ist der noch offene Zeitraum)
+     */
+    std::size_t snapshot(Range range, std::size_t channel, TrendPoint *out) const
+    {
+        switch (range) {
+            case RANGE_HOUR: return minutes.snapshot(channel, out, TrendLevel<60>::capacity());
+            case RANGE_DAY: return quarters.snapshot(channel, out, TrendLevel<96>::capacity());
+            default: return hours.snapshot(channel, out, TrendLevel<168>::capacity());
+        }
+    }
+
+    /**
+     * @brief Zählt hoch, sobald ein Zeitraum abgeschlossen wurde (dann lohnt sich ein Neuzeichnen).
+     */
+    std::uint32_t getRevision() const { return revision; }
+};
+
+static_assert(sizeof(TrendHistory) <= TREND_MEMORY_BUDGET, "TrendHistory überschreitet das Speicherbudget");
+
+/**
+ * @brief Largest-Triangle-Three-Buckets: wählt höchstens threshold Punkte, die den Verlauf optisch erhalten.
+ *
+ * Erster und letzter Punkt bleiben, aus jedem Zwischenabschnitt wird der Punkt mit der größten
+ * Dreiecksfläche zum zuletzt gewählten Punkt und zum Mittel des folgenden Abschnitts genommen.
+ * @param [in] xs, ys Punkte mit aufsteigendem x
+ * @param [out] selected Indizes der gewählten Punkte (Platz für threshold bzw. count Einträge)
+ * @return Anzahl der gewählten Punkte
+ */
+inline std::size_t lttbDownsample(const std::uint16_t *xs, const std::int16_t *ys, std::size_t count, std::size_t threshold, std::uint16_t *selected)
+{
+    if (threshold >= count) {
+        for (std::size_t i = 0; i < count; i++) {
+            selected[i] = static_cast<std::uint16_t>(i);
+        }
+        return count;
+    }
+    if (threshold < 3) {
+        // Zu wenige Punkte für Abschnitte: nur Anfang und Ende
+        std::size_t n = 0;
+        if (threshold >= 1) selected[n++] = 0;
+        if (threshold >= 2) selected[n++] = static_cast<std::uint16_t>(count - 1);
+        return n;
+    }
+
+    float every = static_cast<float>(count - 2) / static_cast<float>(threshold - 2);
+    std::size_t n = 0;
+    std::size_t a = 0;
+    selected[n++] = 0;
+    for (std::size_t i = 0; i < threshold - 2; i++) {
+        std::size_t avgStart = static_cast<std::size_t>((i + 1) * every) + 1;
+        std::size_t avgEnd = static_cast<std::size_t>((i + 2) * every) + 1;
+        if (avgEnd > count) avgEnd = count;
+        float avgX = 0;
+        float avgY = 0;
+        for (std::size_t j = avgStart; j < avgEnd; j++) {
+            avgX += xs[j];
+            avgY += ys[j];
+        }
+        std::size_t avgCount = avgEnd > avgStart ? avgEnd - avgStart : 1;
+        avgX /= avgCount;
+        avgY /= avgCount;
+
+        std::size_t rangeStart = static_cast<std::size_t>(i * every) + 1;
+        std::size_t rangeEnd = static_cast<std::size_t>((i + 1) * every) + 1;
+        float bestArea = -1;
+        std::size_t best = rangeStart;
+        for (std::size_t j = rangeStart; j < rangeEnd && j < count; j++) {
+            float area = std::fabs((static_cast<float>(xs[a]) - avgX) * (static_cast<float>(ys[j]) - ys[a])
+                                   - (static_cast<float>(xs[a]) - xs[j]) * (avgY - ys[a]));
+            if (area > bestArea) {
+                bestArea = area;
+                best = j;
+            }
+        }
+        selected[n++] = static_cast<std::uint16_t>(best);
+        a = best;
+    }
+    selected[n++] = static_cast<std::uint16_t>(count - 1);
+    return n;
+}
+
+#ifdef ARDUINO
+#include <TFT_eSPI.h>
+#include "ui_compositor.hpp"
+
+/**
+ * @brief Zeichnet einen Verlauf in das Rechteck: Spannweite min..max gedimmt, Mittelwerte als Linie.
+ *
+ * Die Punkte werden per LTTB auf die Breite des Rechtecks reduziert; über leere Zeiträume wird
+ * nicht verbunden.
+ * @return Anzahl der übertragenen Pixel (mindestens die Fläche des Rechtecks)
+ */
+inline std::uint32_t drawSparkline(TFT_eSPI &tft, const UiRect &box, const TrendPoint *points, std::size_t count,
+                                   std::uint16_t color, std::uint16_t rangeColor, std::uint16_t background)
+{
+    tft.fillRect(box.x, box.y, box.w, box.h, background);
+
+    std::uint16_t xs[TrendHistory::MAX_POINTS];
+    std::int16_t ys[TrendHistory::MAX_POINTS];
+    std::uint16_t selected[TrendHistory::MAX_POINTS];
+    std::size_t present = 0;
+    std::int16_t low = 32767;
+    std::int16_t high = -32768;
+    for (std::size_t i = 0; i < count && i < TrendHistory::MAX_POINTS; i++) {
+        if (points[i].isEmpty()) continue;
+        xs[present] = static_cast<std::uint16_t>(i);
+        ys[present] = points[i].avg;
+        present++;
+        if (points[i].min < low) low = points[i].min;
+        if (points[i].max > high) high = points[i].max;
+    }
+    if (present == 0 || count < 2) {
+        tft.drawFastHLine(box.x, box.y + box.h / 2, box.w, rangeColor);
+        return box.area();
+    }
+    std::int32_t span = high > low ? high - low : 1;
+
+    auto toX = [&](std::uint16_t index) -> std::int16_t {
+        return static_cast<std::int16_t>(box.x + static_cast<std::int32_t>(index) * (box.w - 1) / static_cast<std::int32_t>(count - 1));
+    };
+    auto toY = [&](std::int16_t value) -> std::int16_t {
+        return static_cast<std::int16_t>(box.y + box.h - 1 - (static_cast<std::int32_t>(value) - low) * (box.h - 1) / span);
+    };
+
+    std::size_t n = lttbDownsample(xs, ys, present, static_cast<std::size_t>(box.w), selected);
+    for (std::size_t i = 0; i < n; i++) {
+        const TrendPoint &p = points[xs[selected[i]]];
+        std::int16_t top = toY(p.max);
+        tft.drawFastVLine(toX(xs[selected[i]]), top, toY(p.min) - top + 1, rangeColor);
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        std::uint16_t index = xs[selected[i]];
+        std::int16_t x = toX(index);
+        std::int16_t y = toY(ys[selected[i]]);
+        // Keine Lücke (Zeitraum ohne Messung) überbrücken
+        bool connected = i > 0;
+        for (std::uint16_t j = connected ? xs[selected[i - 1]] + 1 : index; j < index; j++) {
+            connected = connected && !points[j].isEmpty();
+        }
+        if (connected) {
+            tft.drawLine(toX(xs[selected[i - 1]]), toY(ys[selected[i - 1]]), x, y, color);
+        } else {
+            tft.drawPixel(x, y, color);
+        }
+    }
+    return box.area();
+}
+#endif // ARDUINO
+
+#endif //TREND_HISTORY_HPP__
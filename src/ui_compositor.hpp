@@ -0,0 +1,486 @@
+// Retained-Mode-Anzeige: Textelemente merken sich ihren Inhalt und zeichnen nur geänderte Bereiche neu
+/**
+ * @file ui_compositor.hpp
+*/
+
+#ifndef UI_COMPOSITOR_HPP__
+#define UI_COMPOSITOR_HPP__
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+
+/**
+ * @brief Rechteck in Bildschirmkoordinaten
+ */
+struct UiRect {
+    std::int16_t x = 0;
+    std::int16_t y = 0;
+    std::int16_t w = 0;
+    std::int16_t h = 0;
+
+    UiRect() {}
+    UiRect(std::int16_t x, std::int16_t y, std::int16_t w, std::int16_t h) : x(x), y(y), w(w), h(h) {}
+
+    bool isEmpty() const { return w <= 0 || h <= 0; }
+    std::uint32_t area() const { return isEmpty() ? 0 : static_cast<std::uint32_t>(w) * static_cast<std::uint32_t>(h); }
+};
+
+/**
+ * @brief Zählt die an das Display übertragenen Pixel und ermittelt daraus die Rate pro Sekunde
+ */
+class PixelRateCounter
+{
+private:
+    std::uint32_t windowStart = 0;
+    std::uint32_t windowPixels = 0;
+    std::uint32_t lastRate = 0;
+    std::uint32_t maxRate = 0;
+    std::uint64_t totalPixels = 0;
+    bool started = false;
+
+public:
+    void add(std::uint32_t pixels)
+    {
+        windowPixels += pixels;
+        totalPixels += pixels;
+    }
+
+    /**
+     * @brief Schließt nach jeweils einer Sekunde das Messfenster ab; regelmäßig aufrufen.
+     */
+    void update(std::uint32_t now)
+    {
+        if (!started) {
+            windowStart = now;
+            started = true;
+            return;
+        }
+        std::uint32_t elapsed = now - windowStart;
+        if (elapsed >= 1000) {
+            lastRate = static_cast<std::uint32_t>(static_cast<std::uint64_t>(windowPixels) * 1000 / elapsed);
+            if (lastRate > maxRate) maxRate = lastRate;
+            windowPixels = 0;
+            windowStart = now;
+        }
+    }
+
+    std::uint32_t getRate() const { return lastRate; }
+    std::uint32_t getMaxRate() const { return maxRate; }
+    std::uint64_t getTotal() const { return totalPixels; }
+};
+
+/**
+ * @brief Vorgerasterte Zeichen der Standardschrift (GLCD, 6x8) in Schriftgröße 2 als 1-Bit-Zellen
+ *
+ * Enthält nur die Zeichen der Messwertfelder. Eine Zelle umfasst wie bei drawString() auch die
+ * Spalte Abstand zum nächsten Zeichen, Zellen liegen daher lückenlos nebeneinander.
+ */
+class GlyphAtlas
+{
+public:
+    static const std::int16_t CELL_W = 12;
+    static const std::int16_t CELL_H = 16;
+    static const std::size_t CELL_BYTES = CELL_W * CELL_H / 8;
+    static const int NO_GLYPH = -1;
+
+private:
+    static const char *charset() { return "0123456789:.-% C"; }
+    static const std::size_t GLYPHS = 16;
+
+    std::uint8_t bits[GLYPHS][CELL_BYTES];
+    bool built = false;
+
+public:
+    GlyphAtlas() { std::memset(bits, 0, sizeof(bits)); }
+
+    std::size_t getGlyphCount() const { return GLYPHS; }
+    char getChar(std::size_t glyph) const { return charset()[glyph]; }
+    bool isBuilt() const { return built; }
+
+    /**
+     * @return Index der Zelle oder NO_GLYPH, wenn das Zeichen nicht enthalten ist
+     */
+    int find(char c) const
+    {
+        for (std::size_t i = 0; i < GLYPHS; i++) {
+            if (charset()[i] == c) return static_cast<int>(i);
+        }
+        return NO_GLYPH;
+    }
+
+    void setPixel(std::size_t glyph, std::int16_t x, std::int16_t y)
+    {
+        std::size_t bit = static_cast<std::size_t>(y) * CELL_W + static_cast<std::size_t>(x);
+        bits[glyph][bit / 8] |= static_cast<std::uint8_t>(0x80 >> (bit % 8));
+    }
+
+    bool getPixel(std::size_t glyph, std::int16_t x, std::int16_t y) const
+    {
+        std::size_t bit = static_cast<std::size_t>(y) * CELL_W + static_cast<std::size_t>(x);
+        return (bits[glyph][bit / 8] & (0x80 >> (bit % 8))) != 0;
+    }
+
+    void markBuilt() { built = true; }
+
+    /**
+     * @brief Setzt aufeinanderfolgende Zellen zeilenweise zu einem Bild der Breite count * CELL_W zusammen.
+     * @param [in] glyphs Zellenindizes, NO_GLYPH ergibt eine leere Zelle
+     * @param [out] pixels Platz für count * CELL_W * CELL_H Pixel
+     */
+    void compose(const int *glyphs, std::size_t count, std::uint16_t color, std::uint16_t background, std::uint16_t *pixels) const
+    {
+        for (std::int16_t y = 0; y < CELL_H; y++) {
+            for (std::size_t i = 0; i < count; i++) {
+                for (std::int16_t x = 0; x < CELL_W; x++) {
+                    *pixels++ = glyphs[i] != NO_GLYPH && getPixel(static_cast<std::size_t>(glyphs[i]), x, y) ? color : background;
+                }
+            }
+        }
+    }
+};
+
+#ifdef ARDUINO
+#include <TFT_eSPI.h>
+
+/**
+ * @brief Rastert die Zeichen des Atlas einmalig mit der Schrift des Displays, dadurch pixelgleich zu drawString().
+ * @return false, wenn der Zwischenspeicher nicht angelegt werden konnte
+ */
+inline bool buildGlyphAtlas(GlyphAtlas &atlas, TFT_eSPI &tft)
+{
+    TFT_eSprite cell(&tft);
+    cell.setColorDepth(8);
+    if (cell.createSprite(GlyphAtlas::CELL_W, GlyphAtlas::CELL_H) == nullptr) {
+        return false;
+    }
+    cell.setTextFont(1);
+    cell.setTextSize(2);
+    cell.setTextDatum(TL_DATUM);
+    cell.setTextColor(TFT_WHITE, TFT_BLACK);
+    for (std::size_t glyph = 0; glyph < atlas.getGlyphCount(); glyph++) {
+        char text[2] = {atlas.getChar(glyph), '\0'};
+        cell.fillSprite(TFT_BLACK);
+        cell.drawString(text, 0, 0);
+        for (std::int16_t y = 0; y < GlyphAtlas::CELL_H; y++) {
+            for (std::int16_t x = 0; x < GlyphAtlas::CELL_W; x++) {
+                if (cell.readPixel(x, y) != TFT_BLACK) {
+                    atlas.setPixel(glyph, x, y);
+                }
+            }
+        }
+    }
+    cell.deleteSprite();
+    atlas.markBuilt();
+    return true;
+}
+
+/**
+ * @brief Element eines Bildschirms, das sich merkt, ob es neu gezeichnet werden muss
+ */
+class UiElement
+{
+public:
+    /**
+     * @brief Erzwingt ein Neuzeichnen, z.B. nachdem der Bildschirm gelöscht wurde.
+     * @param [in] cleared true, wenn der bisherige Bereich bereits gelöscht ist
+     */
+    virtual void invalidate(bool cleared) = 0;
+
+    /**
+     * @brief Zeichnet das Element, falls es geändert wurde.
+     * @return Anzahl der übertragenen Pixel
+     */
+    virtual std::uint32_t render(TFT_eSPI &tft, std::uint16_t background) = 0;
+};
+
+/**
+ * @brief Textelement (Beschriftung, Messwert oder Statuszeile) mit eigenem Dirty-Bereich
+ *
+ * set() markiert das Element nur dann als geändert, wenn sich Text oder Farbe tatsächlich ändern.
+ * Beim Zeichnen wird der Text mit Hintergrundfarbe deckend ausgegeben; gelöscht werden nur die
+ * Streifen des alten Texts, die der neue nicht überdeckt.
+ */
+class UiText : public UiElement
+{
+public:
+    static const std::size_t MAX_TEXT = 24;
+
+private:
+    std::int16_t x;
+    std::int16_t y;
+    std::uint8_t datum;
+    std::uint8_t textSize;
+    std::uint16_t color;
+    char text[MAX_TEXT];
+    UiRect drawn; // Zuletzt beschriebener Bereich
+    bool dirty = true;
+
+public:
+    /**
+     * @param [in] x, y Bezugspunkt des Texts
+     * @param [in] datum Bezugspunkt (TL_DATUM, MC_DATUM, ...)
+     * @param [in] textSize Schriftgröße
+     * @param [in] color Textfarbe
+     * @param [in] text Anfangstext
+     */
+    UiText(std::int16_t x, std::int16_t y, std::uint8_t datum, std::uint8_t textSize, std::uint16_t color, const char *text = "")
+        : x(x), y(y), datum(datum), textSize(textSize), color(color)
+    {
+        snprintf(this->text, sizeof(this->text), "%s", text);
+    }
+
+    void set(const char *value) { set(value, color); }
+
+    void set(const char *value, std::uint16_t newColor)
+    {
+        if (newColor == color && std::strncmp(value, text, MAX_TEXT - 1) == 0) {
+            return;
+        }
+        snprintf(text, sizeof(text), "%s", value);
+        color = newColor;
+        dirty = true;
+    }
+
+    void invalidate(bool cleared) override
+    {
+        dirty = true;
+        if (cleared) {
+            drawn = UiRect();
+        }
+    }
+
+    bool isDirty() const { return dirty; }
+    const char *get() const { return text; }
+
+    std::uint32_t render(TFT_eSPI &tft, std::uint16_t background) override
+    {
+        if (!dirty) {
+            return 0;
+        }
+        dirty = false;
+
+        tft.setTextSize(textSize);
+        tft.setTextDatum(datum);
+        std::int16_t width = static_cast<std::int16_t>(tft.textWidth(text));
+        std::int16_t height = static_cast<std::int16_t>(tft.fontHeight());
+
+        // Linke Kante aus dem Bezugspunkt berechnen (Text ist einzeilig, daher nur horizontal)
+        std::int16_t left = x;
+        if (datum == TC_DATUM || datum == MC_DATUM || datum == BC_DATUM) {
+            left = x - width / 2;
+        } else if (datum == TR_DATUM || datum == MR_DATUM || datum == BR_DATUM) {
+            left = x - width;
+        }
+        std::int16_t top = y;
+        if (datum == ML_DATUM || datum == MC_DATUM || datum == MR_DATUM) {
+            top = y - height / 2;
+        } else if (datum == BL_DATUM || datum == BC_DATUM || datum == BR_DATUM) {
+            top = y - height;
+        }
+        UiRect next(left, top, width, height);
+
+        std::uint32_t pixels = 0;
+        tft.setTextColor(color, background);
+        tft.drawString(text, x, y);
+        pixels += next.area();
+
+        // Vom alten Text nicht überdeckte Streifen links und rechts löschen
+        if (!drawn.isEmpty()) {
+            std::int16_t oldRight = drawn.x + drawn.w;
+            std::int16_t newRight = next.x + next.w;
+            if (drawn.x < next.x) {
+                UiRect strip(drawn.x, drawn.y, (oldRight < next.x ? oldRight : next.x) - drawn.x, drawn.h);
+                tft.fillRect(strip.x, strip.y, strip.w, strip.h, background);
+                pixels += strip.area();
+            }
+            if (oldRight > newRight) {
+                std::int16_t start = drawn.x > newRight ? drawn.x : newRight;
+                UiRect strip(start, drawn.y, oldRight - start, drawn.h);
+                tft.fillRect(strip.x, strip.y, strip.w, strip.h, background);
+                pixels += strip.area();
+            }
+        }
+        drawn = next;
+        return pixels;
+    }
+};
+
+/**
+ * @brief Messwertfeld aus Zellen des Glyphen-Atlas (Schriftgröße 2, Bezugspunkt oben links)
+ *
+ * Der neue Text wird zeichenweise mit dem angezeigten verglichen; übertragen werden nur die
+ * geänderten Zellen, benachbarte geänderte Zellen in einem gemeinsamen Adressfenster. Beim
+ * Sekundentakt der Uhr sind das meist eine bis zwei Zellen statt des ganzen Texts.
+ */
+class UiGlyphField : public UiElement
+{
+public:
+    static const std::size_t MAX_CELLS = 10; // Ab x = 200 bis zum rechten Rand
+
+private:
+    const GlyphAtlas &atlas;
+    std::int16_t x;
+    std::int16_t y;
+    std::uint16_t color;
+    char text[MAX_CELLS + 1];
+    char shown[MAX_CELLS + 1]; // Angezeigte Zeichen, Leerzeichen für leere Zellen
+    bool colorChanged = true;
+    bool dirty = true;
+
+public:
+    UiGlyphField(const GlyphAtlas &atlas, std::int16_t x, std::int16_t y, std::uint16_t color)
+        : atlas(atlas), x(x), y(y), color(color)
+    {
+        std::memset(text, 0, sizeof(text));
+        std::memset(shown, ' ', MAX_CELLS);
+        shown[MAX_CELLS] = '\0';
+    }
+
+    void set(const char *value) { set(value, color); }
+
+    /**
+     * @brief Übernimmt den Text; Zeichen nach MAX_CELLS werden abgeschnitten.
+     */
+    void set(const char *value, std::uint16_t newColor)
+    {
+        if (newColor == color && std::strncmp(value, text, MAX_CELLS) == 0) {
+            return;
+        }
+        snprintf(text, sizeof(text), "%s", value);
+        if (newColor != color) {
+            color = newColor;
+            colorChanged = true;
+        }
+        dirty = true;
+    }
+
+    const char *get() const { return text; }
+
+    void invalidate(bool cleared) override
+    {
+        dirty = true;
+        if (cleared) {
+            std::memset(shown, ' ', MAX_CELLS);
+        } else {
+            colorChanged = true;
+        }
+    }
+
+    std::uint32_t render(TFT_eSPI &tft, std::uint16_t background) override
+    {
+        if (!dirty) {
+            return 0;
+        }
+        dirty = false;
+
+        std::size_t length = std::strlen(text);
+        char next[MAX_CELLS];
+        for (std::size_t i = 0; i < MAX_CELLS; i++) {
+            next[i] = i < length ? text[i] : ' ';
+        }
+
+        std::uint32_t pixels = 0;
+        std::size_t i = 0;
+        while (i < MAX_CELLS) {
+            if (!colorChanged && next[i] == shown[i]) {
+                i++;
+                continue;
+            }
+            // Zusammenhängende geänderte Zellen in einem Fenster übertragen
+            std::size_t first = i;
+            int glyphs[MAX_CELLS];
+            while (i < MAX_CELLS && (colorChanged || next[i] != shown[i])) {
+                glyphs[i - first] = next[i] == ' ' ? GlyphAtlas::NO_GLYPH : atlas.find(next[i]);
+                shown[i] = next[i];
+                i++;
+            }
+            std::size_t count = i - first;
+            std::uint16_t cells[GlyphAtlas::CELL_W * GlyphAtlas::CELL_H * 4];
+            // Der Zwischenspeicher fasst vier Zellen; längere Folgen in Teilen übertragen
+            for (std::size_t part = 0; part < count; part += 4) {
+                std::size_t partCount = count - part < 4 ? count - part : 4;
+                atlas.compose(glyphs + part, partCount, color, background, cells);
+                std::int16_t left = x + static_cast<std::int16_t>((first + part) * GlyphAtlas::CELL_W);
+                std::int16_t width = static_cast<std::int16_t>(partCount * GlyphAtlas::CELL_W);
+                tft.startWrite();
+                tft.setWindow(left, y, left + width - 1, y + GlyphAtlas::CELL_H - 1);
+                tft.pushColors(cells, static_cast<std::uint32_t>(width) * GlyphAtlas::CELL_H, true);
+                tft.endWrite();
+                pixels += static_cast<std::uint32_t>(width) * GlyphAtlas::CELL_H;
+            }
+        }
+        colorChanged = false;
+        return pixels;
+    }
+};
+
+/**
+ * @brief Bildschirm aus mehreren Elementen; überträgt nur die geänderten Bereiche
+ */
+class UiScreen
+{
+public:
+    static const std::size_t MAX_ELEMENTS = 12;
+
+private:
+    UiElement *elements[MAX_ELEMENTS];
+    std::size_t count = 0;
+    std::uint16_t background;
+    bool clearPending = true;
+
+public:
+    explicit UiScreen(std::uint16_t background) : background(background) {}
+
+    /**
+     * @return false, wenn kein Platz mehr frei ist
+     */
+    bool add(UiElement &element)
+    {
+        if (count >= MAX_ELEMENTS) {
+            return false;
+        }
+        elements[count++] = &element;
+        return true;
+    }
+
+    /**
+     * @brief Der Bildschirm wurde von einer anderen Anzeige überschrieben: beim nächsten render() komplett neu aufbauen.
+     * @param [in] cleared true, wenn der Aufrufer den Bildschirm bereits in der Hintergrundfarbe gelöscht hat;
+     *                     render() zeichnet dann nur die Elemente neu und löscht nicht ein zweites Mal
+     */
+    void invalidate(bool cleared = false)
+    {
+        clearPending = !cleared;
+        if (cleared) {
+            for (std::size_t i = 0; i < count; i++) {
+                elements[i]->invalidate(true);
+            }
+        }
+    }
+
+    /**
+     * @brief Zeichnet alle geänderten Elemente bzw. nach invalidate() den ganzen Bildschirm.
+     * @return Anzahl der übertragenen Pixel
+     */
+    std::uint32_t render(TFT_eSPI &tft)
+    {
+        std::uint32_t pixels = 0;
+        if (clearPending) {
+            tft.fillScreen(background);
+            pixels += static_cast<std::uint32_t>(tft.width()) * static_cast<std::uint32_t>(tft.height());
+            for (std::size_t i = 0; i < count; i++) {
+                elements[i]->invalidate(true);
+            }
+            clearPending = false;
+        }
+        for (std::size_t i = 0; i < count; i++) {
+            pixels += elements[i]->render(tft, background);
+        }
+        return pixels;
+    }
+};
+#endif // ARDUINO
+
+#endif //UI_COMPOSITOR_HPP__
@@ -0,0 +1,257 @@
+// Bewässerung als Zustandsautomat: Hysterese, Mindestlaufzeiten, Einwirkzeit und Tagesbudget der Pumpe
+/**
+ * @file watering_controller.hpp
+*/
+
+#ifndef WATERING_CONTROLLER_HPP__
+#define WATERING_CONTROLLER_HPP__
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * @brief Schwellen und Zeiten der Bewässerung
+ */
+struct WateringConfig {
+    std::uint16_t startAtOrBelow = 200;     // Ein Gießzyklus beginnt, wenn die Feuchte höchstens so hoch ist
+    std::uint16_t stopAbove = 300;          // und endet, sobald sie darüber liegt (Hysterese)
+    std::uint32_t minOnTime = 2000;         // ms, kürzeste Pumpzeit pro Gabe
+    std::uint32_t maxOnTime = 8000;         // ms, längste Pumpzeit pro Gabe
+    std::uint32_t minOffTime = 30000;       // ms zwischen zwei Gaben (auch ohne Einwirkzeit)
+    std::uint32_t soakTime = 120000;        // ms nach einer Gabe, in denen Messwerte nicht bewertet werden
+    std::uint32_t dailyBudget = 60000;      // ms Pumpzeit in beliebigen 24 Stunden
+};
+
+/**
+ * @brief Eine abgeschlossene Wassergabe
+ */
+struct WateringDose {
+    std::uint32_t start = 0;          // millis() beim Einschalten
+    std::uint32_t duration = 0;       // ms Pumpzeit
+    std::uint16_t moistureBefore = 0; // Letzter Messwert vor der Gabe
+    std::uint16_t moistureAtStop = 0; // Letzter Messwert beim Ausschalten (Wasser ist meist noch nicht am Sensor)
+    std::uint32_t budgetUsed = 0;     // ms Pumpzeit der letzten 24 Stunden einschließlich dieser Gabe
+    bool budgetLimited = false;       // Gabe wurde wegen des Tagesbudgets beendet
+};
+
+/**
+ * @brief Zähler der Bewässerung
+ */
+struct WateringStats {
+    std::uint32_t doses = 0;          // Wassergaben
+    std::uint32_t switches = 0;       // Schaltvorgänge des Relais (ein und aus)
+    std::uint64_t totalOnTime = 0;    // ms Pumpzeit seit dem Start
+    std::uint32_t budgetStops = 0;    // Gaben, die das Tagesbudget beendet hat
+    std::uint32_t staleStops = 0;     // Gaben, die wegen fehlender Messwerte beendet wurden
+};
+
+/**
+ * @brief Entscheidet an einer Stelle, wann die Pumpe läuft
+ *
+ * Ein Gießzyklus beginnt bei Feuchte <= startAtOrBelow und besteht aus Gaben von minOnTime bis maxOnTime.
+ * Nach jeder Gabe ruht die Pumpe mindestens soakTime bzw. minOffTime, damit das Wasser den Sensor erreicht;
+ * erst dann wird neu bewertet. Der Zyklus endet, sobald die Feuchte über stopAbove liegt. Liegt der Wert
+ * zwischen den Schwellen, bleibt der Zustand erhalten; so schaltet das Relais an einer Schwelle nicht hin
+ * und her.
+ *
+ * Das Tagesbudget gilt für jedes 24-Stunden-Fenster, nicht für feste Tage: die Gaben stehen in einem Ring
+ * und zählen vollständig, bis ihr Ende 24 Stunden zurückliegt. Mehr als dailyBudget Pumpzeit in 24 Stunden
+ * gibt es so nie. Ist der Ring voll, beginnt die nächste Gabe erst, wenn die älteste herausfällt.
+ */
+class WateringController
+{
+public:
+    enum State {
+        IDLE,    // Feucht genug bzw. Zyklus beendet
+        PUMPING, // Relais ein
+        SOAKING, // Relais aus, Wasser zieht ein
+        LOCKED   // Tagesbudget verbraucht
+    };
+
+    static const std::uint32_t BUDGET_PERIOD = 86400000UL; // 24 Stunden in ms
+    static const std::size_t MAX_PENDING_DOSES = 4;
+    static const std::size_t MAX_BUDGET_DOSES = 32; // Gaben im 24-Stunden-Fenster (60 s Budget / 2 s kürzeste Gabe = 30)
+
+private:
+    WateringConfig config;
+    State state = IDLE;
+    bool cycleActive = false;     // Zyklus läuft, bis die Feuchte über stopAbove liegt
+    std::uint32_t stateTime = 0;  // Beginn des aktuellen Zustands
+    std::uint32_t lastOffTime = 0;
+    bool everOff = false;
+    // Gaben der letzten 24 Stunden, älteste bei budgetHead
+    struct BudgetEntry {
+        std::uint32_t start;
+        std::uint32_t duration;
+    };
+    BudgetEntry budgetDoses[MAX_BUDGET_DOSES];
+    std::size_t budgetHead = 0;
+    std::size_t budgetCount = 0;
+    std::uint32_t budgetUsed = 0; // Summe der Gaben im Ring
+    std::uint16_t lastMoisture = 0;
+    WateringDose current;
+    WateringDose pending[MAX_PENDING_DOSES];
+    std::size_t pendingCount = 0;
+    WateringStats stats;
+
+    // Gaben entfernen, deren Ende mindestens 24 Stunden zurückliegt
+    void expireBudget(std::uint32_t now)
+    {
+        while (budgetCount > 0) {
+            const BudgetEntry &oldest = budgetDoses[budgetHead];
+            if (now - (oldest.start + oldest.duration) < BUDGET_PERIOD) {
+                break;
+            }
+            budgetUsed -= oldest.duration;
+            budgetHead = (budgetHead + 1) % MAX_BUDGET_DOSES;
+            budgetCount--;
+        }
+    }
+
+    bool budgetAllows(std::uint32_t onTime) const
+    {
+        return budgetCount < MAX_BUDGET_DOSES && budgetUsed + onTime <= config.dailyBudget;
+    }
+
+    std::uint32_t pumpedSoFar(std::uint32_t now) const { return state == PUMPING ? now - stateTime : 0; }
+
+    void switchOn(std::uint32_t now)
+    {
+        current = WateringDose();
+        current.start = now;
+        current.moistureBefore = lastMoisture;
+        state = PUMPING;
+        stateTime = now;
+        stats.switches++;
+    }
+
+    void switchOff(std::uint32_t now, State next)
+    {
+        std::uint32_t duration = now - stateTime;
+        // Platz ist immer frei: switchOn() startet nur, wenn budgetAllows() gilt
+        BudgetEntry &entry = budgetDoses[(budgetHead + budgetCount) % MAX_BUDGET_DOSES];
+        entry.start = stateTime;
+        entry.duration = duration;
+        budgetCount++;
+        budgetUsed += duration;
+        current.duration = duration;
+        current.moistureAtStop = lastMoisture;
+        current.budgetUsed = budgetUsed;
+        if (pendingCount < MAX_PENDING_DOSES) {
+            pending[pendingCount++] = current;
+        }
+        stats.doses++;
+        stats.switches++;
+        stats.totalOnTime += duration;
+        lastOffTime = now;
+        everOff = true;
+        state = next;
+        stateTime = now;
+    }
+
+public:
+    explicit WateringController(const WateringConfig &config = WateringConfig()) : config(config) {}
+
+    /**
+     * @brief Übernimmt neue Schwellen (z.B. nach einem Moduswechsel); eine laufende Gabe wird nach den neuen Zeiten beendet.
+     */
+    void setConfig(const WateringConfig &newConfig) { config = newConfig; }
+    const WateringConfig &getConfig() const { return config; }
+
+    /**
+     * @brief Schaltet den Automaten weiter; regelmäßig (einige Male pro Sekunde) aufrufen.
+     * @param [in] moisture Letzter Messwert
+     * @param [in] valid false, wenn kein aktueller Messwert vorliegt; dann wird nicht gepumpt
+     * @return true, wenn das Relais eingeschaltet sein soll
+     */
+    bool update(std::uint16_t moisture, bool valid, std::uint32_t now)
+    {
+        expireBudget(now);
+        if (valid) {
+            lastMoisture = moisture;
+        }
+
+        switch (state) {
+        case PUMPING: {
+            std::uint32_t onTime = now - stateTime;
+            if (!valid) {
+                stats.staleStops++;
+                switchOff(now, SOAKING);
+            } else if (budgetUsed + onTime >= config.dailyBudget) {
+                current.budgetLimited = true;
+                stats.budgetStops++;
+                switchOff(now, LOCKED);
+            } else if (onTime >= config.maxOnTime || (onTime >= config.minOnTime && moisture > config.stopAbove)) {
+                switchOff(now, SOAKING);
+            }
+            break;
+        }
+        case SOAKING:
+            if (now - stateTime >= config.soakTime) {
+                state = IDLE;
+                stateTime = now;
+            }
+            break;
+        case LOCKED:
+            if (budgetAllows(config.minOnTime)) {
+                state = IDLE;
+                stateTime = now;
+            }
+            break;
+        case IDLE:
+            break;
+        }
+
+        if (state == IDLE && valid) {
+            if (moisture > config.stopAbove) {
+                cycleActive = false;
+            } else if (moisture <= config.startAtOrBelow) {
+                cycleActive = true;
+            }
+            bool restedEnough = !everOff || now - lastOffTime >= config.minOffTime;
+            if (cycleActive && restedEnough) {
+                if (!budgetAllows(config.minOnTime)) {
+                    state = LOCKED;
+                    stateTime = now;
+                } else {
+                    switchOn(now);
+                }
+            }
+        }
+        return state == PUMPING;
+    }
+
+    /**
+     * @brief Holt die älteste noch nicht gemeldete Gabe ab.
+     * @return false, wenn keine Gabe wartet
+     */
+    bool popDose(WateringDose &dose)
+    {
+        if (pendingCount == 0) {
+            return false;
+        }
+        dose = pending[0];
+        for (std::size_t i = 1; i < pendingCount; i++) {
+            pending[i - 1] = pending[i];
+        }
+        pendingCount--;
+        return true;
+    }
+
+    State getState() const { return state; }
+    bool isPumping() const { return state == PUMPING; }
+    std::uint32_t getBudgetUsed(std::uint32_t now) const { return budgetUsed + pumpedSoFar(now); }
+    const WateringStats &getStats() const { return stats; }
+
+    static const char *stateName(State state)
+    {
+        switch (state) {
+        case PUMPING: return "pumpt";
+        case SOAKING: return "zieht ein";
+        case LOCKED: return "Budget aufgebraucht";
+        default: return "bereit";
+        }
+    }
+};
+
+#endif //WATERING_CONTROLLER_HPP__
@@ -0,0 +1,323 @@
+// Host-Werkzeug für die binären Logdateien des Wio Terminals (Verzeichnis /logs der SD-Karte)
+//
+// Übersetzen:  g++ -std=c++11 -O2 -Wall -o aqualog tools/aqualog.cpp
+// Verwendung:  aqualog export <datei> [ausgabe.csv]         Datensätze einer Datei als CSV ausgeben
+//              aqualog validate <datei>                     Dateikopf, Block-CRCs und Index prüfen
+//              aqualog range <verzeichnis> <von> <bis>      Zeitbereich über alle Dateien als CSV ausgeben
+//                                                           (Zeit als Epoch-Sekunden oder JJJJ-MM-TT[THH:MM:SS])
+//
+// Exit-Code 0 = Datei in Ordnung, 1 = Formatfehler, 2 = Aufruf- oder Dateifehler
+
+#include "../src/log_format.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+
+// Ergebnis beim Einlesen einer Logdatei
+struct LogScan {
+    LogFileHeader header;
+    std::vector<LogRecord> records;
+    std::uint32_t blocks = 0;
+    std::uint32_t badBlocks = 0;
+};
+
+// Liest beide Fächer des Dateikopfs und wählt den neueren gültigen
+static bool readLogFileHeader(std::FILE *file, LogFileHeader &header)
+{
+    std::uint8_t slots[LOG_HEADER_SECTORS * LOG_SECTOR_SIZE];
+    return std::fseek(file, 0, SEEK_SET) == 0 && std::fread(slots, 1, sizeof(slots), file) == sizeof(slots)
+        && selectLogFileHeader(slots, slots + LOG_SECTOR_SIZE, header);
+}
+
+// Liest einen bestätigten Block von seiner festen Position bzw. den angefangenen aus dem Blockfach
+static bool readLogBlock(std::FILE *file, const LogFileHeader &header, std::uint32_t block, std::uint8_t *sector)
+{
+    return std::fseek(file, static_cast<long>(logCommittedBlockOffset(header, block)), SEEK_SET) == 0
+        && std::fread(sector, 1, LOG_SECTOR_SIZE, file) == LOG_SECTOR_SIZE;
+}
+
+// Liest alle bestätigten Datensätze; Blöcke mit falscher CRC werden gezählt und übersprungen
+static bool scanLogFile(const char *path, LogScan &scan)
+{
+    std::FILE *file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        std::fprintf(stderr, "%s: Datei kann nicht geöffnet werden\n", path);
+        return false;
+    }
+
+    std::uint8_t sector[LOG_SECTOR_SIZE];
+    if (!readLogFileHeader(file, scan.header)) {
+        std::fprintf(stderr, "%s: ungültiger Dateikopf\n", path);
+        std::fclose(file);
+        return false;
+    }
+
+    std::uint32_t remaining = scan.header.committedRecords;
+    for (std::uint32_t block = 0; remaining > 0; block++) {
+        if (!readLogBlock(file, scan.header, block, sector)) {
+            std::fprintf(stderr, "%s: Datei endet vor Block %u, %u Datensätze fehlen\n", path,
+                         static_cast<unsigned>(block), static_cast<unsigned>(remaining));
+            scan.badBlocks++;
+            break;
+        }
+        scan.blocks++;
+
+        std::uint16_t count = 0;
+        std::uint32_t expected = remaining < LOG_RECORDS_PER_BLOCK ? remaining : LOG_RECORDS_PER_BLOCK;
+        if (!checkLogBlock(sector, block, count) || count < expected) {
+            std::fprintf(stderr, "%s: Block %u beschädigt (CRC oder Anzahl)\n", path, static_cast<unsigned>(block));
+            scan.badBlocks++;
+            remaining -= expected;
+            continue;
+        }
+        for (std::uint32_t i = 0; i < expected; i++) {
+            scan.records.push_back(decodeLogRecord(sector + LOG_BLOCK_HEADER_SIZE + i * LOG_RECORD_SIZE));
+        }
+        remaining -= expected;
+    }
+
+    std::fclose(file);
+    return true;
+}
+
+// Hundertstel ohne Rundungsfehler als Dezimalzahl ausgeben
+static void printCentis(std::FILE *out, std::int16_t value)
+{
+    int v = value;
+    std::fprintf(out, "%s%d.%02d", v < 0 ? "-" : "", (v < 0 ? -v : v) / 100, (v < 0 ? -v : v) % 100);
+}
+
+static void printCsvHeader(std::FILE *out)
+{
+    std::fprintf(out, "Epoch,Datum,Zeit,Feuchtigkeit_Pflanze,Temperatur,Luftfeuchtigkeit\n");
+}
+
+static void printCsvRow(std::FILE *out, const LogRecord &record)
+{
+    // Die RTC läuft in Ortszeit, daher ohne Zeitzonen-Umrechnung formatieren
+    std::time_t t = static_cast<std::time_t>(record.epoch);
+    std::tm tm = *std::gmtime(&t);
+    char date[16];
+    char time[16];
+    std::strftime(date, sizeof(date), "%Y-%m-%d", &tm);
+    std::strftime(time, sizeof(time), "%H:%M:%S", &tm);
+    std::fprintf(out, "%u,%s,%s,%u,", static_cast<unsigned>(record.epoch), date, time, static_cast<unsigned>(record.moisture));
+    printCentis(out, record.temperature);
+    std::fputc(',', out);
+    printCentis(out, record.humidity);
+    std::fputc('\n', out);
+}
+
+// Liest den Blockindex (<name>.IDX) zu einer Datendatei (<name>.DAT)
+static bool readLogIndex(const std::string &dataPath, std::vector<LogIndexEntry> &entries)
+{
+    std::string path = dataPath.substr(0, dataPath.size() - 3) + (dataPath.compare(dataPath.size() - 3, 3, "dat") == 0 ? "idx" : "IDX");
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    std::uint8_t encoded[LOG_INDEX_ENTRY_SIZE];
+    while (std::fread(encoded, 1, LOG_INDEX_ENTRY_SIZE, file) == LOG_INDEX_ENTRY_SIZE) {
+        entries.push_back(decodeLogIndexEntry(encoded));
+    }
+    std::fclose(file);
+    return true;
+}
+
+static int exportCsv(const char *path, const char *outPath)
+{
+    LogScan scan;
+    if (!scanLogFile(path, scan)) {
+        return 2;
+    }
+
+    std::FILE *out = stdout;
+    if (outPath != nullptr) {
+        out = std::fopen(outPath, "w");
+        if (out == nullptr) {
+            std::fprintf(stderr, "%s: Datei kann nicht erstellt werden\n", outPath);
+            return 2;
+        }
+    }
+
+    printCsvHeader(out);
+    for (const LogRecord &record : scan.records) {
+        printCsvRow(out, record);
+    }
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return scan.badBlocks == 0 ? 0 : 1;
+}
+
+static int validate(const char *path)
+{
+    LogScan scan;
+    if (!scanLogFile(path, scan)) {
+        return 2;
+    }
+
+    std::uint32_t backwards = 0;
+    for (std::size_t i = 1; i < scan.records.size(); i++) {
+        if (scan.records[i].epoch < scan.records[i - 1].epoch) {
+            backwards++;
+        }
+    }
+
+    // Jeder bestätigte Block braucht einen Indexeintrag mit seinem ersten Zeitstempel und Offset
+    std::vector<LogIndexEntry> index;
+    std::uint32_t indexErrors = 0;
+    bool hasIndex = readLogIndex(path, index);
+    for (std::uint32_t block = 0; block < scan.blocks; block++) {
+        std::size_t first = block * LOG_RECORDS_PER_BLOCK;
+        if (block >= index.size() || first >= scan.records.size()
+            || index[block].firstEpoch != scan.records[first].epoch || index[block].offset != logBlockOffset(block)) {
+            indexErrors++;
+        }
+    }
+
+    std::printf("Version:          %u\n", static_cast<unsigned>(scan.header.version));
+    std::printf("Commit-Sequenz:   %u\n", static_cast<unsigned>(scan.header.commitSequence));
+    std::printf("Datensätze:       %u\n", static_cast<unsigned>(scan.header.committedRecords));
+    std::printf("Blöcke:           %u (%u beschädigt)\n", static_cast<unsigned>(scan.blocks), static_cast<unsigned>(scan.badBlocks));
+    std::printf("Zeitraum:         %u s ab %u\n", static_cast<unsigned>(scan.header.partitionSpan), static_cast<unsigned>(scan.header.partitionStart));
+    std::printf("Zeitrücksprünge:  %u\n", static_cast<unsigned>(backwards));
+    std::printf("Index:            %s, %u fehlerhafte Einträge\n", hasIndex ? "vorhanden" : "fehlt", static_cast<unsigned>(indexErrors));
+    return scan.badBlocks == 0 && indexErrors == 0 ? 0 : 1;
+}
+
+// Zeitangabe als Epoch-Sekunden oder JJJJ-MM-TT[THH:MM:SS] lesen
+static bool parseTime(const char *text, std::uint32_t &epoch)
+{
+    int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+    if (std::strchr(text, '-') == nullptr) {
+        char *end = nullptr;
+        epoch = static_cast<std::uint32_t>(std::strtoul(text, &end, 10));
+        return end != text && *end == '\0';
+    }
+    int fields = std::sscanf(text, "%d-%d-%dT%d:%d:%d", &year, &month, &day, &hour, &minute, &second);
+    if (fields != 3 && fields != 6) {
+        return false;
+    }
+    // Tage seit 1970 ("days_from_civil" von H. Hinnant)
+    year -= month <= 2 ? 1 : 0;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    unsigned yearOfEra = static_cast<unsigned>(year - era * 400);
+    unsigned dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    long days = era * 146097L + static_cast<long>(dayOfEra) - 719468;
+    epoch = static_cast<std::uint32_t>(days * 86400 + hour * 3600 + minute * 60 + second);
+    return true;
+}
+
+// Eine Datei eines Zeitbereichs: binäre Suche im Index, dann sequentielles Lesen ab dem gefundenen Block
+static std::uint32_t printRangeFromFile(const std::string &path, const LogFileHeader &header, std::uint32_t from, std::uint32_t to, std::uint32_t &badBlocks)
+{
+    std::vector<LogIndexEntry> index;
+    std::uint32_t startBlock = 0;
+    if (readLogIndex(path, index) && !index.empty()) {
+        startBlock = static_cast<std::uint32_t>(findLogBlock(index.data(), index.size(), from));
+    }
+
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        badBlocks++;
+        return 0;
+    }
+
+    std::uint32_t printed = 0;
+    std::uint8_t sector[LOG_SECTOR_SIZE];
+    for (std::uint32_t block = startBlock; block * LOG_RECORDS_PER_BLOCK < header.committedRecords; block++) {
+        std::uint16_t count = 0;
+        if (!readLogBlock(file, header, block, sector) || !checkLogBlock(sector, block, count)) {
+            badBlocks++;
+            continue;
+        }
+        std::uint32_t committed = header.committedRecords - block * LOG_RECORDS_PER_BLOCK;
+        if (count > committed) count = static_cast<std::uint16_t>(committed);
+        for (std::uint16_t i = 0; i < count; i++) {
+            LogRecord record = decodeLogRecord(sector + LOG_BLOCK_HEADER_SIZE + i * LOG_RECORD_SIZE);
+            if (record.epoch > to) {
+                std::fclose(file);
+                return printed;
+            }
+            if (record.epoch >= from) {
+                printCsvRow(stdout, record);
+                printed++;
+            }
+        }
+    }
+    std::fclose(file);
+    return printed;
+}
+
+static int printRange(const char *directory, std::uint32_t from, std::uint32_t to)
+{
+    DIR *dir = opendir(directory);
+    if (dir == nullptr) {
+        std::fprintf(stderr, "%s: Verzeichnis kann nicht geöffnet werden\n", directory);
+        return 2;
+    }
+
+    // Dateien anhand ihres Kopfs auswählen, die den Zeitbereich überschneiden
+    std::vector<std::pair<LogFileHeader, std::string> > files;
+    while (struct dirent *entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name.size() < 4 || (name.compare(name.size() - 4, 4, ".DAT") != 0 && name.compare(name.size() - 4, 4, ".dat") != 0)) {
+            continue;
+        }
+        std::string path = std::string(directory) + "/" + name;
+        std::FILE *file = std::fopen(path.c_str(), "rb");
+        LogFileHeader header;
+        bool valid = file != nullptr && readLogFileHeader(file, header);
+        if (file != nullptr) std::fclose(file);
+        if (!valid) {
+            std::fprintf(stderr, "%s: ungültiger Dateikopf, übersprungen\n", path.c_str());
+            continue;
+        }
+        if (header.partitionStart <= to && header.partitionStart + header.partitionSpan > from) {
+            files.push_back(std::make_pair(header, path));
+        }
+    }
+    closedir(dir);
+
+    std::sort(files.begin(), files.end(), [](const std::pair<LogFileHeader, std::string> &a, const std::pair<LogFileHeader, std::string> &b) {
+        return a.first.partitionStart < b.first.partitionStart;
+    });
+
+    std::uint32_t badBlocks = 0;
+    std::uint32_t printed = 0;
+    printCsvHeader(stdout);
+    for (const auto &file : files) {
+        printed += printRangeFromFile(file.second, file.first, from, to, badBlocks);
+    }
+    std::fprintf(stderr, "%u Datensätze aus %u Dateien\n", static_cast<unsigned>(printed), static_cast<unsigned>(files.size()));
+    return badBlocks == 0 ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && std::strcmp(argv[1], "export") == 0) {
+        return exportCsv(argv[2], argc >= 4 ? argv[3] : nullptr);
+    }
+    if (argc == 3 && std::strcmp(argv[1], "validate") == 0) {
+        return validate(argv[2]);
+    }
+    std::uint32_t from = 0;
+    std::uint32_t to = 0;
+    if (argc == 5 && std::strcmp(argv[1], "range") == 0 && parseTime(argv[3], from) && parseTime(argv[4], to)) {
+        return printRange(argv[2], from, to);
+    }
+    std::fprintf(stderr, "Verwendung: %s export <datei> [ausgabe.csv]\n"
+                         "            %s validate <datei>\n"
+                         "            %s range <verzeichnis> <von> <bis>\n", argv[0], argv[0], argv[0]);
+    return 2;
+}
@@ -0,0 +1,127 @@
+// Host-Prüfung und Benchmark des Bogen-Rasterizers (src/arc_raster.hpp) gegen das frühere drawArc() mit float
+//
+// Übersetzen:  g++ -std=c++11 -O2 -Wall -o arc_bench tools/arc_bench.cpp
+// Verwendung:  arc_bench
+//
+// Vergleicht für typische Bögen die Pixelabdeckung mit der bisherigen Ausgabe und zählt die SPI-Transaktionen
+// (ein drawPixel bzw. ein drawFastHLine ist je ein Adressfenster). Exit-Code 0 = alle Prüfungen bestanden, 1 = Abweichung
+
+#include "../src/arc_raster.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <set>
+#include <utility>
+
+typedef std::set<std::pair<int, int> > PixelSet;
+
+struct ArcCase {
+    const char *name;
+    int r;
+    int thickness;
+    int startAngle;
+    int endAngle;
+};
+
+// Bisheriges drawArc(): ein Punkt pro Grad plus thickness Pixel waagrecht daneben, jedes als eigener drawPixel-Aufruf
+static unsigned referenceArc(const ArcCase &arc, PixelSet &pixels)
+{
+    unsigned transactions = 0;
+    for (int i = arc.startAngle; i <= arc.endAngle; i++) {
+        float angle = i * 3.14159 / 180.0;
+        int x0 = static_cast<int>(std::cos(angle) * arc.r);
+        int y0 = -static_cast<int>(std::sin(angle) * arc.r);
+        pixels.insert(std::make_pair(x0, y0));
+        transactions++;
+        for (int j = -arc.thickness / 2; j < arc.thickness / 2; j++) {
+            pixels.insert(std::make_pair(x0 + j, y0));
+            transactions++;
+        }
+    }
+    return transactions;
+}
+
+static bool nearAny(const PixelSet &pixels, int x, int y)
+{
+    for (int dy = -1; dy <= 1; dy++) {
+        for (int dx = -1; dx <= 1; dx++) {
+            if (pixels.count(std::make_pair(x + dx, y + dy)) != 0) return true;
+        }
+    }
+    return false;
+}
+
+static bool checkSineTable()
+{
+    for (int degrees = -360; degrees <= 720; degrees++) {
+        double expected = std::sin(degrees * M_PI / 180.0) * (1 << ARC_TRIG_SHIFT);
+        if (std::fabs(arcSin(degrees) - expected) > 1.0 || std::fabs(arcCos(degrees) - std::cos(degrees * M_PI / 180.0) * (1 << ARC_TRIG_SHIFT)) > 1.0) {
+            std::fprintf(stderr, "Sinustabelle: Abweichung bei %d Grad\n", degrees);
+            return false;
+        }
+    }
+    for (std::uint32_t value = 0; value < 200000; value++) {
+        std::uint32_t root = arcIsqrt(value);
+        if (root * root > value || (root + 1) * (root + 1) <= value) {
+            std::fprintf(stderr, "Wurzel: falsch für %u\n", static_cast<unsigned>(value));
+            return false;
+        }
+    }
+    return true;
+}
+
+int main()
+{
+    const ArcCase cases[] = {
+        {"Mund froh", 25, 4, 180, 360},
+        {"Mund traurig", 25, 4, 0, 180},
+        {"Viertelbogen", 40, 6, 45, 135},
+        {"Dreiviertel", 30, 3, 0, 270},
+        {"Vollkreis", 20, 2, 0, 360},
+        {"Duenn", 15, 1, 200, 340},
+    };
+
+    bool ok = checkSineTable();
+    std::printf("%-14s %9s %8s %9s %8s %10s %10s\n", "Bogen", "alt SPI", "alt Px", "neu SPI", "neu Px", "Abdeckung", "Naehe");
+    for (const ArcCase &arc : cases) {
+        PixelSet reference;
+        unsigned oldTransactions = referenceArc(arc, reference);
+
+        PixelSet raster;
+        unsigned emitted = 0;
+        bool duplicate = false;
+        unsigned spans = rasterizeArc(0, 0, arc.r, arc.thickness, arc.startAngle, arc.endAngle, [&](int x, int y, int width) {
+            for (int i = 0; i < width; i++) {
+                duplicate = !raster.insert(std::make_pair(x + i, y)).second || duplicate;
+                emitted++;
+            }
+        });
+
+        // Abdeckung: Anteil der bisherigen Pixel, die auch neu gesetzt werden bzw. höchstens 1 Pixel daneben liegen
+        unsigned covered = 0;
+        for (const auto &p : reference) {
+            if (nearAny(raster, p.first, p.second)) covered++;
+        }
+        // Nähe: Anteil der neuen Pixel, die höchstens 1 Pixel neben einem bisherigen liegen
+        unsigned near = 0;
+        for (const auto &p : raster) {
+            if (nearAny(reference, p.first, p.second)) near++;
+        }
+        double coverage = 100.0 * covered / reference.size();
+        double nearness = 100.0 * near / raster.size();
+        std::printf("%-14s %9u %8u %9u %8u %9.1f%% %9.1f%%\n", arc.name, oldTransactions, static_cast<unsigned>(reference.size()),
+                    spans, static_cast<unsigned>(raster.size()), coverage, nearness);
+
+        if (duplicate || emitted != raster.size()) {
+            std::fprintf(stderr, "%s: Pixel mehrfach ausgegeben\n", arc.name);
+            ok = false;
+        }
+        // Die Nähe ist nur Information: der alte Bogen war nur waagrecht dick, der neue ist überall gleich dick
+        if (coverage < 95.0 || spans >= oldTransactions / 4) {
+            std::fprintf(stderr, "%s: Abdeckung oder Anzahl der Transaktionen außerhalb der Grenzen\n", arc.name);
+            ok = false;
+        }
+    }
+    std::printf("%s\n", ok ? "Alle Prüfungen bestanden" : "Prüfung fehlgeschlagen");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+// Host-Simulation der Tastenauswertung (src/button_events.hpp) gegen die bisherige Abfrage per digitalRead() in loop()
+//
+// Übersetzen:  g++ -std=c++11 -O2 -Wall -o button_sim tools/button_sim.cpp
+// Verwendung:  button_sim [loop_ms] [prellen_ms]     (Standard 2 ms pro loop(), bis 8 ms Prellen)
+//
+// Erzeugt wird ein Pegelverlauf mit kurzen und langen Tastendrücken, die an jeder Flanke prellen, sowie einzelnen
+// Störimpulsen von 1 ms (fester Startwert, reproduzierbar). Die neue Auswertung läuft im 1-ms-Takt, aber nur, solange
+// eine Taste prellt oder auf langes Drücken gewartet wird. Die bisherige Logik (pollHoldKey() aus main.cpp) liest einmal
+// pro loop() ohne Entprellung. Verglichen werden erkannte kurze und lange Drücke mit den tatsächlichen; zusätzlich
+// werden Wiederholungen und die Warteschlange (Umlauf, Überlauf) geprüft.
+// Exit-Code 0 = neue Auswertung erkennt alles richtig, 1 = Abweichung, 2 = Aufruffehler
+
+#include "../src/button_events.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static const std::uint32_t LONG_PRESS = 2000; // ms, wie keyHoldTime in main.cpp
+
+struct Counts {
+    unsigned shortPresses = 0;
+    unsigned longPresses = 0;
+};
+
+// Bisherige Auswertung aus main.cpp
+struct HoldKey {
+    bool down = false;
+    bool longPress = false;
+    std::uint32_t pressTime = 0;
+
+    void poll(bool pressed, std::uint32_t now, Counts &counts)
+    {
+        if (pressed && !down) {
+            down = true;
+            longPress = false;
+            pressTime = now;
+        } else if (pressed && !longPress && now - pressTime >= LONG_PRESS) {
+            longPress = true;
+            counts.longPresses++;
+        } else if (!pressed && down) {
+            down = false;
+            if (!longPress) counts.shortPresses++;
+        }
+    }
+};
+
+// Pegel pro Millisekunde (true = gedrückt) mit den tatsächlichen Drücken
+static std::vector<bool> synthesize(unsigned bounceMillis, Counts &truth, unsigned &glitches)
+{
+    std::mt19937 random(20261017);
+    std::uniform_int_distribution<int> pause(300, 1500);
+    std::uniform_int_distribution<int> shortHold(60, 400);
+    std::uniform_int_distribution<int> longHold(2300, 4000);
+    std::uniform_int_distribution<int> chance(0, 99);
+    std::vector<bool> level;
+    // Prellen: in den ersten bounceMillis nach der Flanke zufällig wechselnde Pegel
+    auto segment = [&](bool pressed, int length) {
+        for (int i = 0; i < length; i++) {
+            bool bouncing = static_cast<unsigned>(i) < bounceMillis;
+            level.push_back(bouncing && chance(random) < 40 ? !pressed : pressed);
+        }
+    };
+    for (int press = 0; press < 200; press++) {
+        int idle = pause(random);
+        segment(false, idle);
+        if (chance(random) < 15) {
+            // Störimpuls im Ruhezustand, kein Tastendruck
+            level[level.size() - idle / 2] = true;
+            glitches++;
+        }
+        bool isLong = chance(random) < 25;
+        segment(true, isLong ? longHold(random) : shortHold(random));
+        if (isLong) {
+            truth.longPresses++;
+        } else {
+            truth.shortPresses++;
+        }
+    }
+    segment(false, 1000);
+    return level;
+}
+
+static bool check(bool condition, const char *what)
+{
+    std::printf("  %-64s %s\n", what, condition ? "ok" : "FEHLER");
+    return condition;
+}
+
+// Wiederholungen nach langem Drücken und Reihenfolge der Ereignisse
+static bool testRepeat()
+{
+    ButtonGestureTracker tracker;
+    ButtonEventQueue queue;
+    ButtonTiming timing;
+    timing.longPressTime = LONG_PRESS;
+    timing.repeatInterval = 250;
+    tracker.setTiming(0, timing);
+    for (std::uint32_t now = 0; now < 4000; now++) {
+        tracker.update(0, now >= 100 && now < 3100, now, queue);
+    }
+    // Entprellt gedrückt bei 120, LONG bei 2120, REPEAT bei 2370, 2620 und 2870, entprellt losgelassen bei 3120
+    std::vector<ButtonGesture> expected = {BUTTON_DOWN, BUTTON_LONG, BUTTON_REPEAT, BUTTON_REPEAT, BUTTON_REPEAT, BUTTON_UP};
+    std::vector<ButtonGesture> seen;
+    ButtonEvent event;
+    std::uint32_t longTime = 0;
+    while (queue.pop(event)) {
+        seen.push_back(event.gesture);
+        if (event.gesture == BUTTON_LONG) longTime = event.time;
+    }
+    bool ok = check(seen == expected, "Wiederholung: DOWN, LONG, 3x REPEAT, UP (kein SHORT)");
+    ok &= check(longTime == 120 + LONG_PRESS, "LONG genau longPressTime nach dem entprellten Drücken");
+    return ok;
+}
+
+// Umlauf der Indizes und Überlauf der Warteschlange
+static bool testQueue()
+{
+    ButtonEventQueue queue;
+    ButtonEvent event;
+    bool ok = true;
+    unsigned order = 0;
+    for (unsigned round = 0; round < 100; round++) {
+        for (unsigned i = 0; i < 3; i++) {
+            event.time = round * 3 + i;
+            queue.push(event);
+        }
+        while (queue.pop(event)) ok &= event.time == order++;
+    }
+    ok = check(ok && order == 300, "Warteschlange: 300 Ereignisse über viele Umläufe in Reihenfolge");
+    for (unsigned i = 0; i < ButtonEventQueue::CAPACITY + 5; i++) {
+        event.time = i;
+        queue.push(event);
+    }
+    unsigned popped = 0;
+    bool first = queue.pop(event) && event.time == 0;
+    popped = first ? 1 : 0;
+    while (queue.pop(event)) popped++;
+    ok &= check(popped == ButtonEventQueue::CAPACITY && queue.getDropped() == 5 && first,
+                "Volle Warteschlange verwirft neue Ereignisse und zählt sie");
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned loopMillis = argc >= 2 ? static_cast<unsigned>(std::atoi(argv[1])) : 2;
+    unsigned bounceMillis = argc >= 3 ? static_cast<unsigned>(std::atoi(argv[2])) : 8;
+    if (loopMillis == 0 || bounceMillis >= 20) {
+        std::fprintf(stderr, "loop_ms muss mindestens 1 sein, prellen_ms kleiner als die Entprellzeit (20 ms)\n");
+        return 2;
+    }
+    Counts truth;
+    unsigned glitches = 0;
+    std::vector<bool> level = synthesize(bounceMillis, truth, glitches);
+
+    // Neu: Takt läuft nur nach einer Flanke, bis der Tracker ihn nicht mehr braucht
+    ButtonGestureTracker tracker;
+    ButtonEventQueue queue;
+    ButtonTiming timing;
+    timing.longPressTime = LONG_PRESS;
+    tracker.setTiming(0, timing);
+    Counts tracked;
+    unsigned ticks = 0;
+    unsigned edges = 0;
+    bool timerRunning = false;
+    for (std::uint32_t now = 0; now < level.size(); now++) {
+        if (now > 0 && level[now] != level[now - 1]) {
+            edges++;
+            timerRunning = true;
+        }
+        if (!timerRunning) continue;
+        ticks++;
+        timerRunning = tracker.update(0, level[now], now, queue);
+        ButtonEvent event;
+        while (queue.pop(event)) {
+            if (event.gesture == BUTTON_SHORT) tracked.shortPresses++;
+            if (event.gesture == BUTTON_LONG) tracked.longPresses++;
+        }
+    }
+
+    // Bisher: ein Wert pro loop()
+    HoldKey key;
+    Counts legacy;
+    for (std::uint32_t now = 0; now < level.size(); now += loopMillis) {
+        key.poll(level[now], now, legacy);
+    }
+
+    std::printf("%.0f s Pegelverlauf, %u Flanken, bis %u ms Prellen, %u Störimpulse, bisher ein Wert alle %u ms\n\n",
+                level.size() / 1000.0, edges, bounceMillis, glitches, loopMillis);
+    std::printf("                      kurz   lang\n");
+    std::printf("tatsächlich        %7u %6u\n", truth.shortPresses, truth.longPresses);
+    std::printf("bisher (loop)      %7u %6u\n", legacy.shortPresses, legacy.longPresses);
+    std::printf("Interrupt + Takt   %7u %6u\n", tracked.shortPresses, tracked.longPresses);
+    std::printf("\nAbfragen: bisher %u (jede loop()), neu %u Takte (nur nach Flanken, %.1f %% der Zeit)\n\n",
+                static_cast<unsigned>(level.size() / loopMillis), ticks, 100.0 * ticks / level.size());
+
+    bool ok = check(tracked.shortPresses == truth.shortPresses && tracked.longPresses == truth.longPresses,
+                    "Alle kurzen und langen Drücke genau einmal erkannt");
+    ok &= testRepeat();
+    ok &= testQueue();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,234 @@
+// Host-Test der DHT11-Dekodierung (decodeDhtFrame() aus src/dht_async.hpp) mit abgespielten Flankenzeitpunkten
+//
+// Übersetzen:  g++ -std=c++11 -O2 -Wall -o dht_replay tools/dht_replay.cpp
+// Verwendung:  dht_replay [mitschnitt.txt]
+//
+// Ein Mitschnitt enthält einen Frame pro Zeile: zuerst das erwartete Ergebnis ("ok:<feuchte>:<temperatur>" oder
+// "fehler"), dann die Flanken als "<µs>,<pegel nach der Flanke>". Solche Zeilen gibt der Treiber auf dem Gerät aus,
+// wenn er mit -DDHT_TRACE übersetzt wird; Zeilen mit "#" am Anfang werden übersprungen. Ohne Datei werden Frames mit
+// den Zeiten aus dem Datenblatt und ±4 µs Zittern der Interrupt-Latenz erzeugt (fester Startwert, reproduzierbar):
+// gültige Frames, negative Temperatur, verpasste erste Flanke, falsche Prüfsumme, fehlende und zusätzliche Flanke,
+// Abbruch durch Zeitüberschreitung und kein Sensor, dazu zufällige Werte.
+// Exit-Code 0 = jeder Frame wie erwartet dekodiert, 1 = Abweichung, 2 = Aufruf- oder Dateifehler
+
+#include "../src/dht_async.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+struct Trace {
+    std::string name;
+    bool expectValid = false;
+    float humidity = 0;
+    float temperature = 0;
+    std::vector<std::uint32_t> times;
+    std::vector<std::uint8_t> levels;
+};
+
+// Zeiten in µs nach Datenblatt
+static const std::uint32_t RESPONSE_DELAY = 30; // Freigabe der Leitung bis zur Antwort des Sensors
+static const std::uint32_t RESPONSE_LOW = 80;
+static const std::uint32_t RESPONSE_HIGH = 80;
+static const std::uint32_t BIT_LOW = 50;
+static const std::uint32_t ZERO_HIGH = 27;
+static const std::uint32_t ONE_HIGH = 70;
+
+static std::mt19937 generator(20261017);
+
+static void edge(Trace &trace, std::uint32_t &time, std::uint32_t after, std::uint8_t level)
+{
+    std::uniform_int_distribution<int> jitter(-4, 4);
+    time += after;
+    trace.times.push_back(time + jitter(generator));
+    trace.levels.push_back(level);
+}
+
+// Vollständiger Frame, wie ihn die Interrupt-Routine aufzeichnet: Antwort, 40 Bits, abschließende Freigabe
+static Trace synthesize(const char *name, const std::uint8_t data[5])
+{
+    Trace trace;
+    trace.name = name;
+    std::uint32_t time = 0;
+    edge(trace, time, RESPONSE_DELAY, 0);
+    edge(trace, time, RESPONSE_LOW, 1);
+    edge(trace, time, RESPONSE_HIGH, 0);
+    for (int i = 0; i < 40; i++) {
+        bool one = (data[i / 8] >> (7 - i % 8)) & 1;
+        edge(trace, time, BIT_LOW, 1);
+        edge(trace, time, one ? ONE_HIGH : ZERO_HIGH, 0);
+    }
+    edge(trace, time, BIT_LOW, 1);
+    return trace;
+}
+
+static Trace expectOk(Trace trace, float humidity, float temperature)
+{
+    trace.expectValid = true;
+    trace.humidity = humidity;
+    trace.temperature = temperature;
+    return trace;
+}
+
+static void frameBytes(std::uint8_t data[5], std::uint8_t h, std::uint8_t hTenths, std::uint8_t t, std::uint8_t tTenths)
+{
+    data[0] = h;
+    data[1] = hTenths;
+    data[2] = t;
+    data[3] = tTenths;
+    data[4] = static_cast<std::uint8_t>(h + hTenths + t + tTenths);
+}
+
+static std::vector<Trace> builtinTraces()
+{
+    std::vector<Trace> traces;
+    std::uint8_t data[5];
+
+    frameBytes(data, 45, 0, 23, 4);
+    Trace valid = expectOk(synthesize("gültiger Frame 45 % / 23,4 °C", data), 45.0f, 23.4f);
+    traces.push_back(valid);
+
+    // Bit 7 des Zehntelbytes: -1 - 5 + 0,3 (Kodierung wie in der Adafruit-Bibliothek)
+    frameBytes(data, 80, 0, 5, 0x83);
+    traces.push_back(expectOk(synthesize("negative Temperatur", data), 80.0f, -5.7f));
+
+    Trace missedFirst = valid;
+    missedFirst.name = "erste Flanke verpasst";
+    missedFirst.times.erase(missedFirst.times.begin());
+    missedFirst.levels.erase(missedFirst.levels.begin());
+    traces.push_back(missedFirst);
+
+    frameBytes(data, 45, 0, 23, 4);
+    data[4] ^= 0x01;
+    traces.push_back(synthesize("falsche Prüfsumme", data));
+
+    // Fallende Flanke von Bit 20 fehlt: zwei High-Pulse verschmelzen, ein Bit geht verloren
+    Trace missing = valid;
+    missing.name = "fehlende Flanke";
+    std::size_t bit20Fall = 3 + 2 * 20 + 1;
+    missing.times.erase(missing.times.begin() + bit20Fall);
+    missing.levels.erase(missing.levels.begin() + bit20Fall);
+    missing.expectValid = false;
+    traces.push_back(missing);
+
+    // Störimpuls von 3 µs im Low-Teil von Bit 30 ergibt ein zusätzliches 0-Bit
+    Trace extra = valid;
+    extra.name = "zusätzliche Flanke (Störimpuls)";
+    std::size_t bit30Rise = 3 + 2 * 30;
+    std::uint32_t glitch = extra.times[bit30Rise] - 25;
+    extra.times.insert(extra.times.begin() + bit30Rise, {glitch, glitch + 3});
+    extra.levels.insert(extra.levels.begin() + bit30Rise, {1, 0});
+    extra.expectValid = false;
+    traces.push_back(extra);
+
+    // Zeitüberschreitung: die Aufzeichnung endet nach 25 Bits
+    Trace timeout = valid;
+    timeout.name = "Zeitüberschreitung nach 25 Bits";
+    timeout.times.resize(3 + 2 * 25);
+    timeout.levels.resize(3 + 2 * 25);
+    timeout.expectValid = false;
+    traces.push_back(timeout);
+
+    Trace none;
+    none.name = "kein Sensor (keine Flanke)";
+    traces.push_back(none);
+
+    std::uniform_int_distribution<int> humidity(20, 95);
+    std::uniform_int_distribution<int> temperature(0, 50);
+    std::uniform_int_distribution<int> tenths(0, 9);
+    for (int i = 0; i < 500; i++) {
+        std::uint8_t h = static_cast<std::uint8_t>(humidity(generator));
+        std::uint8_t t = static_cast<std::uint8_t>(temperature(generator));
+        std::uint8_t tt = static_cast<std::uint8_t>(tenths(generator));
+        frameBytes(data, h, 0, t, tt);
+        traces.push_back(expectOk(synthesize("zufällige Werte", data), h, t + tt * 0.1f));
+    }
+    return traces;
+}
+
+static bool loadTraces(const char *path, std::vector<Trace> &traces)
+{
+    std::FILE *in = std::fopen(path, "r");
+    if (in == nullptr) {
+        std::fprintf(stderr, "%s kann nicht gelesen werden\n", path);
+        return false;
+    }
+    char line[4096];
+    unsigned number = 0;
+    bool ok = true;
+    while (ok && std::fgets(line, sizeof(line), in) != nullptr) {
+        number++;
+        char *token = std::strtok(line, " \t\r\n");
+        if (token == nullptr || token[0] == '#') continue;
+        Trace trace;
+        trace.name = std::string(path) + ":" + std::to_string(number);
+        if (std::strncmp(token, "ok:", 3) == 0) {
+            trace.expectValid = std::sscanf(token, "ok:%f:%f", &trace.humidity, &trace.temperature) == 2;
+            ok = trace.expectValid;
+        } else {
+            ok = std::strcmp(token, "fehler") == 0;
+        }
+        while (ok && (token = std::strtok(nullptr, " \t\r\n")) != nullptr) {
+            unsigned long time;
+            unsigned level;
+            ok = std::sscanf(token, "%lu,%u", &time, &level) == 2 && level <= 1;
+            trace.times.push_back(static_cast<std::uint32_t>(time));
+            trace.levels.push_back(static_cast<std::uint8_t>(level));
+        }
+        if (!ok) {
+            std::fprintf(stderr, "%s:%u: erwartet \"ok:<feuchte>:<temperatur>\" oder \"fehler\", dann \"<µs>,<pegel>\"\n", path, number);
+        }
+        traces.push_back(trace);
+    }
+    std::fclose(in);
+    return ok;
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<Trace> traces;
+    if (argc >= 2) {
+        if (!loadTraces(argv[1], traces)) return 2;
+    } else {
+        traces = builtinTraces();
+    }
+    if (traces.empty()) {
+        std::fprintf(stderr, "Keine Frames\n");
+        return 2;
+    }
+
+    unsigned failures = 0;
+    unsigned randomOk = 0;
+    unsigned randomCount = 0;
+    for (const Trace &trace : traces) {
+        DhtResult result;
+        bool valid = decodeDhtFrame(trace.times.data(), trace.levels.data(), trace.times.size(), result);
+        bool ok = valid == trace.expectValid && valid == result.valid;
+        if (ok && valid) {
+            ok = std::fabs(result.humidity - trace.humidity) < 0.05f && std::fabs(result.temperature - trace.temperature) < 0.05f;
+        }
+        if (!ok) failures++;
+        if (trace.name == "zufällige Werte") {
+            randomCount++;
+            if (ok) randomOk++;
+            if (ok) continue; // Nur Abweichungen einzeln ausgeben
+        }
+        char decoded[48];
+        if (valid) {
+            std::snprintf(decoded, sizeof(decoded), "%.1f %% / %.1f °C", result.humidity, result.temperature);
+        } else {
+            std::snprintf(decoded, sizeof(decoded), "ungültig");
+        }
+        std::printf("  %-40s %3u Flanken  %-22s %s\n", trace.name.c_str(), static_cast<unsigned>(trace.times.size()),
+                    decoded, ok ? "ok" : "FEHLER");
+    }
+    if (randomCount > 0) {
+        std::printf("  %-40s %u/%u richtig dekodiert\n", "zufällige Werte", randomOk, randomCount);
+    }
+    std::printf("\n%u Frames, %u Abweichungen\n", static_cast<unsigned>(traces.size()), failures);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,317 @@
+// Host-Benchmark der Geräuscherkennung (src/mic_activity.hpp) gegen den bisherigen Einzelwert "analogRead(WIO_MIC) > 650"
+//
+// Übersetzen:  g++ -std=c++11 -O2 -Wall -o mic_bench tools/mic_bench.cpp
+// Verwendung:  mic_bench [+geraeusch.wav|-ruhe.wav ...] [-p loop_ms]
+//
+// Jede WAV-Datei (16 Bit PCM, mono oder Stereo, beliebige Abtastrate) ist ein Clip: "+" vorangestellt, wenn er ein
+// Geräusch enthält, das das Display wecken soll, "-", wenn nicht. Die erste Sekunde eines Clips dient als Vorlauf
+// (Grundrauschen lernen) und wird nicht bewertet. Ohne Dateien werden beschriftete Clips erzeugt: Stille, Sprache laut
+// und leise, Klatschen, Sprache bei Lüfter sowie Lüfter und Staubsauger ohne Sprache (fester Startwert, reproduzierbar).
+//
+// Nachgebildet wird das Gerät: 8 kHz, 12 Bit, Fenster zu 128 Werten. Die bisherige Logik liest einmal pro loop()
+// (Standard alle 2 ms) einen 10-Bit-Wert und meldet ein Geräusch, wenn er über 650 liegt.
+// Exit-Code 0 = neue Erkennung trifft mindestens so oft und meldet nicht öfter fälschlich, 1 = sonst, 2 = Aufruf- oder Dateifehler
+
+#include "../src/mic_activity.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+static const std::uint32_t RATE = 8000;                                      // Hz, wie MicSampler::SAMPLE_RATE
+static const std::size_t WINDOW = 128;                                        // wie MicSampler::WINDOW_SAMPLES
+static const int LEGACY_THRESHOLD = 650;                                      // 10 Bit, wie bisher in loop()
+static const double PI = 3.14159265358979323846;
+
+struct Clip {
+    std::string name;
+    bool expected;                      // Soll das Display wecken
+    std::size_t warmup;                 // Werte am Anfang, die nicht bewertet werden
+    std::vector<std::uint16_t> samples; // 12 Bit
+};
+
+static std::uint16_t toAdc(double value)
+{
+    value = value < 0 ? 0 : (value > 4095 ? 4095 : value);
+    return static_cast<std::uint16_t>(std::lround(value));
+}
+
+static std::uint32_t readLe(const unsigned char *p, int bytes)
+{
+    std::uint32_t value = 0;
+    for (int i = bytes - 1; i >= 0; i--) value = (value << 8) | p[i];
+    return value;
+}
+
+static bool loadWav(const char *path, Clip &clip)
+{
+    std::FILE *in = std::fopen(path, "rb");
+    if (in == nullptr) {
+        std::fprintf(stderr, "%s: Datei kann nicht geöffnet werden\n", path);
+        return false;
+    }
+    std::vector<unsigned char> data;
+    unsigned char buffer[4096];
+    std::size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), in)) > 0) data.insert(data.end(), buffer, buffer + n);
+    std::fclose(in);
+    if (data.size() < 12 || std::memcmp(&data[0], "RIFF", 4) != 0 || std::memcmp(&data[8], "WAVE", 4) != 0) {
+        std::fprintf(stderr, "%s: keine WAV-Datei\n", path);
+        return false;
+    }
+    std::uint32_t rate = 0;
+    std::uint32_t channels = 0;
+    const unsigned char *pcm = nullptr;
+    std::size_t pcmBytes = 0;
+    for (std::size_t pos = 12; pos + 8 <= data.size();) {
+        std::uint32_t size = readLe(&data[pos + 4], 4);
+        if (pos + 8 + size > data.size()) size = static_cast<std::uint32_t>(data.size() - pos - 8);
+        if (std::memcmp(&data[pos], "fmt ", 4) == 0 && size >= 16) {
+            std::uint32_t format = readLe(&data[pos + 8], 2);
+            channels = readLe(&data[pos + 10], 2);
+            rate = readLe(&data[pos + 12], 4);
+            if (format != 1 || readLe(&data[pos + 22], 2) != 16) {
+                std::fprintf(stderr, "%s: nur 16 Bit PCM wird unterstützt\n", path);
+                return false;
+            }
+        } else if (std::memcmp(&data[pos], "data", 4) == 0) {
+            pcm = &data[pos + 8];
+            pcmBytes = size;
+        }
+        pos += 8 + size + (size & 1);
+    }
+    if (pcm == nullptr || rate == 0 || channels == 0) {
+        std::fprintf(stderr, "%s: fmt- oder data-Block fehlt\n", path);
+        return false;
+    }
+    // Auf 8 kHz bringen: Mittelwert über die Quellwerte jeder Zielperiode (erster Kanal)
+    std::size_t frames = pcmBytes / (2 * channels);
+    double step = static_cast<double>(rate) / RATE;
+    for (double t = 0; t + step <= frames; t += step) {
+        std::size_t from = static_cast<std::size_t>(t);
+        std::size_t to = static_cast<std::size_t>(t + step);
+        if (to <= from) to = from + 1;
+        double sum = 0;
+        for (std::size_t i = from; i < to; i++) {
+            sum += static_cast<std::int16_t>(readLe(pcm + i * 2 * channels, 2));
+        }
+        // Volle Aussteuerung der Aufnahme entspricht dem halben ADC-Bereich um die Mittenspannung
+        clip.samples.push_back(toAdc(2048 + sum / (to - from) / 16.0));
+    }
+    clip.warmup = RATE;
+    return true;
+}
+
+// Erzeugte Clips: 3 s Vorlauf mit dem Hintergrund des Clips, dann 4 s Bewertung
+class Generator
+{
+    std::mt19937 random;
+    std::normal_distribution<double> gauss{0.0, 1.0};
+    std::uniform_real_distribution<double> uniform{0.0, 1.0};
+
+public:
+    static const std::size_t WARMUP = 3 * RATE;
+    static const std::size_t LENGTH = 4 * RATE;
+
+    explicit Generator(std::uint32_t seed) : random(seed) {}
+
+    // Mittenspannung des Mikrofonverstärkers, Rauschen, optional Lüfter (Brummen mit Oberwellen) und Staubsauger (breitbandig)
+    double background(std::size_t i, double fan, double vacuum)
+    {
+        double t = static_cast<double>(i) / RATE;
+        double value = 2048 + 8 * gauss(random);
+        if (fan > 0) value += fan * (std::sin(2 * PI * 100 * t) + 0.5 * std::sin(2 * PI * 200 * t + 1) + 0.3 * gauss(random));
+        if (vacuum > 0) value += vacuum * gauss(random);
+        return value;
+    }
+
+    // Silben mit 4 Hz, Grundton 120-220 Hz mit Oberwellen bis 1 kHz
+    void speech(std::vector<double> &signal, std::size_t from, double amplitude)
+    {
+        double pitch = 120 + 100 * uniform(random);
+        double length = 0.8 + 1.2 * uniform(random);
+        std::size_t count = static_cast<std::size_t>(length * RATE);
+        for (std::size_t i = 0; i < count && from + i < signal.size(); i++) {
+            double t = static_cast<double>(i) / RATE;
+            double syllable = std::sin(PI * std::fmod(t * 4, 1.0));
+            double voice = 0;
+            for (int h = 1; h * pitch < 1000; h++) voice += std::sin(2 * PI * h * pitch * t) / h;
+            signal[from + i] += amplitude * syllable * syllable * voice * 0.6;
+        }
+    }
+
+    // Kurzer, abklingender Knall (Klatschen, Tür)
+    void clap(std::vector<double> &signal, std::size_t from, double amplitude)
+    {
+        for (std::size_t i = 0; i < RATE / 20 && from + i < signal.size(); i++) {
+            signal[from + i] += amplitude * std::exp(-static_cast<double>(i) / (0.008 * RATE)) * gauss(random);
+        }
+    }
+
+    Clip make(const char *name, bool expected, double fan, double vacuum, int kind, double amplitude)
+    {
+        std::vector<double> signal(WARMUP + LENGTH);
+        for (std::size_t i = 0; i < signal.size(); i++) signal[i] = background(i, fan, vacuum);
+        std::size_t at = WARMUP + static_cast<std::size_t>((0.3 + 1.5 * uniform(random)) * RATE);
+        if (kind == 1) speech(signal, at, amplitude);
+        if (kind == 2) clap(signal, at, amplitude);
+        Clip clip;
+        clip.name = name;
+        clip.expected = expected;
+        clip.warmup = WARMUP;
+        for (double value : signal) clip.samples.push_back(toAdc(value));
+        return clip;
+    }
+};
+
+static void synthesize(std::vector<Clip> &clips)
+{
+    Generator generator(20261017);
+    for (int r = 0; r < 20; r++) {
+        clips.push_back(generator.make("Stille", false, 0, 0, 0, 0));
+        clips.push_back(generator.make("Sprache laut", true, 0, 0, 1, 500));
+        clips.push_back(generator.make("Sprache leise", true, 0, 0, 1, 90));
+        clips.push_back(generator.make("Klatschen", true, 0, 0, 2, 1200));
+        clips.push_back(generator.make("Sprache bei Lüfter", true, 60, 0, 1, 300));
+        clips.push_back(generator.make("Lüfter", false, 60, 0, 0, 0));
+        clips.push_back(generator.make("Staubsauger", false, 0, 350, 0, 0));
+    }
+}
+
+struct Score {
+    unsigned hits = 0;        // Clips mit Geräusch, in denen mindestens ein Ereignis gemeldet wurde
+    unsigned positives = 0;
+    unsigned falseEvents = 0; // Ereignisse in Clips ohne Geräusch
+    unsigned negatives = 0;
+};
+
+struct Row {
+    std::string name;
+    bool expected = false;
+    unsigned clips = 0;
+    unsigned legacy = 0; // Clips mit mindestens einem Ereignis
+    unsigned envelope = 0;
+    unsigned legacyEvents = 0;
+    unsigned envelopeEvents = 0;
+};
+
+static void count(Score &score, bool expected, unsigned events)
+{
+    if (expected) {
+        score.positives++;
+        if (events > 0) score.hits++;
+    } else {
+        score.negatives++;
+        score.falseEvents += events;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    double loopMillis = 2.0;
+    std::vector<Clip> clips;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            loopMillis = std::atof(argv[++i]);
+            continue;
+        }
+        if (argv[i][0] != '+' && argv[i][0] != '-') {
+            std::fprintf(stderr, "%s: \"+\" (Geräusch) oder \"-\" (Ruhe) voranstellen\n", argv[i]);
+            return 2;
+        }
+        Clip clip;
+        clip.name = argv[i] + 1;
+        clip.expected = argv[i][0] == '+';
+        if (!loadWav(argv[i] + 1, clip)) return 2;
+        if (clip.samples.size() < clip.warmup + WINDOW) {
+            std::fprintf(stderr, "%s: kürzer als Vorlauf und ein Fenster\n", argv[i] + 1);
+            return 2;
+        }
+        clips.push_back(clip);
+    }
+    if (loopMillis <= 0) {
+        std::fprintf(stderr, "loop-Periode muss größer als 0 sein\n");
+        return 2;
+    }
+    if (clips.empty()) synthesize(clips);
+
+    Score legacy, envelope;
+    std::vector<Row> rows;
+    std::size_t legacyStride = static_cast<std::size_t>(loopMillis * RATE / 1000.0);
+    if (legacyStride == 0) legacyStride = 1;
+    double seconds = 0;
+    for (const Clip &clip : clips) {
+        // Bisher: Einzelwert je loop(), 12 Bit auf 10 Bit wie analogRead(); jeder Durchlauf über der Schwelle weckt
+        unsigned oldEvents = 0;
+        bool wasLoud = false;
+        for (std::size_t i = clip.warmup; i < clip.samples.size(); i += legacyStride) {
+            bool loud = (clip.samples[i] >> 2) > LEGACY_THRESHOLD;
+            if (loud && !wasLoud) oldEvents++;
+            wasLoud = loud;
+        }
+        // Neu: jeder Clip beginnt mit frischem Zustand wie nach dem Einschalten, der Vorlauf lernt das Grundrauschen
+        MicEnvelope detector;
+        unsigned newEvents = 0;
+        for (std::size_t i = 0; i + WINDOW <= clip.samples.size(); i += WINDOW) {
+            bool started = detector.addWindow(&clip.samples[i], WINDOW);
+            if (started && i >= clip.warmup) newEvents++;
+        }
+        seconds += static_cast<double>(clip.samples.size() - clip.warmup) / RATE;
+        count(legacy, clip.expected, oldEvents);
+        count(envelope, clip.expected, newEvents);
+
+        Row *row = nullptr;
+        for (Row &r : rows) {
+            if (r.name == clip.name) row = &r;
+        }
+        if (row == nullptr) {
+            rows.push_back(Row());
+            row = &rows.back();
+            row->name = clip.name;
+            row->expected = clip.expected;
+        }
+        row->clips++;
+        row->legacy += oldEvents > 0;
+        row->envelope += newEvents > 0;
+        row->legacyEvents += oldEvents;
+        row->envelopeEvents += newEvents;
+    }
+
+    // CPU-Zeit der Hüllkurve, über viele Wiederholungen gemittelt
+    const unsigned repetitions = 20;
+    std::uint32_t sink = 0;
+    std::size_t processed = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < repetitions; r++) {
+        for (const Clip &clip : clips) {
+            MicEnvelope detector;
+            for (std::size_t i = 0; i + WINDOW <= clip.samples.size(); i += WINDOW) {
+                sink += detector.addWindow(&clip.samples[i], WINDOW);
+                processed += WINDOW;
+            }
+            sink += detector.getRms();
+        }
+    }
+    double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("%u Clips, %.0f s bewertet, bisher ein Wert alle %.1f ms, neu %u Hz in Fenstern zu %u Werten\n\n",
+                static_cast<unsigned>(clips.size()), seconds, loopMillis, static_cast<unsigned>(RATE), static_cast<unsigned>(WINDOW));
+    std::printf("Clip                   erwartet  Anzahl  bisher erkannt (Ereignisse)  neu erkannt (Ereignisse)\n");
+    for (const Row &row : rows) {
+        std::printf("%-22s %8s %7u %15u (%10u) %12u (%10u)\n", row.name.c_str(), row.expected ? "ja" : "nein", row.clips,
+                    row.legacy, row.legacyEvents, row.envelope, row.envelopeEvents);
+    }
+    std::printf("\n                       Trefferquote  Fehlalarme\n");
+    std::printf("bisher (> %d)          %10.0f %% %11u\n", LEGACY_THRESHOLD,
+                legacy.positives > 0 ? 100.0 * legacy.hits / legacy.positives : 0.0, legacy.falseEvents);
+    std::printf("Hüllkurve              %10.0f %% %11u\n",
+                envelope.positives > 0 ? 100.0 * envelope.hits / envelope.positives : 0.0, envelope.falseEvents);
+    std::printf("\nCPU-Zeit Host: %.1f ns pro Wert, %.0f ns pro Fenster (Prüfsumme %u)\n", nanos / processed,
+                nanos / processed * WINDOW, static_cast<unsigned>(sink & 0xff));
+    return envelope.hits >= legacy.hits && envelope.falseEvents <= legacy.falseEvents ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+// Host-Benchmark der Bodenfeuchte-Filterung (src/moisture_sampler.hpp) gegen die bisherige Einzelmessung
+//
+// Übersetzen:  g++ -std=c++11 -O2 -Wall -o moisture_bench tools/moisture_bench.cpp
+// Verwendung:  moisture_bench [aufnahme.txt] [schwelle]
+//
+// Die Aufnahme enthält einzelne 10-Bit-Wandlungen des Sensors, ein Wert pro Zeile, so schnell wie möglich
+// hintereinander aufgenommen (z.B. analogRead() in einer Schleife über Serial ausgegeben); Zeilen mit Komma
+// werden als CSV von aqualog gelesen (vierte Spalte). Ohne Datei wird eine Aufnahme aus langsamer Drift,
+// Gaußschem Rauschen und seltenen Ausreißern erzeugt (fester Startwert, reproduzierbar).
+//
+// Nachgebildet wird die Kette auf dem Gerät: 16 Wandlungen mittelt der ADC (AVGCTRL), 15 solcher Werte bilden
+// einen Burst, daraus Median und gleitendes Mittel. Verglichen werden die Streuung (Varianz der ersten
+// Differenzen / 2, unempfindlich gegen langsame Drift) und die Wechsel über die Schwelle (Standard 200,
+// untere Schwelle von Modus 1) gegen die bisherige Einzelmessung je Periode.
+
+#include "../src/moisture_sampler.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static const std::size_t HARDWARE_AVERAGE = 16;
+static const std::size_t BURST = 15;
+static const std::size_t PER_PERIOD = HARDWARE_AVERAGE * BURST; // Wandlungen pro Messperiode
+
+static bool loadRecording(const char *path, std::vector<std::uint16_t> &samples)
+{
+    std::FILE *in = std::fopen(path, "r");
+    if (in == nullptr) {
+        std::fprintf(stderr, "%s: Datei kann nicht geöffnet werden\n", path);
+        return false;
+    }
+    char line[256];
+    while (std::fgets(line, sizeof(line), in) != nullptr) {
+        const char *field = line;
+        if (std::strchr(line, ',') != nullptr) {
+            for (int column = 0; column < 3 && field != nullptr; column++) {
+                field = std::strchr(field, ',');
+                if (field != nullptr) field++;
+            }
+        }
+        char *end = nullptr;
+        long value = field != nullptr ? std::strtol(field, &end, 10) : 0;
+        if (field != nullptr && end != field && value >= 0 && value <= 1023) {
+            samples.push_back(static_cast<std::uint16_t>(value));
+        }
+    }
+    std::fclose(in);
+    return true;
+}
+
+// 2000 Perioden: Boden trocknet langsam von 260 auf 150 ab, Rauschen sigma 6, 0,2 % Ausreißer
+static void synthesize(std::vector<std::uint16_t> &samples)
+{
+    std::mt19937 random(20261017);
+    std::normal_distribution<double> noise(0.0, 6.0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    const std::size_t periods = 2000;
+    for (std::size_t i = 0; i < periods * PER_PERIOD; i++) {
+        double level = 260.0 - 110.0 * static_cast<double>(i) / (periods * PER_PERIOD);
+        double value = level + noise(random);
+        if (uniform(random) < 0.002) {
+            value = uniform(random) < 0.5 ? 0.0 : 1023.0;
+        }
+        value = value < 0 ? 0 : (value > 1023 ? 1023 : value);
+        samples.push_back(static_cast<std::uint16_t>(std::lround(value)));
+    }
+}
+
+// Streuung ohne Einfluss der Drift: Varianz der ersten Differenzen / 2
+static double noiseVariance(const std::vector<double> &values)
+{
+    if (values.size() < 3) return 0;
+    double sum = 0;
+    double squares = 0;
+    for (std::size_t i = 1; i < values.size(); i++) {
+        double d = values[i] - values[i - 1];
+        sum += d;
+        squares += d * d;
+    }
+    double n = static_cast<double>(values.size() - 1);
+    return (squares / n - (sum / n) * (sum / n)) / 2;
+}
+
+// Wechsel zwischen "<= Schwelle" und "> Schwelle", so oft würde das Relais schalten
+static unsigned crossings(const std::vector<double> &values, double threshold)
+{
+    unsigned count = 0;
+    for (std::size_t i = 1; i < values.size(); i++) {
+        if ((values[i] <= threshold) != (values[i - 1] <= threshold)) count++;
+    }
+    return count;
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<std::uint16_t> samples;
+    if (argc >= 2) {
+        if (!loadRecording(argv[1], samples)) return 2;
+    } else {
+        synthesize(samples);
+    }
+    double threshold = argc >= 3 ? std::atof(argv[2]) : 200.0;
+    std::size_t periods = samples.size() / PER_PERIOD;
+    if (periods < 3) {
+        std::fprintf(stderr, "Zu wenige Werte: %u, mindestens %u\n", static_cast<unsigned>(samples.size()), static_cast<unsigned>(3 * PER_PERIOD));
+        return 2;
+    }
+
+    // Bursts wie vom ADC geliefert: je 16 Wandlungen gemittelt, abgeschnitten auf ganze Schritte
+    std::vector<std::uint16_t> bursts(periods * BURST);
+    for (std::size_t i = 0; i < bursts.size(); i++) {
+        std::uint32_t sum = 0;
+        for (std::size_t k = 0; k < HARDWARE_AVERAGE; k++) sum += samples[i * HARDWARE_AVERAGE + k];
+        bursts[i] = static_cast<std::uint16_t>(sum / HARDWARE_AVERAGE);
+    }
+
+    std::vector<double> single, averaged, medians, filtered;
+    std::vector<std::uint16_t> noise;
+    MoistureFilter filter;
+    std::uint16_t burst[BURST];
+    for (std::size_t p = 0; p < periods; p++) {
+        single.push_back(samples[p * PER_PERIOD]);
+        averaged.push_back(bursts[p * BURST]);
+        std::memcpy(burst, &bursts[p * BURST], sizeof(burst));
+        filter.addBurst(burst, BURST);
+        medians.push_back(filter.getLastMedian());
+        filtered.push_back(filter.getValue());
+        noise.push_back(filter.getNoiseTenths());
+    }
+
+    // CPU-Zeit für Median und Filter, über viele Wiederholungen gemittelt
+    const unsigned repetitions = 200;
+    MoistureFilter timing;
+    std::uint32_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned r = 0; r < repetitions; r++) {
+        for (std::size_t p = 0; p < periods; p++) {
+            std::memcpy(burst, &bursts[p * BURST], sizeof(burst));
+            timing.addBurst(burst, BURST);
+            sink += timing.getValue();
+        }
+    }
+    double nanos = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    double perBurst = nanos / (static_cast<double>(repetitions) * periods);
+
+    double baseVariance = noiseVariance(single);
+    std::printf("%u Wandlungen, %u Perioden zu %u Wandlungen, Schwelle %.0f\n\n", static_cast<unsigned>(samples.size()),
+                static_cast<unsigned>(periods), static_cast<unsigned>(PER_PERIOD), threshold);
+    std::printf("Stufe                         Varianz  Faktor  Schwellenwechsel\n");
+    struct Stage { const char *name; const std::vector<double> *values; } stages[] = {
+        {"Einzelmessung (bisher)", &single},
+        {"Hardware-Mittel 16x", &averaged},
+        {"Median aus 15", &medians},
+        {"Median + gleitendes Mittel", &filtered}};
+    for (const Stage &stage : stages) {
+        double variance = noiseVariance(*stage.values);
+        std::printf("%-28s %8.2f %7.1f %17u\n", stage.name, variance, variance > 0 ? baseVariance / variance : 0.0,
+                    crossings(*stage.values, threshold));
+    }
+    std::printf("\nRauschschätzung des Filters (Ende): %u.%u ADC-Schritte je Hardware-Mittelwert\n",
+                static_cast<unsigned>(noise.back() / 10), static_cast<unsigned>(noise.back() % 10));
+    std::printf("CPU-Zeit Host: %.0f ns pro Burst, %.1f ns pro Wert (Prüfsumme %u)\n", perBurst, perBurst / BURST, static_cast<unsigned>(sink & 0xff));
+    return 0;
+}
@@ -0,0 +1,150 @@
+// Host-Prüfung des Laufzeit-Histogramms (src/profiler.hpp): Fachgrenzen, p99 gegen den exakten Wert, Host-Uhr
+//
+// Übersetzen:  g++ -std=c++11 -O2 -Wall -o profiler_check tools/profiler_check.cpp
+// Verwendung:  profiler_check
+//
+// Die Fächer werden über getPercentile() von 0 µs aufwärts abgeschritten: jedes Fach muss lückenlos an das
+// vorige anschließen und darf höchstens 50 % breiter als seine Untergrenze sein; ab dem Überlauffach wird das
+// Maximum gemeldet. Für erzeugte Laufzeitverteilungen (fester Startwert, reproduzierbar) muss p99 zwischen dem
+// exakten Wert und 150 % davon liegen. Zuletzt misst ProfileScope eine Wartezeit von 20 ms mit der Host-Uhr.
+// Exit-Code 0 = alle Prüfungen bestanden, 1 = Abweichung
+
+#include "../src/profiler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+static unsigned failures = 0;
+
+static void check(bool ok, const char *what, unsigned long long value, unsigned long long expected)
+{
+    if (!ok) {
+        std::printf("  FEHLER %s: %llu (erwartet %llu)\n", what, value, expected);
+        failures++;
+    }
+}
+
+// Obergrenze des Fachs von value: 99 Werte im Fach und ein sehr langer, damit p99 nicht auf das Maximum fällt
+static std::uint32_t bucketUpperOf(std::uint32_t value)
+{
+    Profiler profiler;
+    int section = profiler.addSection("fach");
+    for (int i = 0; i < 99; i++) {
+        profiler.record(section, value);
+    }
+    profiler.record(section, UINT32_MAX);
+    return profiler.getPercentile(0, 990);
+}
+
+static void checkBuckets()
+{
+    std::uint32_t lower = 0;
+    unsigned buckets = 0;
+    while (true) {
+        std::uint32_t upper = bucketUpperOf(lower);
+        if (upper == UINT32_MAX) {
+            break; // Überlauffach
+        }
+        buckets++;
+        check(upper >= lower, "Obergrenze unter der Untergrenze", upper, lower);
+        if (upper < lower) {
+            break; // Längere Laufzeiten würden zu kurz gemeldet
+        }
+        check(bucketUpperOf(upper) == upper, "Obergrenze in einem anderen Fach", bucketUpperOf(upper), upper);
+        check(upper <= lower + lower / 2, "Fach breiter als 50 %", upper, lower + lower / 2);
+        lower = upper + 1;
+    }
+    std::printf("  %u Fächer bis %lu µs, darüber das Überlauffach\n", buckets, (unsigned long)lower - 1);
+    check(buckets + 1 <= ProfileSection::BUCKETS, "mehr Fächer als Platz", buckets + 1, ProfileSection::BUCKETS);
+
+    // Im Überlauffach meldet p99 das Maximum statt einer zu kleinen Fachgrenze
+    Profiler profiler;
+    int section = profiler.addSection("lang");
+    for (int i = 0; i < 100; i++) {
+        profiler.record(section, 10000000 + i);
+    }
+    check(profiler.getPercentile(0, 990) == 10000099, "p99 im Überlauffach", profiler.getPercentile(0, 990), 10000099);
+}
+
+static void checkPercentile(const char *name, const std::vector<std::uint32_t> &values)
+{
+    Profiler profiler;
+    int section = profiler.addSection(name);
+    for (std::uint32_t value : values) {
+        profiler.record(section, value);
+    }
+    std::vector<std::uint32_t> sorted(values);
+    std::sort(sorted.begin(), sorted.end());
+    std::size_t rank = (sorted.size() * 990 + 999) / 1000;
+    std::uint32_t exact = sorted[rank - 1];
+    std::uint32_t estimate = profiler.getPercentile(0, 990);
+    const ProfileSection &s = profiler.getSection(0);
+
+    std::printf("  %-28s p99 exakt %8lu µs, Histogramm %8lu µs\n", name, (unsigned long)exact, (unsigned long)estimate);
+    check(estimate >= exact, "p99 unter dem exakten Wert", estimate, exact);
+    check(estimate <= exact + exact / 2, "p99 mehr als 50 % über dem exakten Wert", estimate, exact + exact / 2);
+    check(s.minMicros == sorted.front(), "Minimum", s.minMicros, sorted.front());
+    check(s.maxMicros == sorted.back(), "Maximum", s.maxMicros, sorted.back());
+}
+
+static void checkDistributions()
+{
+    std::mt19937 generator(20261017);
+    const std::size_t count = 10000;
+
+    std::vector<std::uint32_t> values;
+    std::uniform_int_distribution<std::uint32_t> uniform(50, 400);
+    for (std::size_t i = 0; i < count; i++) values.push_back(uniform(generator));
+    checkPercentile("gleichverteilt 50-400 µs", values);
+
+    values.clear();
+    std::uniform_real_distribution<double> exponent(0, 21);
+    for (std::size_t i = 0; i < count; i++) values.push_back(static_cast<std::uint32_t>(std::exp2(exponent(generator))));
+    checkPercentile("logarithmisch 1 µs - 2 s", values);
+
+    // Schnelle Durchläufe mit 2 % langen Ausreißern (z.B. SD-Karte schreibt einen Sektor)
+    values.clear();
+    std::normal_distribution<double> fast(120, 15);
+    std::uniform_int_distribution<std::uint32_t> slow(8000, 25000);
+    std::uniform_int_distribution<int> percent(0, 99);
+    for (std::size_t i = 0; i < count; i++) {
+        values.push_back(percent(generator) < 2 ? slow(generator) : static_cast<std::uint32_t>(std::max(1.0, fast(generator))));
+    }
+    checkPercentile("2 % Ausreißer", values);
+
+    values.assign(count, 7);
+    checkPercentile("konstant 7 µs", values);
+}
+
+static void checkHostClock()
+{
+    // Die Differenz zweier Zeitstempel bleibt über einen Überlauf des 32-Bit-Zählers richtig
+    check(Profiler::ticksToMicros(static_cast<std::uint32_t>(5u - 0xfffffff0u)) == 21, "Differenz über den Überlauf",
+          Profiler::ticksToMicros(static_cast<std::uint32_t>(5u - 0xfffffff0u)), 21);
+
+    Profiler profiler;
+    int section = profiler.addSection("warten");
+    {
+        ProfileScope scope(profiler, section);
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    std::uint32_t measured = profiler.getSection(0).maxMicros;
+    std::printf("  20 ms gewartet, gemessen %lu µs\n", (unsigned long)measured);
+    check(measured >= 20000 && measured < 1000000, "Wartezeit 20 ms", measured, 20000);
+}
+
+int main()
+{
+    std::printf("Fachgrenzen:\n");
+    checkBuckets();
+    std::printf("Perzentile:\n");
+    checkDistributions();
+    std::printf("Host-Uhr:\n");
+    checkHostClock();
+    std::printf("\n%u Abweichungen\n", failures);
+    return failures == 0 ? 0 : 1;
+}
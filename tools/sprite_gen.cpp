@@ -0,0 +1,182 @@
+// Host-Werkzeug: rastert die Sonnenblume des Standby-Bildschirms und erzeugt src/sunflower_sprites.h
+//
+// Übersetzen:  g++ -std=c++11 -O2 -Wall -o sprite_gen tools/sprite_gen.cpp
+// Verwendung:  sprite_gen [ausgabe.h]      (Standard: src/sunflower_sprites.h)
+//
+// Die Geometrie entspricht drawSunflower() in main.cpp (Bildschirm 320x240, Gesicht bei 160/90).
+// Nach Änderungen an der Zeichnung das Werkzeug erneut ausführen und die erzeugte Datei einchecken.
+
+#include "../src/rle_sprite.hpp"
+#include "../src/arc_raster.hpp"
+
+#include <cstdio>
+#include <vector>
+
+// Palettenindizes, die Farben legt erst die Firmware fest
+enum SunflowerColor : std::uint8_t {
+    COLOR_BACKGROUND = 0,
+    COLOR_PETAL = 1,
+    COLOR_FACE = 2,
+    COLOR_GREEN = 3
+};
+
+// Ausschnitt des Bildschirms, den die Sonnenblume belegt (Blütenblätter bis Stiel)
+static const int SPRITE_X = 80;
+static const int SPRITE_Y = 10;
+static const int SPRITE_W = 161;
+static const int SPRITE_H = 230;
+
+struct Canvas {
+    std::vector<std::uint8_t> pixels = std::vector<std::uint8_t>(SPRITE_W * SPRITE_H, COLOR_BACKGROUND);
+
+    // Koordinaten in Bildschirmpixeln, außerhalb des Ausschnitts wird abgeschnitten
+    void pixel(int x, int y, std::uint8_t color)
+    {
+        x -= SPRITE_X;
+        y -= SPRITE_Y;
+        if (x >= 0 && x < SPRITE_W && y >= 0 && y < SPRITE_H) {
+            pixels[y * SPRITE_W + x] = color;
+        }
+    }
+
+    void fillRect(int x, int y, int w, int h, std::uint8_t color)
+    {
+        for (int j = y; j < y + h; j++) {
+            for (int i = x; i < x + w; i++) {
+                pixel(i, j, color);
+            }
+        }
+    }
+
+    // Wie TFT_eSPI: Mittelpunktverfahren, entspricht etwa einem Radius von r + 0,5
+    void fillCircle(int x0, int y0, int r, std::uint8_t color)
+    {
+        for (int dy = -r; dy <= r; dy++) {
+            for (int dx = -r; dx <= r; dx++) {
+                if (dx * dx + dy * dy <= r * r + r) {
+                    pixel(x0 + dx, y0 + dy, color);
+                }
+            }
+        }
+    }
+
+    void fillEllipse(int x0, int y0, int rx, int ry, std::uint8_t color)
+    {
+        long rx2 = static_cast<long>(rx) * rx;
+        long ry2 = static_cast<long>(ry) * ry;
+        for (int dy = -ry; dy <= ry; dy++) {
+            for (int dx = -rx; dx <= rx; dx++) {
+                if (dx * dx * ry2 + dy * dy * rx2 <= rx2 * ry2) {
+                    pixel(x0 + dx, y0 + dy, color);
+                }
+            }
+        }
+    }
+
+    // Wie drawArc() in main.cpp
+    void drawArc(int x, int y, int r, int startAngle, int endAngle, std::uint8_t color, int thickness)
+    {
+        rasterizeArc(x, y, r, thickness, startAngle, endAngle, [&](int spanX, int spanY, int width) {
+            fillRect(spanX, spanY, width, 1, color);
+        });
+    }
+};
+
+enum Mood { HAPPY, NEUTRAL, SAD };
+
+static void drawSunflower(Canvas &canvas, Mood mood)
+{
+    int centerX = 160;
+    int centerY = 90;
+    int faceRadius = 50;
+
+    for (int angle = 0; angle < 360; angle += 30) {
+        int xOffset = arcCos(angle) * 60 / (1 << ARC_TRIG_SHIFT);
+        int yOffset = arcSin(angle) * 60 / (1 << ARC_TRIG_SHIFT);
+        canvas.fillCircle(centerX + xOffset, centerY + yOffset, 20, COLOR_PETAL);
+    }
+
+    canvas.fillCircle(centerX, centerY, faceRadius, COLOR_FACE);
+    canvas.fillCircle(centerX - 25, centerY - 12, 6, COLOR_BACKGROUND);
+    canvas.fillCircle(centerX + 25, centerY - 12, 6, COLOR_BACKGROUND);
+
+    int mouthY = centerY + 20;
+    int mouthRadius = 25;
+    if (mood == HAPPY) {
+        canvas.drawArc(centerX, mouthY, mouthRadius, 180, 360, COLOR_BACKGROUND, 4);
+    } else if (mood == SAD) {
+        canvas.drawArc(centerX, mouthY + 10, mouthRadius, 0, 180, COLOR_BACKGROUND, 4);
+    } else {
+        canvas.fillRect(centerX - 25, mouthY - 2, 50, 4, COLOR_BACKGROUND);
+    }
+
+    int stemWidth = 12;
+    int stemX = centerX - stemWidth / 2;
+    int stemY = centerY + faceRadius;
+    int stemHeight = 100;
+    canvas.fillRect(stemX, stemY, stemWidth, stemHeight, COLOR_GREEN);
+
+    int leafCenterY = stemY + stemHeight / 2 + 10;
+    int leafOffsetX = 40;
+    int leafRadiusX = 30;
+    int leafRadiusY = 15;
+    canvas.fillEllipse(centerX - leafOffsetX, leafCenterY, leafRadiusX, leafRadiusY, COLOR_GREEN);
+    canvas.fillEllipse(centerX + leafOffsetX, leafCenterY, leafRadiusX, leafRadiusY, COLOR_GREEN);
+}
+
+// Kodiert eine Stimmung, prüft die Rückumwandlung und schreibt das Array
+static bool writeSprite(std::FILE *out, const char *name, Mood mood, std::size_t &bytes)
+{
+    Canvas canvas;
+    drawSunflower(canvas, mood);
+
+    std::size_t count = encodeRleSprite(canvas.pixels.data(), canvas.pixels.size(), nullptr, 0);
+    std::vector<std::uint16_t> runs(count);
+    encodeRleSprite(canvas.pixels.data(), canvas.pixels.size(), runs.data(), runs.size());
+
+    RleSprite sprite = {SPRITE_X, SPRITE_Y, SPRITE_W, SPRITE_H, runs.data(), runs.size()};
+    std::vector<std::uint8_t> decoded(canvas.pixels.size());
+    if (decodeRleSprite(sprite, decoded.data(), decoded.size()) != decoded.size() || decoded != canvas.pixels) {
+        std::fprintf(stderr, "%s: Rückumwandlung fehlerhaft\n", name);
+        return false;
+    }
+
+    std::fprintf(out, "static const std::uint16_t %s_RUNS[%u] = {", name, static_cast<unsigned>(count));
+    for (std::size_t i = 0; i < count; i++) {
+        const char *separator = i == 0 ? "\n    " : (i % 12 == 0 ? ",\n    " : ", ");
+        std::fprintf(out, "%s0x%04x", separator, runs[i]);
+    }
+    std::fprintf(out, "\n};\nstatic const RleSprite %s = {%d, %d, %d, %d, %s_RUNS, %u};\n\n",
+                 name, SPRITE_X, SPRITE_Y, SPRITE_W, SPRITE_H, name, static_cast<unsigned>(count));
+    bytes += count * sizeof(std::uint16_t);
+    std::printf("%-16s %5u Läufe, %6u Byte (unkomprimiert %u Byte)\n", name, static_cast<unsigned>(count),
+                static_cast<unsigned>(count * sizeof(std::uint16_t)), static_cast<unsigned>(canvas.pixels.size() * 2));
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    const char *path = argc >= 2 ? argv[1] : "src/sunflower_sprites.h";
+    std::FILE *out = std::fopen(path, "w");
+    if (out == nullptr) {
+        std::fprintf(stderr, "%s: Datei kann nicht geschrieben werden\n", path);
+        return 2;
+    }
+
+    std::fprintf(out, "// Sonnenblumen-Sprites des Standby-Bildschirms, erzeugt von tools/sprite_gen.cpp (nicht von Hand bearbeiten)\n"
+                      "/**\n * @file sunflower_sprites.h\n*/\n\n"
+                      "#ifndef SUNFLOWER_SPRITES_H__\n#define SUNFLOWER_SPRITES_H__\n\n"
+                      "#include \"rle_sprite.hpp\"\n\n"
+                      "// Palettenindizes: 0 Hintergrund (auch Augen und Mund), 1 Blütenblätter, 2 Gesicht, 3 Stiel und Blätter\n\n");
+    std::size_t bytes = 0;
+    bool ok = writeSprite(out, "SUNFLOWER_HAPPY", HAPPY, bytes)
+        && writeSprite(out, "SUNFLOWER_NEUTRAL", NEUTRAL, bytes)
+        && writeSprite(out, "SUNFLOWER_SAD", SAD, bytes);
+    std::fprintf(out, "#endif //SUNFLOWER_SPRITES_H__\n");
+    std::fclose(out);
+    if (!ok) {
+        return 1;
+    }
+    std::printf("Gesamt %u Byte Flash\n", static_cast<unsigned>(bytes));
+    return 0;
+}
@@ -0,0 +1,166 @@
+// Host-Benchmark der Telemetrie-Serialisierung: az_json_writer in statischen Puffer gegen ArduinoJson + String
+//
+// Übersetzen (azure-sdk-for-c ist C, daher zuerst die benötigten Quellen einzeln übersetzen):
+//   AZ=lib/azure-sdk-for-c/sdk
+//   for f in az_json_writer az_json_reader az_json_token az_span az_precondition; do
+//     gcc -O2 -c -I$AZ/inc $AZ/src/azure/core/$f.c -o /tmp/$f.o; done
+//   git clone --depth 1 -b v7.3.0 https://github.com/bblanchon/ArduinoJson /tmp/ArduinoJson
+//   g++ -std=c++11 -O2 -Wall -I$AZ/inc -DTELEMETRY_BENCH_ARDUINOJSON -I/tmp/ArduinoJson/src
+//       -o telemetry_bench tools/telemetry_bench.cpp /tmp/az_*.o
+// Die Firmware braucht ArduinoJson nicht mehr; der Vergleich wird nur mit -DTELEMETRY_BENCH_ARDUINOJSON übersetzt.
+//
+// Verwendung:  telemetry_bench [durchlaeufe] [--ohne-vergleich]     (Standard 20000 Durchläufe)
+// Exit-Code 0 = gemessen, 1 = Vergleich verlangt, aber nicht übersetzt, 2 = Aufruffehler
+
+#include "../src/telemetry_json.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+#ifdef TELEMETRY_BENCH_ARDUINOJSON
+#include <ArduinoJson.h>
+#endif
+
+// Zählt alle Heap-Anforderungen (operator new für std::string, Allocator für ArduinoJson)
+struct AllocationCounter {
+    std::size_t allocations = 0;
+    std::size_t bytes = 0;
+};
+static AllocationCounter heapCounter;
+
+void *operator new(std::size_t size)
+{
+    heapCounter.allocations++;
+    heapCounter.bytes += size;
+    void *p = std::malloc(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+static const std::size_t MAX_MESSAGE = 3072; // Wie telemetryJsonSize in main.cpp
+static char staticBuffer[MAX_MESSAGE];
+
+// Messwerte wie im Betrieb: alle 4 Sekunden, DHT11 mit 0,1er Auflösung
+static void fillSamples(TelemetrySample *samples, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i++) {
+        samples[i].epoch = 1792238400u + static_cast<std::uint32_t>(i) * 4;
+        samples[i].moisture = 350 + static_cast<int>(i % 7);
+        samples[i].temperature = 21.0f + static_cast<float>(i % 10) / 10.0f;
+        samples[i].humidity = 48.0f + static_cast<float>(i % 5) / 10.0f;
+    }
+}
+
+#ifdef TELEMETRY_BENCH_ARDUINOJSON
+struct CountingAllocator : ArduinoJson::Allocator {
+    void *allocate(std::size_t size) override
+    {
+        heapCounter.allocations++;
+        heapCounter.bytes += size;
+        return std::malloc(size);
+    }
+    void deallocate(void *p) override { std::free(p); }
+    void *reallocate(void *p, std::size_t size) override
+    {
+        heapCounter.allocations++;
+        heapCounter.bytes += size;
+        return std::realloc(p, size);
+    }
+};
+static CountingAllocator jsonAllocator;
+
+// Bisheriger Weg in main.cpp: JSON-Dokument auf dem Heap, serialisiert in einen String
+static std::size_t encodeArduinoJson(const TelemetryHeader &header, const TelemetrySample *samples, std::size_t count, std::string &out)
+{
+    JsonDocument doc(&jsonAllocator);
+    doc["deviceId"] = header.deviceId;
+    doc["latitude"] = header.latitude;
+    doc["longitude"] = header.longitude;
+    if (header.queued) {
+        doc["queued"] = true;
+    }
+    JsonArray entries = doc["samples"].to<JsonArray>();
+    for (std::size_t i = 0; i < count; i++) {
+        JsonObject entry = entries.add<JsonObject>();
+        if (header.queued) {
+            entry["seq"] = header.firstSequence + i;
+        }
+        entry["ts"] = samples[i].epoch;
+        entry["temperature"] = samples[i].temperature;
+        entry["humidity"] = samples[i].humidity;
+        entry["moisture"] = samples[i].moisture;
+    }
+    out.clear();
+    serializeJson(doc, out);
+    return out.size();
+}
+#endif
+
+template <typename Encode>
+static void measure(const char *name, std::size_t samples, int runs, Encode encode)
+{
+    heapCounter = AllocationCounter();
+    std::size_t length = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        length = encode();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-12s %7u  %7u  %12.1f  %12.1f  %10.2f\n", name, static_cast<unsigned>(samples), static_cast<unsigned>(length),
+                static_cast<double>(heapCounter.allocations) / runs, static_cast<double>(heapCounter.bytes) / runs,
+                static_cast<double>(elapsed) / runs / 1000.0);
+}
+
+int main(int argc, char **argv)
+{
+    int runs = 20000;
+    bool compare = true;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--ohne-vergleich") == 0) {
+            compare = false;
+        } else if ((runs = std::atoi(argv[i])) <= 0) {
+            std::fprintf(stderr, "Verwendung: telemetry_bench [durchlaeufe] [--ohne-vergleich]\n");
+            return 2;
+        }
+    }
+#ifndef TELEMETRY_BENCH_ARDUINOJSON
+    if (compare) {
+        std::fprintf(stderr, "Vergleich nicht übersetzt: mit -DTELEMETRY_BENCH_ARDUINOJSON -I<ArduinoJson>/src übersetzen "
+                             "oder mit --ohne-vergleich nur az_json_writer messen\n");
+        return 1;
+    }
+#endif
+
+    static TelemetrySample samples[TelemetryBatch::MAX_SAMPLES];
+    fillSamples(samples, TelemetryBatch::MAX_SAMPLES);
+    TelemetryHeader header;
+    header.latitude = 47.06895;
+    header.longitude = 15.40643;
+
+    std::printf("Verfahren    Messw.   Bytes  Alloc/Nachr.  Bytes/Nachr.  Zeit [us]\n");
+    const std::size_t counts[] = {1, 15, 30};
+    for (std::size_t count : counts) {
+        header.queued = count == 30; // 30 = nachgesendete Nachricht mit Sequenznummern
+        header.firstSequence = 1000;
+        measure("az_json", count, runs, [&]() { return encodeTelemetryJson(header, samples, count, staticBuffer, sizeof(staticBuffer)); });
+#ifdef TELEMETRY_BENCH_ARDUINOJSON
+        if (!compare) continue;
+        std::string out;
+        measure("ArduinoJson", count, runs, [&]() {
+            std::string fresh; // Wie der String in main.cpp bei jeder Nachricht neu
+            std::size_t length = encodeArduinoJson(header, samples, count, fresh);
+            out.swap(fresh);
+            return length;
+        });
+#endif
+    }
+    encodeTelemetryJson(header, samples, 2, staticBuffer, sizeof(staticBuffer));
+    std::printf("Beispiel: %s\n", staticBuffer);
+    return 0;
+}
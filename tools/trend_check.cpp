@@ -0,0 +1,242 @@
+// Host-Prüfung des Messwertverlaufs (src/trend_history.hpp): Zeiträume, Lücken, Ringpuffer und LTTB-Auswahl
+//
+// Übersetzen:  g++ -std=c++11 -O2 -Wall -o trend_check tools/trend_check.cpp
+// Verwendung:  trend_check
+//
+// Eine Stufe mit 8 Plätzen wird mit zufälligen Zeitschritten gefüttert (fester Startwert, reproduzierbar): meist im
+// selben oder nächsten Zeitraum, dazu Lücken bis über die Ringgröße hinaus und Schritte rückwärts. Ein einfaches
+// Modell führt jeden Zeitraum als Liste; snapshot() muss dessen letzte Zeiträume in derselben Reihenfolge liefern,
+// den offenen zuletzt. Für TrendHistory werden die drei Stufen, übersprungene Kanäle (NaN) und der Revisionszähler
+// geprüft. lttbDownsample() muss für alle Längen bis 200 und jede Zielanzahl aufsteigende Indizes liefern, den
+// ersten und letzten Punkt behalten, jeden Zwischenpunkt aus seinem Abschnitt nehmen und einzelne Spitzen erhalten.
+// Exit-Code 0 = alle Prüfungen bestanden, 1 = Abweichung
+
+#include "../src/trend_history.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+static unsigned failures = 0;
+
+static void check(bool ok, const char *what, long value, long expected)
+{
+    if (!ok) {
+        if (failures < 20) {
+            std::printf("  FEHLER %s: %ld (erwartet %ld)\n", what, value, expected);
+        }
+        failures++;
+    }
+}
+
+static bool samePoint(const TrendPoint &a, const TrendPoint &b)
+{
+    return (a.isEmpty() && b.isEmpty()) || (a.min == b.min && a.max == b.max && a.avg == b.avg);
+}
+
+// Modell einer Stufe: jeder Zeitraum als Liste der Messwerte, ohne Ringpuffer
+struct LevelModel {
+    std::uint32_t period;
+    std::uint32_t slot = 0;
+    bool started = false;
+    std::vector<std::vector<std::int16_t>> closed;
+    std::vector<std::int16_t> open;
+
+    static TrendPoint summarize(const std::vector<std::int16_t> &values)
+    {
+        TrendPoint point;
+        long sum = 0;
+        for (std::int16_t v : values) {
+            if (v < point.min) point.min = v;
+            if (v > point.max) point.max = v;
+            sum += v;
+        }
+        if (!values.empty()) point.avg = static_cast<std::int16_t>(sum / static_cast<long>(values.size()));
+        return point;
+    }
+
+    bool advance(std::uint32_t epoch)
+    {
+        std::uint32_t target = epoch / period;
+        if (!started) {
+            slot = target;
+            started = true;
+            return false;
+        }
+        if (target <= slot) return false;
+        closed.push_back(open);
+        open.clear();
+        for (std::uint32_t i = slot + 1; i < target; i++) {
+            closed.push_back(std::vector<std::int16_t>());
+        }
+        slot = target;
+        return true;
+    }
+};
+
+static void checkLevel()
+{
+    const std::size_t N = 8;
+    const std::uint32_t period = 60;
+    std::mt19937 generator(20261017);
+    std::uniform_int_distribution<int> kind(0, 99);
+    std::uniform_int_distribution<int> value(-500, 3000);
+
+    TrendLevel<N> level(period);
+    LevelModel model;
+    model.period = period;
+    std::uint32_t epoch = 1760000000;
+    unsigned gaps = 0;
+    unsigned backwards = 0;
+    unsigned wraps = 0;
+    for (int step = 0; step < 20000; step++) {
+        int k = kind(generator);
+        if (k < 60) {
+            epoch += 7; // Im selben oder nächsten Zeitraum
+        } else if (k < 85) {
+            epoch += period;
+        } else if (k < 93) {
+            epoch += period * (2 + kind(generator) % 4); // Lücke innerhalb des Rings
+            gaps++;
+        } else if (k < 96) {
+            epoch += period * (N + kind(generator) % 20); // Lücke länger als der Ring
+            gaps++;
+        } else {
+            epoch -= period * (1 + kind(generator) % 3); // Uhr läuft rückwärts
+            backwards++;
+        }
+        bool closedLevel = level.advance(epoch);
+        bool closedModel = model.advance(epoch);
+        check(closedLevel == closedModel, "advance() meldet Abschluss", closedLevel, closedModel);
+        if (model.closed.size() > N) wraps++;
+
+        std::int16_t v = static_cast<std::int16_t>(value(generator));
+        level.add(1, v);
+        model.open.push_back(v);
+
+        // Verschiedene Längen: 0, nur der offene, weniger als der Ring, mehr als der Ring
+        std::size_t lengths[] = {0, 1, 3, N, N + 3};
+        for (std::size_t maxPoints : lengths) {
+            TrendPoint out[N + 3];
+            std::size_t n = level.snapshot(1, out, maxPoints);
+            std::size_t closed = model.closed.size() < N ? model.closed.size() : N;
+            if (maxPoints > 0 && closed > maxPoints - 1) closed = maxPoints - 1;
+            std::size_t expected = maxPoints == 0 ? 0 : closed + 1;
+            check(n == expected, "Anzahl der Punkte", static_cast<long>(n), static_cast<long>(expected));
+            if (n != expected) continue;
+            for (std::size_t i = 0; i + 1 < n; i++) {
+                const TrendPoint want = LevelModel::summarize(model.closed[model.closed.size() - closed + i]);
+                check(samePoint(out[i], want), "abgeschlossener Zeitraum (ältester zuerst)", out[i].avg, want.avg);
+            }
+            if (n > 0) {
+                const TrendPoint want = LevelModel::summarize(model.open);
+                check(samePoint(out[n - 1], want), "offener Zeitraum zuletzt", out[n - 1].avg, want.avg);
+            }
+            // Kanäle ohne Messung sind leer
+            n = level.snapshot(2, out, maxPoints);
+            for (std::size_t i = 0; i < n; i++) {
+                check(out[i].isEmpty(), "Kanal ohne Messung", out[i].avg, 0);
+            }
+        }
+    }
+    std::printf("  20000 Schritte, %u Lücken, %u Schritte rückwärts, %u Schritte nach Ringumlauf\n", gaps, backwards, wraps);
+}
+
+static void checkHistory()
+{
+    TrendHistory history;
+    std::uint32_t start = 1760000400; // Stundenbeginn
+    std::uint32_t revision = history.getRevision();
+    // 2 Stunden alle 4 Sekunden; Temperatur fehlt in der ersten Viertelstunde
+    for (std::uint32_t t = 0; t < 7200; t += 4) {
+        float temperature = t < 900 ? NAN : 20.0f + (t / 60) % 10 * 0.1f;
+        history.add(start + t, 300 + static_cast<int>(t / 3600), temperature, 55.5f);
+    }
+    check(history.getRevision() > revision, "Revisionszähler", history.getRevision(), revision + 1);
+
+    TrendPoint out[TrendHistory::MAX_POINTS];
+    std::size_t n = history.snapshot(TrendHistory::RANGE_HOUR, 0, out);
+    check(n == 60, "Minutenwerte", static_cast<long>(n), 60);
+    n = history.snapshot(TrendHistory::RANGE_DAY, 1, out);
+    check(n == 8, "Viertelstunden (7 abgeschlossen + offen)", static_cast<long>(n), 8);
+    if (n == 8) {
+        check(out[0].isEmpty(), "Viertelstunde ohne Temperatur ist leer", out[0].avg, 0);
+        check(!out[1].isEmpty() && out[1].min == 2000 && out[1].max == 2090, "Temperatur min/max in Hundertstel", out[1].max, 2090);
+    }
+    n = history.snapshot(TrendHistory::RANGE_WEEK, 0, out);
+    check(n == 2 && out[0].avg == 300 && out[1].avg == 301, "Stundenwerte", n == 2 ? out[1].avg : static_cast<long>(n), 301);
+    n = history.snapshot(TrendHistory::RANGE_WEEK, 2, out);
+    check(n == 2 && out[0].avg == 5550, "Luftfeuchte in Hundertstel", n > 0 ? out[0].avg : 0, 5550);
+}
+
+static void checkLttb()
+{
+    std::mt19937 generator(20261017);
+    std::uniform_int_distribution<int> value(-1000, 1000);
+    const std::size_t MAX_COUNT = 200;
+    std::uint16_t xs[MAX_COUNT];
+    std::int16_t ys[MAX_COUNT];
+    std::uint16_t selected[MAX_COUNT];
+    unsigned cases = 0;
+
+    for (std::size_t count = 1; count <= MAX_COUNT; count++) {
+        for (std::size_t i = 0; i < count; i++) {
+            xs[i] = static_cast<std::uint16_t>(i * 2 + i % 3); // aufsteigend, ungleichmäßig (Lücken fehlen in xs)
+            ys[i] = static_cast<std::int16_t>(value(generator));
+        }
+        for (std::size_t threshold = 0; threshold <= count + 1; threshold++) {
+            cases++;
+            std::size_t n = lttbDownsample(xs, ys, count, threshold, selected);
+            std::size_t expected = threshold >= count ? count : threshold;
+            check(n == expected, "Anzahl gewählter Punkte", static_cast<long>(n), static_cast<long>(expected));
+            if (n != expected || n == 0) continue;
+            check(selected[0] == 0, "erster Punkt bleibt", selected[0], 0);
+            if (n >= 2) {
+                check(selected[n - 1] == count - 1, "letzter Punkt bleibt", selected[n - 1], static_cast<long>(count - 1));
+            }
+            for (std::size_t i = 1; i < n; i++) {
+                check(selected[i] > selected[i - 1], "Indizes aufsteigend", selected[i], selected[i - 1] + 1);
+            }
+            if (threshold < 3 || threshold >= count) continue;
+            // Zwischenpunkt i stammt aus seinem Abschnitt (gleiche Einteilung wie in lttbDownsample)
+            float every = static_cast<float>(count - 2) / static_cast<float>(threshold - 2);
+            for (std::size_t i = 0; i + 2 < n; i++) {
+                std::size_t rangeStart = static_cast<std::size_t>(i * every) + 1;
+                std::size_t rangeEnd = static_cast<std::size_t>((i + 1) * every) + 1;
+                if (rangeEnd > count - 1) rangeEnd = count - 1;
+                std::uint16_t index = selected[i + 1];
+                check(index >= rangeStart && index < rangeEnd, "Zwischenpunkt außerhalb seines Abschnitts", index, static_cast<long>(rangeStart));
+            }
+        }
+    }
+
+    // Eine einzelne Spitze auf einer flachen Linie wird immer gewählt
+    unsigned spikes = 0;
+    for (std::size_t count = 20; count <= 168; count += 37) {
+        for (std::size_t spike = 1; spike + 1 < count; spike++) {
+            for (std::size_t i = 0; i < count; i++) {
+                xs[i] = static_cast<std::uint16_t>(i);
+                ys[i] = 100;
+            }
+            ys[spike] = 900;
+            std::size_t n = lttbDownsample(xs, ys, count, 10, selected);
+            bool found = false;
+            for (std::size_t i = 0; i < n; i++) found = found || selected[i] == spike;
+            check(found, "Spitze gewählt", static_cast<long>(spike), static_cast<long>(spike));
+            spikes++;
+        }
+    }
+    std::printf("  %u Kombinationen aus Länge und Zielanzahl, %u Spitzen\n", cases, spikes);
+}
+
+int main()
+{
+    std::printf("Stufe (8 Plätze, 60 s):\n");
+    checkLevel();
+    std::printf("TrendHistory:\n");
+    checkHistory();
+    std::printf("LTTB:\n");
+    checkLttb();
+    std::printf("\n%u Abweichungen\n", failures);
+    return failures == 0 ? 0 : 1;
+}
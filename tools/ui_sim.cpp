@@ -0,0 +1,206 @@
+// Host-Simulation der Meldungen (src/timed_screen.hpp) mit virtueller Uhr gegen die bisherigen Anzeigen mit delay()
+//
+// Übersetzen:  g++ -std=c++11 -O2 -Wall -o ui_sim tools/ui_sim.cpp
+// Verwendung:  ui_sim [sekunden] [tastendruck_alle_ms]     (Standard 120 s, alle 7000 ms ein Moduswechsel)
+//
+// Die Uhr ist virtuell: ein Durchlauf von loop() kostet 1 ms, delay() stellt die Uhr vor, ohne dass loop() läuft.
+// Nachgebildet werden der Start (WLAN-Meldung, bisher delay(2000) in connectToWiFi() und setup()), Moduswechsel per
+// Taste (bisher delay(1000) in displayModeInfo()) und die Aufgaben iothub (10 ms) und bewaesserung (250 ms) im
+// Scheduler. Geprüft wird, dass loop() nie länger als einen Durchlauf aussetzt, keine Periode der Aufgaben verloren
+// geht, jede Meldung ihre Anzeigedauer erreicht und pro Moduswechsel der Hauptbildschirm genau einmal gezeichnet wird.
+// Exit-Code 0 = alle Prüfungen der neuen Anzeige bestanden, 1 = nicht bestanden, 2 = Aufruffehler
+
+#include "../src/scheduler.hpp"
+#include "../src/timed_screen.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// Wie in main.cpp
+static const std::uint32_t WIFI_STATUS_TIME = 2000;
+static const std::uint32_t MODE_INFO_TIME = 1000;
+static const std::uint32_t TIMED_SCREEN_INTERVAL = 50;
+static const std::uint32_t IOTHUB_INTERVAL = 10;
+static const std::uint32_t WATERING_INTERVAL = 250;
+static const std::uint32_t LOOP_COST = 1; // ms pro Durchlauf von loop()
+
+enum Screen { SCREEN_NONE, SCREEN_WIFI_STATUS, SCREEN_MODE_INFO, SCREEN_MAIN };
+
+// Virtuelle Uhr und Anzeige; die Aufgaben des Schedulers sind freie Funktionen und greifen darauf zu
+static std::uint32_t now = 0;
+static std::uint32_t delayedMillis = 0;
+static Screen visible = SCREEN_NONE;
+static std::uint32_t visibleSince = 0;
+static std::vector<std::uint32_t> messageDurations; // Wie lange jede Meldung sichtbar war
+static unsigned mainScreenDraws = 0;
+static TimedScreen timedScreen;
+
+static std::uint32_t clock() { return now; }
+
+static void delay(std::uint32_t ms)
+{
+    now += ms;
+    delayedMillis += ms;
+}
+
+static void draw(Screen screen)
+{
+    if (visible == SCREEN_WIFI_STATUS || visible == SCREEN_MODE_INFO) {
+        messageDurations.push_back(now - visibleSince);
+    }
+    visible = screen;
+    visibleSince = now;
+    if (screen == SCREEN_MAIN) mainScreenDraws++;
+}
+
+static void iotHubTask() {}
+static void wateringTask() {}
+
+static void timedScreenTask()
+{
+    if (timedScreen.poll(now) != TimedScreen::NONE) {
+        draw(SCREEN_MAIN);
+    }
+}
+
+// Bisher: setup() und displayModeInfo() halten die Anzeige mit delay()
+static void legacySetup()
+{
+    draw(SCREEN_WIFI_STATUS);
+    delay(2000); // connectToWiFi()
+    delay(2000); // setup() nach connectIoTHub()
+    draw(SCREEN_MAIN);
+}
+
+static void legacyModeChange()
+{
+    draw(SCREEN_MODE_INFO);
+    delay(1000);
+    draw(SCREEN_MAIN);
+}
+
+// Neu: die Meldung ist ein Zustand, den die Aufgabe "meldung" beendet
+static void newSetup()
+{
+    draw(SCREEN_WIFI_STATUS);
+    timedScreen.show(SCREEN_WIFI_STATUS, now, WIFI_STATUS_TIME);
+}
+
+static void newModeChange()
+{
+    draw(SCREEN_MODE_INFO);
+    timedScreen.show(SCREEN_MODE_INFO, now, MODE_INFO_TIME);
+}
+
+struct Result {
+    std::uint32_t maxLoopGap = 0;   // Größter Abstand zweier Durchläufe von loop() in ms
+    std::uint32_t firstLoop = 0;    // Zeitpunkt des ersten Durchlaufs
+    std::uint32_t blocked = 0;      // ms in delay()
+    unsigned presses = 0;
+    unsigned mainDraws = 0;
+    TaskStats iotHub;
+    TaskStats watering;
+    std::uint32_t minMessage = 0;
+    std::uint32_t maxMessage = 0;
+};
+
+static Result run(bool legacy, std::uint32_t duration, std::uint32_t pressInterval)
+{
+    now = 0;
+    delayedMillis = 0;
+    visible = SCREEN_NONE;
+    visibleSince = 0;
+    messageDurations.clear();
+    mainScreenDraws = 0;
+    timedScreen = TimedScreen();
+
+    Scheduler scheduler;
+    scheduler.setClock(clock);
+    if (legacy) {
+        legacySetup();
+    } else {
+        newSetup();
+    }
+    scheduler.addTask("iothub", iotHubTask, IOTHUB_INTERVAL, IOTHUB_INTERVAL * 5, 3, now);
+    scheduler.addTask("bewaesserung", wateringTask, WATERING_INTERVAL, 0, 2, now);
+    if (!legacy) scheduler.addTask("meldung", timedScreenTask, TIMED_SCREEN_INTERVAL, 0, 1, now);
+
+    Result result;
+    result.firstLoop = now;
+    std::uint32_t lastLoop = now;
+    std::uint32_t nextPress = now + WIFI_STATUS_TIME + pressInterval; // Erst nach der WLAN-Meldung
+    while (now < duration) {
+        result.maxLoopGap = now - lastLoop > result.maxLoopGap ? now - lastLoop : result.maxLoopGap;
+        lastLoop = now;
+        // loop(): Tastenereignis abarbeiten, dann fällige Aufgaben; der letzte Moduswechsel muss vor dem Ende ablaufen können
+        if (now >= nextPress && now + MODE_INFO_TIME + TIMED_SCREEN_INTERVAL < duration) {
+            result.presses++;
+            nextPress += pressInterval;
+            if (legacy) {
+                legacyModeChange();
+            } else {
+                newModeChange();
+            }
+        }
+        scheduler.run(now);
+        now += LOOP_COST;
+    }
+    if (visible != SCREEN_MAIN) {
+        draw(SCREEN_NONE); // Offene Meldung abschließen
+    }
+    result.blocked = delayedMillis;
+    result.mainDraws = mainScreenDraws;
+    result.iotHub = scheduler.getStats(0);
+    result.watering = scheduler.getStats(1);
+    for (std::size_t i = 0; i < messageDurations.size(); i++) {
+        if (i == 0 || messageDurations[i] < result.minMessage) result.minMessage = messageDurations[i];
+        if (messageDurations[i] > result.maxMessage) result.maxMessage = messageDurations[i];
+    }
+    return result;
+}
+
+static void print(const char *name, const Result &r)
+{
+    std::printf("%-10s %8u %10u %9u %12u/%u %12u/%u %10u %9u-%u\n", name, static_cast<unsigned>(r.firstLoop),
+                static_cast<unsigned>(r.maxLoopGap), static_cast<unsigned>(r.blocked), static_cast<unsigned>(r.iotHub.skipped),
+                static_cast<unsigned>(r.iotHub.maxJitter), static_cast<unsigned>(r.watering.skipped),
+                static_cast<unsigned>(r.watering.maxJitter), r.mainDraws, static_cast<unsigned>(r.minMessage),
+                static_cast<unsigned>(r.maxMessage));
+}
+
+static bool check(bool condition, const char *what)
+{
+    std::printf("  %-66s %s\n", what, condition ? "ok" : "FEHLER");
+    return condition;
+}
+
+int main(int argc, char **argv)
+{
+    long seconds = argc >= 2 ? std::atol(argv[1]) : 120;
+    long pressInterval = argc >= 3 ? std::atol(argv[2]) : 7000;
+    // Kürzere Abstände ersetzen jede Meldung vor ihrem Ablauf, dann gibt es keine Anzeigedauer zu prüfen
+    if (seconds < 10 || pressInterval <= static_cast<long>(MODE_INFO_TIME + TIMED_SCREEN_INTERVAL)) {
+        std::fprintf(stderr, "Mindestens 10 Sekunden und mehr als 1050 ms zwischen zwei Tastendrücken\n");
+        return 2;
+    }
+    std::uint32_t duration = static_cast<std::uint32_t>(seconds) * 1000;
+    Result legacy = run(true, duration, static_cast<std::uint32_t>(pressInterval));
+    Result timed = run(false, duration, static_cast<std::uint32_t>(pressInterval));
+
+    std::printf("%ld s virtuelle Zeit, Moduswechsel alle %ld ms, loop() kostet %u ms\n\n", seconds, pressInterval,
+                static_cast<unsigned>(LOOP_COST));
+    std::printf("Anzeige    1. loop  max Lücke  delay ms  iothub ausg./Jitter  bewaess. ausg./Jitter  Hauptbild  Meldung ms\n");
+    print("bisher", legacy);
+    print("Zustand", timed);
+    std::printf("\n");
+
+    bool ok = check(timed.blocked == 0, "Kein delay() in der Anzeige");
+    ok &= check(timed.firstLoop == 0, "loop() läuft direkt nach setup(), die WLAN-Meldung steht weiter");
+    ok &= check(timed.maxLoopGap <= LOOP_COST, "loop() setzt nie länger als einen Durchlauf aus");
+    ok &= check(timed.iotHub.skipped == 0 && timed.watering.skipped == 0, "Keine Periode von iothub und bewaesserung ausgelassen");
+    ok &= check(timed.minMessage >= MODE_INFO_TIME && timed.maxMessage <= WIFI_STATUS_TIME + TIMED_SCREEN_INTERVAL,
+                "Jede Meldung mindestens ihre Anzeigedauer, höchstens 50 ms länger");
+    ok &= check(timed.mainDraws == timed.presses + 1, "Hauptbildschirm genau einmal nach dem Start und pro Moduswechsel");
+    return ok ? 0 : 1;
+}
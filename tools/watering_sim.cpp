@@ -0,0 +1,241 @@
+// Host-Simulation der Bewässerung (src/watering_controller.hpp) gegen die bisherige Schwellenschaltung
+//
+// Übersetzen:  g++ -std=c++11 -O2 -Wall -o watering_sim tools/watering_sim.cpp
+// Verwendung:  watering_sim [aufzeichnung.csv|-] [modus]     (Modus 1-3, Standard 2; "-" = Simulation)
+//
+// Mit einer CSV von "aqualog export" bzw. "aqualog range" wird der aufgezeichnete Feuchteverlauf abgespielt
+// (offener Kreis: die Pumpe verändert den Verlauf nicht, verglichen werden Schaltvorgänge und Pumpzeit).
+// Ohne Datei läuft ein geschlossener Kreis über 3 Tage: der Boden trocknet gleichmäßig, gepumptes Wasser
+// erreicht den Sensor verzögert, die Messung rauscht (fester Startwert, reproduzierbar).
+//
+// Bisherige Logik: Relais ein, solange der letzte Messwert <= untere Schwelle des Modus, bewertet alle 4 Sekunden.
+// Exit-Code 0 = neue Logik hält das Tagesbudget ein, 1 = Budget überschritten, 2 = Aufruf- oder Dateifehler
+
+#include "../src/watering_controller.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static const std::uint32_t STEP = 250;           // ms, wie wateringInterval in main.cpp
+static const std::uint32_t SAMPLE_PERIOD = 4000; // ms, wie sensorInterval in main.cpp
+static const double PUMP_FLOW = 25.0;            // ml/s, Annahme für eine kleine 5-V-Pumpe
+
+// Wie thresholds[] in main.cpp
+static const std::uint16_t THRESHOLD_LOW[3] = {10, 201, 401};
+static const std::uint16_t THRESHOLD_HIGH[3] = {200, 400, 600};
+
+struct Sample {
+    std::uint32_t time; // ms seit Beginn
+    std::uint16_t moisture;
+};
+
+struct Result {
+    std::uint32_t switches = 0;
+    std::uint64_t onTime = 0;           // ms
+    std::uint64_t maxDayOnTime = 0;     // ms im ungünstigsten 24-Stunden-Fenster (gleitend)
+    std::uint32_t longestRun = 0;       // ms
+    double minMoisture = 1e9;
+    double maxMoisture = 0;
+};
+
+// Bisherige Schaltlogik
+struct LegacyRelay {
+    std::uint16_t low;
+    bool on = false;
+    explicit LegacyRelay(std::uint16_t low) : low(low) {}
+    bool update(std::uint16_t moisture)
+    {
+        on = moisture <= low;
+        return on;
+    }
+};
+
+// Zählt Schaltvorgänge, Pumpzeit und die längste ununterbrochene Laufzeit
+struct RelayMeter {
+    Result result;
+    bool on = false;
+    std::uint32_t runStart = 0;
+    std::uint64_t dayOnTime = 0;
+    std::vector<std::uint8_t> day = std::vector<std::uint8_t>(WateringController::BUDGET_PERIOD / STEP); // Relais je Schritt der letzten 24 Stunden
+
+    void step(bool relay, std::uint32_t now)
+    {
+        std::uint8_t &slot = day[(now / STEP) % day.size()];
+        if (slot) dayOnTime -= STEP; // Schritt von vor 24 Stunden fällt aus dem Fenster
+        slot = relay ? 1 : 0;
+        if (relay != on) {
+            result.switches++;
+            on = relay;
+            runStart = now;
+        }
+        if (on) {
+            result.onTime += STEP;
+            dayOnTime += STEP;
+            if (dayOnTime > result.maxDayOnTime) result.maxDayOnTime = dayOnTime;
+            if (now + STEP - runStart > result.longestRun) result.longestRun = now + STEP - runStart;
+        }
+    }
+
+    void moisture(double value)
+    {
+        if (value < result.minMoisture) result.minMoisture = value;
+        if (value > result.maxMoisture) result.maxMoisture = value;
+    }
+};
+
+static bool loadTrace(const char *path, std::vector<Sample> &trace)
+{
+    std::FILE *in = std::fopen(path, "r");
+    if (in == nullptr) {
+        std::fprintf(stderr, "%s: Datei kann nicht geöffnet werden\n", path);
+        return false;
+    }
+    char line[256];
+    unsigned long firstEpoch = 0;
+    while (std::fgets(line, sizeof(line), in) != nullptr) {
+        // Epoch,Datum,Zeit,Feuchtigkeit_Pflanze,Temperatur,Luftfeuchtigkeit
+        char *end = nullptr;
+        unsigned long epoch = std::strtoul(line, &end, 10);
+        if (end == line || *end != ',') continue;
+        const char *field = end;
+        for (int column = 0; column < 3 && field != nullptr; column++) {
+            field = std::strchr(field, ',');
+            if (field != nullptr && column < 2) field++;
+        }
+        if (field == nullptr) continue;
+        long moisture = std::strtol(field + 1, nullptr, 10);
+        if (trace.empty()) firstEpoch = epoch;
+        if (epoch < firstEpoch) continue;
+        trace.push_back({static_cast<std::uint32_t>((epoch - firstEpoch) * 1000), static_cast<std::uint16_t>(moisture < 0 ? 0 : moisture)});
+    }
+    std::fclose(in);
+    return true;
+}
+
+static WateringConfig configFor(int mode)
+{
+    WateringConfig config;
+    config.startAtOrBelow = THRESHOLD_LOW[mode - 1];
+    config.stopAbove = (THRESHOLD_LOW[mode - 1] + THRESHOLD_HIGH[mode - 1]) / 2;
+    return config;
+}
+
+// Offener Kreis: beide Logiken sehen denselben aufgezeichneten Verlauf
+static void replay(const std::vector<Sample> &trace, int mode, Result &legacy, Result &controlled)
+{
+    LegacyRelay old(THRESHOLD_LOW[mode - 1]);
+    WateringController controller(configFor(mode));
+    RelayMeter oldMeter, newMeter;
+    std::size_t next = 0;
+    std::uint16_t moisture = trace[0].moisture;
+    std::uint32_t lastSample = 0;
+    bool oldRelay = false;
+    for (std::uint32_t now = 0; now <= trace.back().time; now += STEP) {
+        bool fresh = false;
+        while (next < trace.size() && trace[next].time <= now) {
+            moisture = trace[next++].moisture;
+            lastSample = now;
+            fresh = true;
+        }
+        if (fresh) {
+            oldRelay = old.update(moisture);
+            oldMeter.moisture(moisture);
+            newMeter.moisture(moisture);
+        }
+        // Lücken in der Aufzeichnung wie veraltete Messwerte behandeln (SensorSnapshot: zwei Perioden)
+        bool valid = now - lastSample <= 2 * SAMPLE_PERIOD;
+        oldMeter.step(oldRelay && valid, now);
+        newMeter.step(controller.update(moisture, valid, now), now);
+    }
+    legacy = oldMeter.result;
+    controlled = newMeter.result;
+}
+
+// Geschlossener Kreis: Boden trocknet, Wasser erreicht den Sensor mit Verzögerung
+struct Soil {
+    double moisture = 240;
+    double inTransit = 0; // Gepumptes Wasser, das den Sensor noch nicht erreicht hat (in Sensorschritten)
+
+    void step(bool pump)
+    {
+        double seconds = STEP / 1000.0;
+        moisture -= 0.001 * seconds;        // 3,6 Schritte pro Stunde
+        if (pump) inTransit += 2.5 * seconds; // 2,5 Schritte pro Sekunde Pumpzeit
+        double arriving = inTransit * seconds / 90.0; // Zeitkonstante 90 Sekunden
+        inTransit -= arriving;
+        moisture += arriving;
+        if (moisture < 0) moisture = 0;
+    }
+};
+
+static Result simulate(bool useController, int mode, std::uint32_t duration)
+{
+    std::mt19937 random(20261017);
+    std::normal_distribution<double> noise(0.0, 4.0);
+    Soil soil;
+    LegacyRelay old(THRESHOLD_LOW[mode - 1]);
+    WateringController controller(configFor(mode));
+    RelayMeter meter;
+    std::uint16_t measured = static_cast<std::uint16_t>(soil.moisture);
+    bool relay = false;
+    for (std::uint32_t now = 0; now < duration; now += STEP) {
+        if (now % SAMPLE_PERIOD == 0) {
+            double value = soil.moisture + noise(random);
+            measured = static_cast<std::uint16_t>(value < 0 ? 0 : value);
+            if (!useController) relay = old.update(measured);
+        }
+        if (useController) relay = controller.update(measured, true, now);
+        meter.step(relay, now);
+        meter.moisture(soil.moisture);
+        soil.step(relay);
+    }
+    return meter.result;
+}
+
+static void print(const char *name, const Result &r, std::uint32_t duration)
+{
+    double days = duration / 86400000.0;
+    std::printf("%-18s %8u %9.1f %9.0f %8.1f %8.1f %8.0f %6.0f\n", name, static_cast<unsigned>(r.switches), r.onTime / 1000.0,
+                r.onTime / 1000.0 * PUMP_FLOW, r.maxDayOnTime / 1000.0, r.longestRun / 1000.0,
+                days > 0 ? r.switches / days : 0.0, r.minMoisture);
+}
+
+int main(int argc, char **argv)
+{
+    int mode = argc >= 3 ? std::atoi(argv[2]) : 2;
+    if (mode < 1 || mode > 3) {
+        std::fprintf(stderr, "Modus muss 1, 2 oder 3 sein\n");
+        return 2;
+    }
+    WateringConfig config = configFor(mode);
+    Result legacy, controlled;
+    std::uint32_t duration;
+    if (argc >= 2 && std::strcmp(argv[1], "-") != 0) {
+        std::vector<Sample> trace;
+        if (!loadTrace(argv[1], trace)) return 2;
+        if (trace.size() < 2) {
+            std::fprintf(stderr, "%s: zu wenige Datensätze\n", argv[1]);
+            return 2;
+        }
+        duration = trace.back().time;
+        replay(trace, mode, legacy, controlled);
+        std::printf("Aufzeichnung %s: %u Datensätze, %.1f Stunden, offener Kreis\n", argv[1], static_cast<unsigned>(trace.size()), duration / 3600000.0);
+    } else {
+        duration = 3 * WateringController::BUDGET_PERIOD;
+        legacy = simulate(false, mode, duration);
+        controlled = simulate(true, mode, duration);
+        std::printf("Simulation: 3 Tage, Boden trocknet 3,6 Schritte/h, Messrauschen sigma 4, geschlossener Kreis\n");
+    }
+    std::printf("Modus %d: bisher ein bei <= %u; neu Gießzyklus ab <= %u bis > %u, Gabe %lu-%lu s, Einwirkzeit %lu s, Budget %lu s/Tag\n\n",
+                mode, static_cast<unsigned>(THRESHOLD_LOW[mode - 1]), static_cast<unsigned>(config.startAtOrBelow),
+                static_cast<unsigned>(config.stopAbove), static_cast<unsigned long>(config.minOnTime / 1000),
+                static_cast<unsigned long>(config.maxOnTime / 1000), static_cast<unsigned long>(config.soakTime / 1000),
+                static_cast<unsigned long>(config.dailyBudget / 1000));
+    std::printf("Logik               Schalt.  Pumpe s  Wasser ml  max s/Tag  Lauf s  Schalt/Tag  min\n");
+    print("bisher", legacy, duration);
+    print("Zustandsautomat", controlled, duration);
+    return controlled.maxDayOnTime <= config.dailyBudget ? 0 : 1;
+}